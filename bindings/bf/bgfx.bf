@@ -739,6 +739,11 @@ public static class bgfx
 		/// </summary>
 		ReadBack               = 0x0000800000000000,
 	
+		/// <summary>
+		/// Texture data is parsed and decoded on loader thread.
+		/// </summary>
+		Async                  = 0x0001000000000000,
+	
 		/// <summary>
 		/// Render target MSAAx2 mode.
 		/// </summary>
@@ -2048,6 +2053,9 @@ public static class bgfx
 			public uint32 minResourceCbSize;
 			public uint32 transientVbSize;
 			public uint32 transientIbSize;
+			public uint32 stagingBufferSize;
+			public uint32 maxDrawCalls;
+			public uint8 numFrames;
 		}
 	
 		public RendererType type;
@@ -2142,6 +2150,20 @@ public static class bgfx
 		public uint16 num;
 	}
 	
+	[CRepr]
+	public struct TransformSrt
+	{
+		public float[4] rotate;
+		public float[4] translate;
+		public float[4] scale;
+	}
+	
+	[CRepr]
+	public struct Transform4x3
+	{
+		public float[12] data;
+	}
+	
 	[CRepr]
 	public struct ViewStats
 	{
@@ -2158,6 +2180,7 @@ public static class bgfx
 	{
 		public int64 cpuTimeBegin;
 		public int64 cpuTimeEnd;
+		public uint32 uniformBytesSaved;
 	}
 	
 	[CRepr]
@@ -2191,9 +2214,19 @@ public static class bgfx
 		public int64 rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public int transientVbMax;
+		public int transientIbMax;
+		public uint16 transientVbPages;
+		public uint16 transientIbPages;
+		public int64 dynamicVbFree;
+		public int64 dynamicIbFree;
+		public uint32 dynamicVbLargestFree;
+		public uint32 dynamicIbLargestFree;
 		public uint32[5] numPrims;
 		public int64 gpuMemoryMax;
 		public int64 gpuMemoryUsed;
+		public uint32 descriptorSetHits;
+		public uint32 descriptorSetMisses;
 		public uint16 width;
 		public uint16 height;
 		public uint16 textWidth;
@@ -2218,6 +2251,12 @@ public static class bgfx
 	{
 	}
 	
+	[CRepr]
+	public struct DrawListHandle {
+	    public uint16 idx;
+	    public bool Valid => idx != uint16.MaxValue;
+	}
+	
 	[CRepr]
 	public struct DynamicIndexBufferHandle {
 	    public uint16 idx;
@@ -3183,6 +3222,23 @@ public static class bgfx
 	[LinkName("bgfx_get_direct_access_ptr")]
 	public static extern void* get_direct_access_ptr(TextureHandle _handle);
 	
+	/// <summary>
+	/// Returns true once texture is created on render thread and can be used
+	/// for draw calls, updates, read back and frame buffer attachments.
+	/// @remarks
+	///   Texture created with `BGFX_TEXTURE_ASYNC` flag is created after loader
+	///   thread parses it and decodes format renderer can't sample natively.
+	///   Such texture must not be used before this function returns true.
+	///   Draw calls and dispatches binding it too early are discarded.
+	///   Texture memory is released on loader thread, `ReleaseFn` passed to
+	///   `makeRef` is called from it.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	///
+	[LinkName("bgfx_is_texture_ready")]
+	public static extern bool is_texture_ready(TextureHandle _handle);
+	
 	/// <summary>
 	/// Destroy texture.
 	/// </summary>
@@ -3362,6 +3418,23 @@ public static class bgfx
 	[LinkName("bgfx_destroy_occlusion_query")]
 	public static extern void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create draw list. Primitives recorded into draw list once can be
+	/// submitted in any later frame without encoding them again.
+	/// </summary>
+	///
+	[LinkName("bgfx_create_draw_list")]
+	public static extern DrawListHandle create_draw_list();
+	
+	/// <summary>
+	/// Destroy draw list.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw list object.</param>
+	///
+	[LinkName("bgfx_destroy_draw_list")]
+	public static extern void destroy_draw_list(DrawListHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3652,6 +3725,30 @@ public static class bgfx
 	[LinkName("bgfx_encoder_alloc_transform")]
 	public static extern uint32 encoder_alloc_transform(Encoder* _this, Transform* _transform, uint16 _num);
 	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from
+	/// scale/rotation/translation transforms. Returns `UINT32_MAX` and
+	/// writes nothing when matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_srt">Pointer to first SRT transform in array.</param>
+	/// <param name="_num">Number of transforms in array.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_transform_srt")]
+	public static extern uint32 encoder_alloc_transform_srt(Encoder* _this, TransformSrt* _srt, uint16 _num);
+	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from 4x3
+	/// affine matrices. Returns `UINT32_MAX` and writes nothing when
+	/// matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_mtx">Pointer to first 4x3 matrix in array.</param>
+	/// <param name="_num">Number of matrices in array.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_transform_4x3")]
+	public static extern uint32 encoder_alloc_transform_4x3(Encoder* _this, Transform4x3* _mtx, uint16 _num);
+	
 	/// <summary>
 	/// Set shader uniform parameter for draw primitive.
 	/// </summary>
@@ -3881,6 +3978,65 @@ public static class bgfx
 	[LinkName("bgfx_encoder_submit_indirect")]
 	public static extern void encoder_submit_indirect(Encoder* _this, ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16 _start, uint16 _num, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Record primitive into draw list instead of submitting it for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_depth">Depth for sorting.</param>
+	/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+	///
+	[LinkName("bgfx_encoder_record")]
+	public static extern void encoder_record(Encoder* _this, DrawListHandle _handle, ProgramHandle _program, uint32 _depth, uint8 _flags);
+	
+	/// <summary>
+	/// Submit all primitives recorded into draw list for rendering.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_depth">Depth added to depth of each recorded primitive.</param>
+	///
+	[LinkName("bgfx_encoder_submit_draw_list")]
+	public static extern void encoder_submit_draw_list(Encoder* _this, ViewId _id, DrawListHandle _handle, uint32 _depth);
+	
+	/// <summary>
+	/// Allocate transient index buffer. Encoder reserves chunks of frame
+	/// transient index buffer and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tib">TransientIndexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of indices to allocate.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_transient_index_buffer")]
+	public static extern void encoder_alloc_transient_index_buffer(Encoder* _this, TransientIndexBuffer* _tib, uint32 _num, bool _index32);
+	
+	/// <summary>
+	/// Allocate transient vertex buffer. Encoder reserves chunks of frame
+	/// transient vertex buffer and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tvb">TransientVertexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of vertices to allocate.</param>
+	/// <param name="_layout">Vertex layout.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_transient_vertex_buffer")]
+	public static extern void encoder_alloc_transient_vertex_buffer(Encoder* _this, TransientVertexBuffer* _tvb, uint32 _num, VertexLayout* _layout);
+	
+	/// <summary>
+	/// Allocate instance data buffer from encoder transient vertex buffer
+	/// chunk.
+	/// </summary>
+	///
+	/// <param name="_idb">InstanceDataBuffer structure is filled and is valid for duration of frame, and it can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of instances.</param>
+	/// <param name="_stride">Instance stride. Must be multiple of 16.</param>
+	///
+	[LinkName("bgfx_encoder_alloc_instance_data_buffer")]
+	public static extern void encoder_alloc_instance_data_buffer(Encoder* _this, InstanceDataBuffer* _idb, uint32 _num, uint16 _stride);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4093,6 +4249,30 @@ public static class bgfx
 	[LinkName("bgfx_override_internal_texture")]
 	public static extern void* override_internal_texture(TextureHandle _handle, uint16 _width, uint16 _height, uint8 _numMips, TextureFormat _format, uint64 _flags);
 	
+	/// <summary>
+	/// Replay frame from capture file written when library is compiled with
+	/// `BGFX_CONFIG_FRAME_CAPTURE`, and `bgfx::frame(true)` is called.
+	/// @attention Replayed frame must be the only submission in current frame. Replaying from
+	///   offset 0 destroys resources created by previous replay.
+	/// </summary>
+	///
+	/// <param name="_data">Capture file data.</param>
+	/// <param name="_size">Capture file data size.</param>
+	/// <param name="_offset">Offset of captured frame in capture file data.</param>
+	///
+	[LinkName("bgfx_replay_frame")]
+	public static extern uint32 replay_frame(void* _data, uint32 _size, uint32 _offset);
+	
+	/// <summary>
+	/// Write spans recorded when library is compiled with `BGFX_CONFIG_TRACE_RECORDER`
+	/// as Chrome trace event JSON, viewable in `chrome://tracing` or Perfetto UI.
+	/// </summary>
+	///
+	/// <param name="_filePath">Trace file path.</param>
+	///
+	[LinkName("bgfx_save_trace")]
+	public static extern bool save_trace(char8* _filePath);
+	
 	/// <summary>
 	/// Sets a debug marker. This allows you to group graphics calls together for easy browsing in
 	/// graphics debugging tools.
@@ -4200,6 +4380,30 @@ public static class bgfx
 	[LinkName("bgfx_alloc_transform")]
 	public static extern uint32 alloc_transform(Transform* _transform, uint16 _num);
 	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from
+	/// scale/rotation/translation transforms. Returns `UINT32_MAX` and
+	/// writes nothing when matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_srt">Pointer to first SRT transform in array.</param>
+	/// <param name="_num">Number of transforms in array.</param>
+	///
+	[LinkName("bgfx_alloc_transform_srt")]
+	public static extern uint32 alloc_transform_srt(TransformSrt* _srt, uint16 _num);
+	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from 4x3
+	/// affine matrices. Returns `UINT32_MAX` and writes nothing when
+	/// matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_mtx">Pointer to first 4x3 matrix in array.</param>
+	/// <param name="_num">Number of matrices in array.</param>
+	///
+	[LinkName("bgfx_alloc_transform_4x3")]
+	public static extern uint32 alloc_transform_4x3(Transform4x3* _mtx, uint16 _num);
+	
 	/// <summary>
 	/// Set shader uniform parameter for draw primitive.
 	/// </summary>
@@ -4437,6 +4641,29 @@ public static class bgfx
 	[LinkName("bgfx_submit_indirect")]
 	public static extern void submit_indirect(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16 _start, uint16 _num, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Record primitive into draw list instead of submitting it for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_depth">Depth for sorting.</param>
+	/// <param name="_flags">Which states to discard for next draw. See `BGFX_DISCARD_*`.</param>
+	///
+	[LinkName("bgfx_record")]
+	public static extern void record(DrawListHandle _handle, ProgramHandle _program, uint32 _depth, uint8 _flags);
+	
+	/// <summary>
+	/// Submit all primitives recorded into draw list for rendering.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_depth">Depth added to depth of each recorded primitive.</param>
+	///
+	[LinkName("bgfx_submit_draw_list")]
+	public static extern void submit_draw_list(ViewId _id, DrawListHandle _handle, uint32 _depth);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -738,6 +738,11 @@ public static partial class bgfx
 		/// </summary>
 		ReadBack               = 0x0000800000000000,
 	
+		/// <summary>
+		/// Texture data is parsed and decoded on loader thread.
+		/// </summary>
+		Async                  = 0x0001000000000000,
+	
 		/// <summary>
 		/// Render target MSAAx2 mode.
 		/// </summary>
@@ -2025,6 +2030,9 @@ public static partial class bgfx
 			public uint minResourceCbSize;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public uint stagingBufferSize;
+			public uint maxDrawCalls;
+			public byte numFrames;
 		}
 	
 		public RendererType type;
@@ -2111,6 +2119,18 @@ public static partial class bgfx
 		public ushort num;
 	}
 	
+	public unsafe struct TransformSrt
+	{
+		public fixed float rotate[4];
+		public fixed float translate[4];
+		public fixed float scale[4];
+	}
+	
+	public unsafe struct Transform4x3
+	{
+		public fixed float data[12];
+	}
+	
 	public unsafe struct ViewStats
 	{
 		public fixed byte name[256];
@@ -2125,6 +2145,7 @@ public static partial class bgfx
 	{
 		public long cpuTimeBegin;
 		public long cpuTimeEnd;
+		public uint uniformBytesSaved;
 	}
 	
 	public unsafe struct Stats
@@ -2157,9 +2178,19 @@ public static partial class bgfx
 		public long rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public int transientVbMax;
+		public int transientIbMax;
+		public ushort transientVbPages;
+		public ushort transientIbPages;
+		public long dynamicVbFree;
+		public long dynamicIbFree;
+		public uint dynamicVbLargestFree;
+		public uint dynamicIbLargestFree;
 		public fixed uint numPrims[5];
 		public long gpuMemoryMax;
 		public long gpuMemoryUsed;
+		public uint descriptorSetHits;
+		public uint descriptorSetMisses;
 		public ushort width;
 		public ushort height;
 		public ushort textWidth;
@@ -2182,6 +2213,11 @@ public static partial class bgfx
 	{
 	}
 	
+	public struct DrawListHandle {
+	    public ushort idx;
+	    public bool Valid => idx != UInt16.MaxValue;
+	}
+	
 	public struct DynamicIndexBufferHandle {
 	    public ushort idx;
 	    public bool Valid => idx != UInt16.MaxValue;
@@ -3140,6 +3176,24 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_get_direct_access_ptr", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void* get_direct_access_ptr(TextureHandle _handle);
 	
+	/// <summary>
+	/// Returns true once texture is created on render thread and can be used
+	/// for draw calls, updates, read back and frame buffer attachments.
+	/// @remarks
+	///   Texture created with `BGFX_TEXTURE_ASYNC` flag is created after loader
+	///   thread parses it and decodes format renderer can't sample natively.
+	///   Such texture must not be used before this function returns true.
+	///   Draw calls and dispatches binding it too early are discarded.
+	///   Texture memory is released on loader thread, `ReleaseFn` passed to
+	///   `makeRef` is called from it.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_is_texture_ready", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool is_texture_ready(TextureHandle _handle);
+	
 	/// <summary>
 	/// Destroy texture.
 	/// </summary>
@@ -3319,6 +3373,23 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_occlusion_query", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create draw list. Primitives recorded into draw list once can be
+	/// submitted in any later frame without encoding them again.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe DrawListHandle create_draw_list();
+	
+	/// <summary>
+	/// Destroy draw list.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw list object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_draw_list(DrawListHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3609,6 +3680,30 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint encoder_alloc_transform(Encoder* _this, Transform* _transform, ushort _num);
 	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from
+	/// scale/rotation/translation transforms. Returns `UINT32_MAX` and
+	/// writes nothing when matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_srt">Pointer to first SRT transform in array.</param>
+	/// <param name="_num">Number of transforms in array.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transform_srt", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint encoder_alloc_transform_srt(Encoder* _this, TransformSrt* _srt, ushort _num);
+	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from 4x3
+	/// affine matrices. Returns `UINT32_MAX` and writes nothing when
+	/// matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_mtx">Pointer to first 4x3 matrix in array.</param>
+	/// <param name="_num">Number of matrices in array.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transform_4x3", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint encoder_alloc_transform_4x3(Encoder* _this, Transform4x3* _mtx, ushort _num);
+	
 	/// <summary>
 	/// Set shader uniform parameter for draw primitive.
 	/// </summary>
@@ -3838,6 +3933,65 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_indirect", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_submit_indirect(Encoder* _this, ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, ushort _start, ushort _num, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Record primitive into draw list instead of submitting it for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_depth">Depth for sorting.</param>
+	/// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_record", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_record(Encoder* _this, DrawListHandle _handle, ProgramHandle _program, uint _depth, byte _flags);
+	
+	/// <summary>
+	/// Submit all primitives recorded into draw list for rendering.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_depth">Depth added to depth of each recorded primitive.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_draw_list(Encoder* _this, ushort _id, DrawListHandle _handle, uint _depth);
+	
+	/// <summary>
+	/// Allocate transient index buffer. Encoder reserves chunks of frame
+	/// transient index buffer and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tib">TransientIndexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of indices to allocate.</param>
+	/// <param name="_index32">Set to `true` if input indices will be 32-bit.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transient_index_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_alloc_transient_index_buffer(Encoder* _this, TransientIndexBuffer* _tib, uint _num, bool _index32);
+	
+	/// <summary>
+	/// Allocate transient vertex buffer. Encoder reserves chunks of frame
+	/// transient vertex buffer and sub-allocates from them without locking.
+	/// </summary>
+	///
+	/// <param name="_tvb">TransientVertexBuffer structure is filled and is valid for the duration of frame, and it can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of vertices to allocate.</param>
+	/// <param name="_layout">Vertex layout.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_transient_vertex_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_alloc_transient_vertex_buffer(Encoder* _this, TransientVertexBuffer* _tvb, uint _num, VertexLayout* _layout);
+	
+	/// <summary>
+	/// Allocate instance data buffer from encoder transient vertex buffer
+	/// chunk.
+	/// </summary>
+	///
+	/// <param name="_idb">InstanceDataBuffer structure is filled and is valid for duration of frame, and it can be reused for multiple draw calls.</param>
+	/// <param name="_num">Number of instances.</param>
+	/// <param name="_stride">Instance stride. Must be multiple of 16.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_alloc_instance_data_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_alloc_instance_data_buffer(Encoder* _this, InstanceDataBuffer* _idb, uint _num, ushort _stride);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4050,6 +4204,31 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_override_internal_texture", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe UIntPtr override_internal_texture(TextureHandle _handle, ushort _width, ushort _height, byte _numMips, TextureFormat _format, ulong _flags);
 	
+	/// <summary>
+	/// Replay frame from capture file written when library is compiled with
+	/// `BGFX_CONFIG_FRAME_CAPTURE`, and `bgfx::frame(true)` is called.
+	/// @attention Replayed frame must be the only submission in current frame. Replaying from
+	///   offset 0 destroys resources created by previous replay.
+	/// </summary>
+	///
+	/// <param name="_data">Capture file data.</param>
+	/// <param name="_size">Capture file data size.</param>
+	/// <param name="_offset">Offset of captured frame in capture file data.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_replay_frame", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint replay_frame(void* _data, uint _size, uint _offset);
+	
+	/// <summary>
+	/// Write spans recorded when library is compiled with `BGFX_CONFIG_TRACE_RECORDER`
+	/// as Chrome trace event JSON, viewable in `chrome://tracing` or Perfetto UI.
+	/// </summary>
+	///
+	/// <param name="_filePath">Trace file path.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_save_trace", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool save_trace([MarshalAs(UnmanagedType.LPStr)] string _filePath);
+	
 	/// <summary>
 	/// Sets a debug marker. This allows you to group graphics calls together for easy browsing in
 	/// graphics debugging tools.
@@ -4157,6 +4336,30 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_alloc_transform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint alloc_transform(Transform* _transform, ushort _num);
 	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from
+	/// scale/rotation/translation transforms. Returns `UINT32_MAX` and
+	/// writes nothing when matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_srt">Pointer to first SRT transform in array.</param>
+	/// <param name="_num">Number of transforms in array.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_alloc_transform_srt", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint alloc_transform_srt(TransformSrt* _srt, ushort _num);
+	
+	/// <summary>
+	/// Reserve matrices in internal matrix cache and fill them from 4x3
+	/// affine matrices. Returns `UINT32_MAX` and writes nothing when
+	/// matrix cache can't fit all of them.
+	/// </summary>
+	///
+	/// <param name="_mtx">Pointer to first 4x3 matrix in array.</param>
+	/// <param name="_num">Number of matrices in array.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_alloc_transform_4x3", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint alloc_transform_4x3(Transform4x3* _mtx, ushort _num);
+	
 	/// <summary>
 	/// Set shader uniform parameter for draw primitive.
 	/// </summary>
@@ -4394,6 +4597,29 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_submit_indirect", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void submit_indirect(ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, ushort _start, ushort _num, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Record primitive into draw list instead of submitting it for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_depth">Depth for sorting.</param>
+	/// <param name="_flags">Which states to discard for next draw. See `BGFX_DISCARD_*`.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_record", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void record(DrawListHandle _handle, ProgramHandle _program, uint _depth, byte _flags);
+	
+	/// <summary>
+	/// Submit all primitives recorded into draw list for rendering.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw list.</param>
+	/// <param name="_depth">Depth added to depth of each recorded primitive.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_draw_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_draw_list(ushort _id, DrawListHandle _handle, uint _depth);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -393,6 +393,7 @@ namespace bgfx
 
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
+	BGFX_HANDLE(DrawListHandle)
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
 	BGFX_HANDLE(FrameBufferHandle)
@@ -685,6 +686,9 @@ namespace bgfx
 			uint32_t minResourceCbSize; //!< Minimum resource command buffer size.  最小资源?命令缓冲区大小。
 			uint32_t transientVbSize;   //!< Maximum transient vertex buffer size.  最大瞬间顶点缓冲区大小。
 			uint32_t transientIbSize;   //!< Maximum transient index buffer size.  最大瞬间索引缓冲区大小。
+			uint32_t stagingBufferSize; //!< Per frame staging buffer size used for resource uploads.  每帧用于资源上传的 staging 缓冲区大小。
+			uint32_t maxDrawCalls;      //!< Maximum number of draw calls per frame, renderer can lower it, see `Caps::Limits::maxDrawCalls`.  每帧最大绘制调用数。
+			uint8_t  numFrames;         //!< Number of frames in flight between API and render thread.
 		};
 
 		Limits limits; //!< Configurable runtime limits.
@@ -926,6 +930,26 @@ namespace bgfx
 		uint16_t num; //!< Number of matrices.      矩阵的数量。
 	};
 
+	/// Scale/rotation/translation transform.
+	///
+	/// @attention C99 equivalent is `bgfx_transform_srt_t`.
+	///
+	struct TransformSrt
+	{
+		float rotate[4];    //!< Rotation quaternion (x, y, z, w).
+		float translate[4]; //!< Translation (x, y, z), w is ignored.
+		float scale[4];     //!< Scale (x, y, z), w is ignored.
+	};
+
+	/// Affine 4x3 transform.
+	///
+	/// @attention C99 equivalent is `bgfx_transform_4x3_t`.
+	///
+	struct Transform4x3
+	{
+		float data[12]; //!< x, y, z axis followed by translation.
+	};
+
 	/// View id.
 	typedef uint16_t ViewId; // ？？ View ID
 
@@ -951,6 +975,7 @@ namespace bgfx
 	{
 		int64_t cpuTimeBegin; //!< Encoder thread CPU submit begin time.   编码线程cpu submit开始时间
 		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.   编码线程cpu submit结束时间
+		uint32_t uniformBytesSaved; //!< Uniform data not written because value didn't change.
 	};
 
 	/// Renderer statistics data.  渲染器统计数据。
@@ -995,11 +1020,21 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.        使用的临时顶点缓冲区的数量。
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.     使用的临时索引缓冲区的数量。
+		int32_t transientVbMax;             //!< Peak amount of transient vertex buffer used in single frame.
+		int32_t transientIbMax;             //!< Peak amount of transient index buffer used in single frame.
+		uint16_t transientVbPages;          //!< Number of transient vertex buffer pages kept allocated.
+		uint16_t transientIbPages;          //!< Number of transient index buffer pages kept allocated.
+		int64_t dynamicVbFree;              //!< Free space in buffers shared by dynamic vertex buffers.
+		int64_t dynamicIbFree;              //!< Free space in buffers shared by dynamic index buffers.
+		uint32_t dynamicVbLargestFree;      //!< Largest free block in buffers shared by dynamic vertex buffers.
+		uint32_t dynamicIbLargestFree;      //!< Largest free block in buffers shared by dynamic index buffers.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered. 渲染的图元数。
 
 		int64_t gpuMemoryMax;               //!< Maximum available GPU memory for application.
 		int64_t gpuMemoryUsed;              //!< Amount of GPU memory used by the application.
+		uint32_t descriptorSetHits;         //!< Number of descriptor sets reused from cache (Vulkan only).
+		uint32_t descriptorSetMisses;       //!< Number of descriptor sets allocated and written (Vulkan only).
 
 		uint16_t width;                     //!< Backbuffer width in pixels.        后台缓冲区宽度（以像素为单位）。
 		uint16_t height;                    //!< Backbuffer height in pixels.
@@ -1160,6 +1195,42 @@ namespace bgfx
 			, uint16_t _num
 			);
 
+		/// Reserve `_num` matrices in internal matrix cache and fill them
+		/// from scale/rotation/translation transforms.
+		///
+		/// @param[in] _srt Pointer to first SRT transform in array. 16-byte
+		///   aligned array is expanded with SIMD.
+		/// @param[in] _num Number of transforms in array.
+		/// @returns Index of first matrix in matrix cache. Pass `first+ii`
+		///   to `setTransform(uint32_t _cache)` for each following submit.
+		///   `UINT32_MAX` if matrix cache can't fit all `_num` matrices, in
+		///   which case nothing is written.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transform_srt`.
+		///
+		uint32_t allocTransformSrt(
+			  const TransformSrt* _srt
+			, uint16_t _num
+			);
+
+		/// Reserve `_num` matrices in internal matrix cache and fill them
+		/// from 4x3 affine matrices.
+		///
+		/// @param[in] _mtx Pointer to first 4x3 matrix in array. 16-byte
+		///   aligned array is expanded with SIMD.
+		/// @param[in] _num Number of matrices in array.
+		/// @returns Index of first matrix in matrix cache. Pass `first+ii`
+		///   to `setTransform(uint32_t _cache)` for each following submit.
+		///   `UINT32_MAX` if matrix cache can't fit all `_num` matrices, in
+		///   which case nothing is written.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transform_4x3`.
+		///
+		uint32_t allocTransform4x3(
+			  const Transform4x3* _mtx
+			, uint16_t _num
+			);
+
 		/// Set model matrix from matrix cache for draw primitive.          从“矩阵缓存” 设置 模型矩阵，以绘制基元。
 		///
 		/// @param[in] _cache Index in matrix cache.                矩阵缓冲中的索引
@@ -1362,6 +1433,57 @@ namespace bgfx
 		///
 		void setVertexCount(uint32_t _numVertices);
 
+		/// Allocate transient index buffer. Encoder reserves chunks of frame
+		/// transient index buffer and sub-allocates from them without locking.
+		///
+		/// @param[out] _tib TransientIndexBuffer structure is filled and is valid
+		///   for the duration of frame, and it can be reused for multiple draw
+		///   calls.
+		/// @param[in] _num Number of indices to allocate.
+		/// @param[in] _index32 Set to `true` if input indices will be 32-bit.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transient_index_buffer`.
+		///
+		void allocTransientIndexBuffer(
+			  TransientIndexBuffer* _tib
+			, uint32_t _num
+			, bool _index32 = false
+			);
+
+		/// Allocate transient vertex buffer. Encoder reserves chunks of frame
+		/// transient vertex buffer and sub-allocates from them without locking.
+		///
+		/// @param[out] _tvb TransientVertexBuffer structure is filled and is valid
+		///   for the duration of frame, and it can be reused for multiple draw
+		///   calls.
+		/// @param[in] _num Number of vertices to allocate.
+		/// @param[in] _layout Vertex layout.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transient_vertex_buffer`.
+		///
+		void allocTransientVertexBuffer(
+			  TransientVertexBuffer* _tvb
+			, uint32_t _num
+			, const VertexLayout& _layout
+			);
+
+		/// Allocate instance data buffer from encoder transient vertex buffer
+		/// chunk.
+		///
+		/// @param[out] _idb InstanceDataBuffer structure is filled and is valid
+		///   for duration of frame, and it can be reused for multiple draw
+		///   calls.
+		/// @param[in] _num Number of instances.
+		/// @param[in] _stride Instance stride. Must be multiple of 16.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_instance_data_buffer`.
+		///
+		void allocInstanceDataBuffer(
+			  InstanceDataBuffer* _idb
+			, uint32_t _num
+			, uint16_t _stride
+			);
+
 		/// Set instance data buffer for draw primitive.  为绘制图元 设置   实例数据缓冲区 ???
 		///
 		/// @param[in] _idb Transient instance data buffer.
@@ -1518,6 +1640,45 @@ namespace bgfx
 			, uint8_t _flags = BGFX_DISCARD_ALL
 			);
 
+		/// Record primitive into draw list, instead of submitting it for
+		/// rendering.
+		///
+		/// @param[in] _handle Draw list.
+		/// @param[in] _program Program.
+		/// @param[in] _depth Depth for sorting.
+		/// @param[in] _flags Discard or preserve states. See `BGFX_DISCARD_*`.
+		///
+		/// @remarks
+		///   Transforms, scissor and uniforms are copied into draw list. Transient
+		///   buffers must not be used, since they are valid only for current frame.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_record`.
+		///
+		void record(
+			  DrawListHandle _handle
+			, ProgramHandle _program
+			, uint32_t _depth = 0
+			, uint8_t _flags  = BGFX_DISCARD_ALL
+			);
+
+		/// Submit all primitives recorded into draw list for rendering.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _handle Draw list.
+		/// @param[in] _depth Depth added to depth of each recorded primitive.
+		///
+		/// @remarks
+		///   Whole draw list is dropped if any buffer, program, texture or uniform
+		///   it references was destroyed after it was recorded.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_submit_draw_list`.
+		///
+		void submit(
+			  ViewId _id
+			, DrawListHandle _handle
+			, uint32_t _depth = 0
+			);
+
 		/// Set compute index buffer.  设置计算 索引缓冲区
 		///
 		/// @param[in] _stage Compute stage.    第几个参数??
@@ -3022,6 +3183,23 @@ namespace bgfx
 	///
 	void* getDirectAccessPtr(TextureHandle _handle);
 
+	/// Returns true once texture is created on render thread and can be used
+	/// for draw calls, updates, read back and frame buffer attachments.
+	///
+	/// @param[in] _handle Texture handle.
+	///
+	/// @remarks
+	///   Texture created with `BGFX_TEXTURE_ASYNC` flag is created after loader
+	///   thread parses it and decodes format renderer can't sample natively.
+	///   Such texture must not be used before this function returns true.
+	///   Draw calls and dispatches binding it too early are discarded.
+	///   Texture memory is released on loader thread, `ReleaseFn` passed to
+	///   `makeRef` is called from it.
+	///
+	/// @attention C99 equivalent is `bgfx_is_texture_ready`.
+	///
+	bool isTextureReady(TextureHandle _handle);
+
 	/// Destroy texture.
 	///
 	/// @param[in] _handle Texture handle.
@@ -3276,6 +3454,26 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Create draw list. Primitives recorded into draw list once can be
+	/// submitted in any later frame without encoding them again.
+	///
+	/// @returns Handle to draw list object.
+	///
+	/// @attention C99 equivalent is `bgfx_create_draw_list`.
+	///
+	DrawListHandle createDrawList();
+
+	/// Destroy draw list.
+	///
+	/// @param[in] _handle Handle to draw list object.
+	///
+	/// @remarks
+	///   Draw list can still be submitted until end of current frame.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_draw_list`.
+	///
+	void destroy(DrawListHandle _handle);
+
 	/// Set palette color value.  设置调色板颜色值 ？？？     调色板 用在什么地方 ???
 	///
 	/// @param[in] _index Index into palette.
@@ -3645,6 +3843,42 @@ namespace bgfx
 		, uint16_t _num
 		);
 
+	/// Reserve `_num` matrices in internal matrix cache and fill them
+	/// from scale/rotation/translation transforms.
+	///
+	/// @param[in] _srt Pointer to first SRT transform in array. 16-byte
+	///   aligned array is expanded with SIMD.
+	/// @param[in] _num Number of transforms in array.
+	/// @returns Index of first matrix in matrix cache. Pass `first+ii`
+	///   to `setTransform(uint32_t _cache)` for each following submit.
+	///   `UINT32_MAX` if matrix cache can't fit all `_num` matrices, in
+	///   which case nothing is written.
+	///
+	/// @attention C99 equivalent is `bgfx_alloc_transform_srt`.
+	///
+	uint32_t allocTransformSrt(
+		  const TransformSrt* _srt
+		, uint16_t _num
+		);
+
+	/// Reserve `_num` matrices in internal matrix cache and fill them
+	/// from 4x3 affine matrices.
+	///
+	/// @param[in] _mtx Pointer to first 4x3 matrix in array. 16-byte
+	///   aligned array is expanded with SIMD.
+	/// @param[in] _num Number of matrices in array.
+	/// @returns Index of first matrix in matrix cache. Pass `first+ii`
+	///   to `setTransform(uint32_t _cache)` for each following submit.
+	///   `UINT32_MAX` if matrix cache can't fit all `_num` matrices, in
+	///   which case nothing is written.
+	///
+	/// @attention C99 equivalent is `bgfx_alloc_transform_4x3`.
+	///
+	uint32_t allocTransform4x3(
+		  const Transform4x3* _mtx
+		, uint16_t _num
+		);
+
 	/// Set model matrix from matrix cache for draw primitive.
 	///
 	/// @param[in] _cache Index in matrix cache.
@@ -3990,6 +4224,41 @@ namespace bgfx
 		, uint8_t _flags  = BGFX_DISCARD_ALL
 		);
 
+	/// Record primitive into draw list, instead of submitting it for
+	/// rendering.
+	///
+	/// @param[in] _handle Draw list.
+	/// @param[in] _program Program.
+	/// @param[in] _depth Depth for sorting.
+	/// @param[in] _flags Which states to discard for next draw. See `BGFX_DISCARD_*`.
+	///
+	/// @remarks
+	///   Transforms, scissor and uniforms are copied into draw list. Transient
+	///   buffers must not be used, since they are valid only for current frame.
+	///
+	/// @attention C99 equivalent is `bgfx_record`.
+	///
+	void record(
+		  DrawListHandle _handle
+		, ProgramHandle _program
+		, uint32_t _depth = 0
+		, uint8_t _flags  = BGFX_DISCARD_ALL
+		);
+
+	/// Submit all primitives recorded into draw list for rendering.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Draw list.
+	/// @param[in] _depth Depth added to depth of each recorded primitive.
+	///
+	/// @attention C99 equivalent is `bgfx_submit_draw_list`.
+	///
+	void submit(
+		  ViewId _id
+		, DrawListHandle _handle
+		, uint32_t _depth = 0
+		);
+
 	/// Set compute index buffer.
 	///
 	/// @param[in] _stage Compute stage.
@@ -440,6 +440,8 @@ typedef struct bgfx_callback_vtbl_s
 
 } bgfx_callback_vtbl_t;
 
+typedef struct bgfx_draw_list_handle_s { uint16_t idx; } bgfx_draw_list_handle_t;
+
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
@@ -635,6 +637,9 @@ typedef struct bgfx_init_limits_s
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint32_t             stagingBufferSize;  /** Per frame staging buffer size used for resource uploads. */
+    uint32_t             maxDrawCalls;       /** Maximum number of draw calls per frame.  */
+    uint8_t              numFrames;          /** Number of frames in flight between API and render thread. */
 
 } bgfx_init_limits_t;
 
@@ -802,6 +807,28 @@ typedef struct bgfx_transform_s
 
 } bgfx_transform_t;
 
+/**
+ * Scale/rotation/translation transform.
+ *
+ */
+typedef struct bgfx_transform_srt_s
+{
+    float                rotate[4];          /** Rotation quaternion (x, y, z, w).        */
+    float                translate[4];       /** Translation (x, y, z), w is ignored.     */
+    float                scale[4];           /** Scale (x, y, z), w is ignored.           */
+
+} bgfx_transform_srt_t;
+
+/**
+ * Affine 4x3 transform.
+ *
+ */
+typedef struct bgfx_transform_4x3_s
+{
+    float                data[12];           /** x, y, z axis followed by translation.    */
+
+} bgfx_transform_4x3_t;
+
 /**
  * View stats.
  *
@@ -825,6 +852,7 @@ typedef struct bgfx_encoder_stats_s
 {
     int64_t              cpuTimeBegin;       /** Encoder thread CPU submit begin time.    */
     int64_t              cpuTimeEnd;         /** Encoder thread CPU submit end time.      */
+    uint32_t             uniformBytesSaved;  /** Uniform data not written because value didn't change. */
 
 } bgfx_encoder_stats_t;
 
@@ -864,9 +892,19 @@ typedef struct bgfx_stats_s
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    int32_t              transientVbMax;     /** Peak amount of transient vertex buffer used in single frame. */
+    int32_t              transientIbMax;     /** Peak amount of transient index buffer used in single frame. */
+    uint16_t             transientVbPages;   /** Number of transient vertex buffer pages kept allocated. */
+    uint16_t             transientIbPages;   /** Number of transient index buffer pages kept allocated. */
+    int64_t              dynamicVbFree;      /** Free space in buffers shared by dynamic vertex buffers. */
+    int64_t              dynamicIbFree;      /** Free space in buffers shared by dynamic index buffers. */
+    uint32_t             dynamicVbLargestFree; /** Largest free block in buffers shared by dynamic vertex buffers. */
+    uint32_t             dynamicIbLargestFree; /** Largest free block in buffers shared by dynamic index buffers. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
+    uint32_t             descriptorSetHits;  /** Number of descriptor sets reused from cache (Vulkan only). */
+    uint32_t             descriptorSetMisses; /** Number of descriptor sets allocated and written (Vulkan only). */
     uint16_t             width;              /** Backbuffer width in pixels.              */
     uint16_t             height;             /** Backbuffer height in pixels.             */
     uint16_t             textWidth;          /** Debug text width in characters.          */
@@ -1958,6 +1996,24 @@ BGFX_C_API void bgfx_set_texture_name(bgfx_texture_handle_t _handle, const char*
  */
 BGFX_C_API void* bgfx_get_direct_access_ptr(bgfx_texture_handle_t _handle);
 
+/**
+ * Returns true once texture is created on render thread and can be used
+ * for draw calls, updates, read back and frame buffer attachments.
+ * @remarks
+ *   Texture created with `BGFX_TEXTURE_ASYNC` flag is created after loader
+ *   thread parses it and decodes format renderer can't sample natively.
+ *   Such texture must not be used before this function returns true.
+ *   Draw calls and dispatches binding it too early are discarded.
+ *   Texture memory is released on loader thread, `ReleaseFn` passed to
+ *   `makeRef` is called from it.
+ *
+ * @param[in] _handle Texture handle.
+ *
+ * @returns True if texture is created.
+ *
+ */
+BGFX_C_API bool bgfx_is_texture_ready(bgfx_texture_handle_t _handle);
+
 /**
  * Destroy texture.
  *
@@ -2152,6 +2208,21 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Create draw list. Primitives recorded into draw list once can be
+ * submitted in any later frame without encoding them again.
+ *
+ */
+BGFX_C_API bgfx_draw_list_handle_t bgfx_create_draw_list(void);
+
+/**
+ * Destroy draw list.
+ *
+ * @param[in] _handle Handle to draw list object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_draw_list(bgfx_draw_list_handle_t _handle);
+
 /**
  * Set palette color value.
  *
@@ -2445,6 +2516,32 @@ BGFX_C_API void bgfx_encoder_set_transform_cached(bgfx_encoder_t* _this, uint32_
  */
 BGFX_C_API uint32_t bgfx_encoder_alloc_transform(bgfx_encoder_t* _this, bgfx_transform_t* _transform, uint16_t _num);
 
+/**
+ * Reserve matrices in internal matrix cache and fill them from
+ * scale/rotation/translation transforms. Returns `UINT32_MAX` and
+ * writes nothing when matrix cache can't fit all of them.
+ *
+ * @param[in] _srt Pointer to first SRT transform in array.
+ * @param[in] _num Number of transforms in array.
+ *
+ * @returns Index of first matrix in matrix cache.
+ *
+ */
+BGFX_C_API uint32_t bgfx_encoder_alloc_transform_srt(bgfx_encoder_t* _this, const bgfx_transform_srt_t* _srt, uint16_t _num);
+
+/**
+ * Reserve matrices in internal matrix cache and fill them from 4x3
+ * affine matrices. Returns `UINT32_MAX` and writes nothing when
+ * matrix cache can't fit all of them.
+ *
+ * @param[in] _mtx Pointer to first 4x3 matrix in array.
+ * @param[in] _num Number of matrices in array.
+ *
+ * @returns Index of first matrix in matrix cache.
+ *
+ */
+BGFX_C_API uint32_t bgfx_encoder_alloc_transform_4x3(bgfx_encoder_t* _this, const bgfx_transform_4x3_t* _mtx, uint16_t _num);
+
 /**
  * Set shader uniform parameter for draw primitive.
  *
@@ -2666,6 +2763,66 @@ BGFX_C_API void bgfx_encoder_submit_occlusion_query(bgfx_encoder_t* _this, bgfx_
  */
 BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Record primitive into draw list instead of submitting it for rendering.
+ *
+ * @param[in] _handle Draw list.
+ * @param[in] _program Program.
+ * @param[in] _depth Depth for sorting.
+ * @param[in] _flags Discard or preserve states. See `BGFX_DISCARD_*`.
+ *
+ */
+BGFX_C_API void bgfx_encoder_record(bgfx_encoder_t* _this, bgfx_draw_list_handle_t _handle, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
+
+/**
+ * Submit all primitives recorded into draw list for rendering.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw list.
+ * @param[in] _depth Depth added to depth of each recorded primitive.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_draw_list(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, uint32_t _depth);
+
+/**
+ * Allocate transient index buffer. Encoder reserves chunks of frame
+ * transient index buffer and sub-allocates from them without locking.
+ *
+ * @param[out] _tib TransientIndexBuffer structure is filled and is valid
+ *  for the duration of frame, and it can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of indices to allocate.
+ * @param[in] _index32 Set to `true` if input indices will be 32-bit.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
+
+/**
+ * Allocate transient vertex buffer. Encoder reserves chunks of frame
+ * transient vertex buffer and sub-allocates from them without locking.
+ *
+ * @param[out] _tvb TransientVertexBuffer structure is filled and is valid
+ *  for the duration of frame, and it can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of vertices to allocate.
+ * @param[in] _layout Vertex layout.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout);
+
+/**
+ * Allocate instance data buffer from encoder transient vertex buffer
+ * chunk.
+ *
+ * @param[out] _idb InstanceDataBuffer structure is filled and is valid
+ *  for duration of frame, and it can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of instances.
+ * @param[in] _stride Instance stride. Must be multiple of 16.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
+
 /**
  * Set compute index buffer.
  *
@@ -2881,6 +3038,35 @@ BGFX_C_API uintptr_t bgfx_override_internal_texture_ptr(bgfx_texture_handle_t _h
  */
 BGFX_C_API uintptr_t bgfx_override_internal_texture(bgfx_texture_handle_t _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, bgfx_texture_format_t _format, uint64_t _flags);
 
+/**
+ * Replay frame from capture file written when library is compiled with
+ * `BGFX_CONFIG_FRAME_CAPTURE`, and `bgfx::frame(true)` is called.
+ * @attention Replayed frame must be the only submission in current frame. Replaying from
+ *   offset 0 destroys resources created by previous replay.
+ *
+ * @param[in] _data Capture file data.
+ * @param[in] _size Capture file data size.
+ * @param[in] _offset Offset of captured frame in capture file data.
+ *
+ * @returns Offset of next captured frame, `_size` after last frame, or `UINT32_MAX`
+ *  if capture data is invalid, or it's written by different library version
+ *  or configuration.
+ *
+ */
+BGFX_C_API uint32_t bgfx_replay_frame(const void* _data, uint32_t _size, uint32_t _offset);
+
+/**
+ * Write spans recorded when library is compiled with `BGFX_CONFIG_TRACE_RECORDER`
+ * as Chrome trace event JSON, viewable in `chrome://tracing` or Perfetto UI.
+ *
+ * @param[in] _filePath Trace file path.
+ *
+ * @returns True if trace file is written, false if trace recorder is disabled
+ *  or file cannot be written.
+ *
+ */
+BGFX_C_API bool bgfx_save_trace(const char* _filePath);
+
 /**
  * Sets a debug marker. This allows you to group graphics calls together for easy browsing in
  * graphics debugging tools.
@@ -2996,6 +3182,32 @@ BGFX_C_API void bgfx_set_transform_cached(uint32_t _cache, uint16_t _num);
  */
 BGFX_C_API uint32_t bgfx_alloc_transform(bgfx_transform_t* _transform, uint16_t _num);
 
+/**
+ * Reserve matrices in internal matrix cache and fill them from
+ * scale/rotation/translation transforms. Returns `UINT32_MAX` and
+ * writes nothing when matrix cache can't fit all of them.
+ *
+ * @param[in] _srt Pointer to first SRT transform in array.
+ * @param[in] _num Number of transforms in array.
+ *
+ * @returns Index of first matrix in matrix cache.
+ *
+ */
+BGFX_C_API uint32_t bgfx_alloc_transform_srt(const bgfx_transform_srt_t* _srt, uint16_t _num);
+
+/**
+ * Reserve matrices in internal matrix cache and fill them from 4x3
+ * affine matrices. Returns `UINT32_MAX` and writes nothing when
+ * matrix cache can't fit all of them.
+ *
+ * @param[in] _mtx Pointer to first 4x3 matrix in array.
+ * @param[in] _num Number of matrices in array.
+ *
+ * @returns Index of first matrix in matrix cache.
+ *
+ */
+BGFX_C_API uint32_t bgfx_alloc_transform_4x3(const bgfx_transform_4x3_t* _mtx, uint16_t _num);
+
 /**
  * Set shader uniform parameter for draw primitive.
  *
@@ -3228,6 +3440,27 @@ BGFX_C_API void bgfx_submit_occlusion_query(bgfx_view_id_t _id, bgfx_program_han
  */
 BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Record primitive into draw list instead of submitting it for rendering.
+ *
+ * @param[in] _handle Draw list.
+ * @param[in] _program Program.
+ * @param[in] _depth Depth for sorting.
+ * @param[in] _flags Which states to discard for next draw. See `BGFX_DISCARD_*`.
+ *
+ */
+BGFX_C_API void bgfx_record(bgfx_draw_list_handle_t _handle, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
+
+/**
+ * Submit all primitives recorded into draw list for rendering.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw list.
+ * @param[in] _depth Depth added to depth of each recorded primitive.
+ *
+ */
+BGFX_C_API void bgfx_submit_draw_list(bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, uint32_t _depth);
+
 /**
  * Set compute index buffer.
  *
@@ -3633,6 +3866,7 @@ struct bgfx_interface_vtbl
     uint32_t (*read_texture)(bgfx_texture_handle_t _handle, void* _data, uint8_t _mip);
     void (*set_texture_name)(bgfx_texture_handle_t _handle, const char* _name, int32_t _len);
     void* (*get_direct_access_ptr)(bgfx_texture_handle_t _handle);
+    bool (*is_texture_ready)(bgfx_texture_handle_t _handle);
     void (*destroy_texture)(bgfx_texture_handle_t _handle);
     bgfx_frame_buffer_handle_t (*create_frame_buffer)(uint16_t _width, uint16_t _height, bgfx_texture_format_t _format, uint64_t _textureFlags);
     bgfx_frame_buffer_handle_t (*create_frame_buffer_scaled)(bgfx_backbuffer_ratio_t _ratio, bgfx_texture_format_t _format, uint64_t _textureFlags);
@@ -3648,6 +3882,8 @@ struct bgfx_interface_vtbl
     bgfx_occlusion_query_handle_t (*create_occlusion_query)(void);
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    bgfx_draw_list_handle_t (*create_draw_list)(void);
+    void (*destroy_draw_list)(bgfx_draw_list_handle_t _handle);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
     void (*set_view_name)(bgfx_view_id_t _id, const char* _name);
@@ -3672,6 +3908,8 @@ struct bgfx_interface_vtbl
     uint32_t (*encoder_set_transform)(bgfx_encoder_t* _this, const void* _mtx, uint16_t _num);
     void (*encoder_set_transform_cached)(bgfx_encoder_t* _this, uint32_t _cache, uint16_t _num);
     uint32_t (*encoder_alloc_transform)(bgfx_encoder_t* _this, bgfx_transform_t* _transform, uint16_t _num);
+    uint32_t (*encoder_alloc_transform_srt)(bgfx_encoder_t* _this, const bgfx_transform_srt_t* _srt, uint16_t _num);
+    uint32_t (*encoder_alloc_transform_4x3)(bgfx_encoder_t* _this, const bgfx_transform_4x3_t* _mtx, uint16_t _num);
     void (*encoder_set_uniform)(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
     void (*encoder_set_index_buffer)(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_dynamic_index_buffer)(bgfx_encoder_t* _this, bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3692,6 +3930,11 @@ struct bgfx_interface_vtbl
     void (*encoder_submit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_occlusion_query)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_indirect)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
+    void (*encoder_record)(bgfx_encoder_t* _this, bgfx_draw_list_handle_t _handle, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
+    void (*encoder_submit_draw_list)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, uint32_t _depth);
+    void (*encoder_alloc_transient_index_buffer)(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
+    void (*encoder_alloc_transient_vertex_buffer)(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout);
+    void (*encoder_alloc_instance_data_buffer)(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
     void (*encoder_set_compute_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_vertex_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_dynamic_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -3708,6 +3951,8 @@ struct bgfx_interface_vtbl
     const bgfx_internal_data_t* (*get_internal_data)(void);
     uintptr_t (*override_internal_texture_ptr)(bgfx_texture_handle_t _handle, uintptr_t _ptr);
     uintptr_t (*override_internal_texture)(bgfx_texture_handle_t _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, bgfx_texture_format_t _format, uint64_t _flags);
+    uint32_t (*replay_frame)(const void* _data, uint32_t _size, uint32_t _offset);
+    bool (*save_trace)(const char* _filePath);
     void (*set_marker)(const char* _marker);
     void (*set_state)(uint64_t _state, uint32_t _rgba);
     void (*set_condition)(bgfx_occlusion_query_handle_t _handle, bool _visible);
@@ -3717,6 +3962,8 @@ struct bgfx_interface_vtbl
     uint32_t (*set_transform)(const void* _mtx, uint16_t _num);
     void (*set_transform_cached)(uint32_t _cache, uint16_t _num);
     uint32_t (*alloc_transform)(bgfx_transform_t* _transform, uint16_t _num);
+    uint32_t (*alloc_transform_srt)(const bgfx_transform_srt_t* _srt, uint16_t _num);
+    uint32_t (*alloc_transform_4x3)(const bgfx_transform_4x3_t* _mtx, uint16_t _num);
     void (*set_uniform)(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
     void (*set_index_buffer)(bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*set_dynamic_index_buffer)(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3737,6 +3984,8 @@ struct bgfx_interface_vtbl
     void (*submit)(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
     void (*submit_occlusion_query)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*submit_indirect)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
+    void (*record)(bgfx_draw_list_handle_t _handle, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
+    void (*submit_draw_list)(bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, uint32_t _depth);
     void (*set_compute_index_buffer)(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_vertex_buffer)(uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_dynamic_index_buffer)(uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
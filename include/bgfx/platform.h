@@ -132,6 +132,36 @@ namespace bgfx
 		, uint64_t _flags = BGFX_TEXTURE_NONE|BGFX_SAMPLER_NONE
 		);
 
+	/// Replay frame from capture file written when library is compiled with
+	/// `BGFX_CONFIG_FRAME_CAPTURE`, and `bgfx::frame(true)` is called.
+	///
+	/// @param[in] _data Capture file data.
+	/// @param[in] _size Capture file data size.
+	/// @param[in] _offset Offset of captured frame in capture file data.
+	///
+	/// @returns Offset of next captured frame, `_size` after last frame, or `UINT32_MAX`
+	///   if capture data is invalid, or it's written by different library version
+	///   or configuration.
+	///
+	/// @attention Replayed frame must be the only submission in current frame. Replaying from
+	///   offset 0 destroys resources created by previous replay.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_frame`.
+	///
+	uint32_t replayFrame(const void* _data, uint32_t _size, uint32_t _offset);
+
+	/// Write spans recorded when library is compiled with `BGFX_CONFIG_TRACE_RECORDER`
+	/// as Chrome trace event JSON, viewable in `chrome://tracing` or Perfetto UI.
+	///
+	/// @param[in] _filePath Trace file path.
+	///
+	/// @returns True if trace file is written, false if trace recorder is disabled
+	///   or file cannot be written.
+	///
+	/// @attention C99 equivalent is `bgfx_save_trace`.
+	///
+	bool saveTrace(const char* _filePath);
+
 } // namespace bgfx
 
 #endif // BGFX_PLATFORM_H_HEADER_GUARD
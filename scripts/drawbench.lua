@@ -0,0 +1,53 @@
+--
+-- Copyright 2010-2021 Branimir Karadzic. All rights reserved.
+-- License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+--
+
+project "drawbench"
+	uuid (os.uuid("drawbench"))
+	kind "ConsoleApp"
+
+	includedirs {
+		path.join(BX_DIR,   "include"),
+		path.join(BIMG_DIR, "include"),
+		path.join(BGFX_DIR, "include"),
+	}
+
+	files {
+		path.join(BGFX_DIR, "tools/drawbench/**.cpp"),
+		path.join(BGFX_DIR, "tools/drawbench/**.h"),
+	}
+
+	links {
+		"bgfx",
+		"bimg",
+		"bx",
+	}
+
+	configuration { "mingw-*" }
+		targetextension ".exe"
+
+	configuration { "vs20* or mingw*" }
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "linux-* or freebsd" }
+		links {
+			"X11",
+			"GL",
+			"pthread",
+		}
+
+	configuration { "osx*" }
+		linkoptions {
+			"-framework Cocoa",
+			"-framework Metal",
+			"-framework QuartzCore",
+			"-framework OpenGL",
+		}
+
+	configuration {}
+
+	strip()
@@ -609,4 +609,6 @@ if _OPTIONS["with-tools"] then
 	dofile "texturev.lua"
 	dofile "geometryc.lua"
 	dofile "geometryv.lua"
+	dofile "framereplay.lua"
+	dofile "drawbench.lua"
 end
@@ -4,7 +4,9 @@
  */
 
 #include "bgfx.cpp"
+#include "debug_capture.cpp"
 #include "debug_renderdoc.cpp"
+#include "debug_trace.cpp"
 #include "dxgi.cpp"
 #include "glcontext_egl.cpp"
 #include "glcontext_glx.cpp"
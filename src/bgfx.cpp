@@ -296,10 +296,12 @@ namespace bgfx
 	};
 
 	static ThreadData s_threadIndex(0);
+	static ThreadData s_threadEncoder(0);
 #elif !BGFX_CONFIG_MULTITHREADED
 	static uint32_t s_threadIndex(0); // 没有配置 多线程
 #else
 	static BX_THREAD_LOCAL uint32_t s_threadIndex(0); // 配置了多线程 并且 BX_THREAD_LOCAL=1  MAC是这个
+	static BX_THREAD_LOCAL uint32_t s_threadEncoder(0);
 #endif
 
 	static Context* s_ctx = NULL;
@@ -989,6 +991,8 @@ namespace bgfx
 		return PredefinedUniform::Count;
 	}
 
+	BX_STATIC_ASSERT(sizeof(Srt) == sizeof(TransformSrt) );
+
 	void srtToMatrix4_x1(void* _dst, const void* _src)
 	{
 		      Matrix4* mtx = reinterpret_cast<  Matrix4*>(_dst);
@@ -1208,6 +1212,85 @@ namespace bgfx
 		}
 	}
 
+	// 4x3 is x, y, z axis followed by translation, expanded to 4x4 with last
+	// column 0, 0, 0, 1.
+	void mtx4x3ToMatrix4_x1(void* _dst, const void* _src)
+	{
+		      float* dst = reinterpret_cast<      float*>(_dst);
+		const float* src = reinterpret_cast<const float*>(_src);
+
+		dst[ 0] = src[ 0];
+		dst[ 1] = src[ 1];
+		dst[ 2] = src[ 2];
+		dst[ 3] = 0.0f;
+
+		dst[ 4] = src[ 3];
+		dst[ 5] = src[ 4];
+		dst[ 6] = src[ 5];
+		dst[ 7] = 0.0f;
+
+		dst[ 8] = src[ 6];
+		dst[ 9] = src[ 7];
+		dst[10] = src[ 8];
+		dst[11] = 0.0f;
+
+		dst[12] = src[ 9];
+		dst[13] = src[10];
+		dst[14] = src[11];
+		dst[15] = 1.0f;
+	}
+
+	void mtx4x3ToMatrix4_x1_Simd(void* _dst, const void* _src)
+	{
+		using namespace bx;
+
+		      simd128_t* dst = reinterpret_cast<      simd128_t*>(_dst);
+		const simd128_t* src = reinterpret_cast<const simd128_t*>(_src);
+
+		const simd128_t abcd = simd_ld<simd128_t>(src + 0);
+		const simd128_t efgh = simd_ld<simd128_t>(src + 1);
+		const simd128_t ijkl = simd_ld<simd128_t>(src + 2);
+
+		const simd128_t mask = simd_ild<simd128_t>(UINT32_MAX, UINT32_MAX, UINT32_MAX, 0);
+		const simd128_t one  = simd_splat(1.0f);
+
+		const simd128_t dedf = simd_shuf_xAyB(simd_swiz_wwww(abcd), efgh);  // d e d f
+		const simd128_t ghij = simd_shuf_xyAB(simd_swiz_zwzw(efgh), ijkl);  // g h i j
+		const simd128_t jkli = simd_swiz_yzwx(ijkl);                        // j k l i
+
+		simd_st(dst + 0, simd_and(abcd, mask) );
+		simd_st(dst + 1, simd_and(simd_swiz_xywz(dedf), mask) );
+		simd_st(dst + 2, simd_and(ghij, mask) );
+		simd_st(dst + 3, simd_selb(mask, jkli, one) );
+	}
+
+	void mtx4x3ToMatrix4(void* _dst, const void* _src, uint32_t _num)
+	{
+		      uint8_t* dst = reinterpret_cast<      uint8_t*>(_dst);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(_src);
+
+		const uint32_t srcStride = 12*sizeof(float);
+
+		if (!bx::isAligned(src, 16) )
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				mtx4x3ToMatrix4_x1(dst, src);
+				src += srcStride;
+				dst += sizeof(Matrix4);
+			}
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				mtx4x3ToMatrix4_x1_Simd(dst, src);
+				src += srcStride;
+				dst += sizeof(Matrix4);
+			}
+		}
+	}
+
 	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
@@ -1240,8 +1323,8 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS <= renderItemIdx)
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard(_flags);
 			++m_numDropped;
@@ -1271,51 +1354,459 @@ namespace bgfx
 
 		uint64_t key = m_key.encodeDraw(type);
 
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		m_frame->m_sortKeyBuffer[m_uniformIdx].add(key, RenderItemCount(renderItemIdx) );
 
 		m_draw.m_uniformIdx   = m_uniformIdx;
 		m_draw.m_uniformBegin = m_uniformBegin;
 		m_draw.m_uniformEnd   = m_uniformEnd;
+		m_draw.m_numVertices  = getNumVertices();
+
+		if (isValid(_occlusionQuery) )
+		{
+			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
+			m_draw.m_occlusionQuery = _occlusionQuery;
+		}
+
+		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
+		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+
+		m_draw.clear(_flags);
+		m_bind.clear(_flags);
+		m_dynamic.clear(_flags);
+		if (_flags & BGFX_DISCARD_STATE)
+		{
+			m_uniformBegin = m_uniformEnd;
+		}
+	}
+
+	void EncoderImpl::record(DrawList& _drawList, ProgramHandle _program, uint32_t _depth, uint8_t _flags)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
+		&& (_flags & BGFX_DISCARD_STATE))
+		{
+			m_uniformSet.clear();
+		}
+
+		if (m_discard
+		|| (0 == m_draw.m_numVertices && 0 == m_draw.m_numIndices) )
+		{
+			discard(_flags);
+			return;
+		}
 
-		if (UINT8_MAX != m_draw.m_streamMask)
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		{
-			uint32_t numVertices = UINT32_MAX;
-			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
-				; 0 != streamMask
-				; streamMask >>= 1, idx += 1
-				)
+			for (uint32_t page = 0; page < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++page)
 			{
-				const uint32_t ntz = bx::uint32_cnttz(streamMask);
-				streamMask >>= ntz;
-				idx         += ntz;
-				numVertices = bx::min(numVertices, m_numVertices[idx]);
-			}
+				const TransientVertexBuffer* tvb = m_frame->m_transientVb[page];
+				for (uint32_t idx = 0; NULL != tvb && idx < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++idx)
+				{
+					BX_ASSERT(0 == (m_draw.m_streamMask & (1<<idx) ) || m_draw.m_stream[idx].m_handle.idx != tvb->handle.idx
+						, "Transient vertex buffer can't be recorded into draw list."
+						);
+				}
 
-			m_draw.m_numVertices = numVertices;
+				const TransientIndexBuffer* tib = m_frame->m_transientIb[page];
+				BX_ASSERT(NULL == tib || m_draw.m_indexBuffer.idx != tib->handle.idx
+					, "Transient index buffer can't be recorded into draw list."
+					);
+			}
 		}
-		else
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		DrawList::Item& item = *DrawList::append(_drawList.m_item, _drawList.m_numItems, _drawList.m_maxItems, 1);
+		item.m_draw    = m_draw;
+		item.m_bind    = m_bind;
+		item.m_program = isValid(_program) ? _program : ProgramHandle{0};
+		item.m_depth   = _depth;
+		item.m_blend   = m_key.m_blend;
+
+		RenderDraw& draw = item.m_draw;
+		draw.m_numVertices = getNumVertices();
+
+		recordResources(_drawList, item);
+
+		if (0 != draw.m_startMatrix)
 		{
-			m_draw.m_numVertices = m_numVertices[0];
+			const MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+			const uint32_t first = _drawList.m_numMatrices;
+			Matrix4* mtx = DrawList::append(_drawList.m_matrix, _drawList.m_numMatrices, _drawList.m_maxMatrices, draw.m_numMatrices);
+			bx::memCopy(mtx, &matrixCache.m_cache[draw.m_startMatrix], sizeof(Matrix4)*draw.m_numMatrices);
+			draw.m_startMatrix = first + 1;
 		}
 
-		if (isValid(_occlusionQuery) )
+		if (UINT16_MAX != draw.m_scissor)
 		{
-			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
-			m_draw.m_occlusionQuery = _occlusionQuery;
+			const RectCache& rectCache = m_frame->m_frameCache.m_rectCache;
+			const uint32_t first = _drawList.m_numRects;
+			*DrawList::append(_drawList.m_rect, _drawList.m_numRects, _drawList.m_maxRects, 1) = rectCache.m_cache[draw.m_scissor];
+			draw.m_scissor = uint16_t(first);
 		}
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+		const uint32_t uniformSize = uniformBuffer->copyResolved(NULL, m_uniformBegin, m_uniformEnd);
+		draw.m_uniformIdx   = 0;
+		draw.m_uniformBegin = _drawList.m_uniformSize;
+		draw.m_uniformEnd   = _drawList.m_uniformSize + uniformSize;
+
+		if (0 != uniformSize)
+		{
+			// Draw list uniforms are appended elsewhere on submit, references
+			// to values written earlier are expanded.
+			uint8_t* data = DrawList::append(_drawList.m_uniform, _drawList.m_uniformSize, _drawList.m_maxUniform, uniformSize);
+			uniformBuffer->copyResolved(data, m_uniformBegin, m_uniformEnd);
+
+			// Encoder writes uniform handle as location.
+			for (uint32_t pos = 0; pos < uniformSize;)
+			{
+				uint32_t opcode;
+				bx::memCopy(&opcode, &data[pos], sizeof(uint32_t) );
+
+				UniformType::Enum type;
+				uint16_t loc;
+				uint16_t num;
+				uint16_t copy;
+				UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+				if (UniformType::Count > type)
+				{
+					_drawList.addResource(DrawList::Resource::Uniform, loc, s_ctx->getHandleGen(DrawList::Resource::Uniform, loc) );
+				}
+
+				pos += sizeof(uint32_t) + g_uniformTypeSize[type]*num;
+			}
+		}
 
 		m_draw.clear(_flags);
 		m_bind.clear(_flags);
+		m_dynamic.clear(_flags);
 		if (_flags & BGFX_DISCARD_STATE)
 		{
 			m_uniformBegin = m_uniformEnd;
 		}
 	}
 
+	void EncoderImpl::recordResources(DrawList& _drawList, const DrawList::Item& _item)
+	{
+		const RenderDraw& draw = _item.m_draw;
+
+		_drawList.addResource(DrawList::Resource::Program, _item.m_program.idx, s_ctx->getHandleGen(DrawList::Resource::Program, _item.m_program.idx) );
+		_drawList.addResource(DrawList::Resource::IndexBuffer, draw.m_indexBuffer.idx, s_ctx->getHandleGen(DrawList::Resource::IndexBuffer, draw.m_indexBuffer.idx) );
+		_drawList.addResource(DrawList::Resource::VertexBuffer, draw.m_instanceDataBuffer.idx, s_ctx->getHandleGen(DrawList::Resource::VertexBuffer, draw.m_instanceDataBuffer.idx) );
+		_drawList.addResource(DrawList::Resource::VertexBuffer, draw.m_indirectBuffer.idx, s_ctx->getHandleGen(DrawList::Resource::VertexBuffer, draw.m_indirectBuffer.idx) );
+
+		for (uint32_t idx = 0, streamMask = draw.m_streamMask
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1
+			)
+		{
+			const uint32_t ntz = bx::uint32_cnttz(streamMask);
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const uint16_t handle = draw.m_stream[idx].m_handle.idx;
+			_drawList.addResource(DrawList::Resource::VertexBuffer, handle, s_ctx->getHandleGen(DrawList::Resource::VertexBuffer, handle) );
+		}
+
+		for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			const Binding& bind = _item.m_bind.m_bind[stage];
+
+			DrawList::Resource::Enum type = DrawList::Resource::Texture;
+			switch (bind.m_type)
+			{
+			case Binding::IndexBuffer:  type = DrawList::Resource::IndexBuffer;  break;
+			case Binding::VertexBuffer: type = DrawList::Resource::VertexBuffer; break;
+			default: break;
+			}
+
+			_drawList.addResource(type, bind.m_idx, s_ctx->getHandleGen(type, bind.m_idx) );
+		}
+
+		// Dynamic buffers are suballocated, destroying one doesn't destroy
+		// buffer it was allocated from, and its range can be reused.
+		_drawList.addResource(DrawList::Resource::DynamicIndexBuffer, m_dynamic.m_indexBuffer.idx, s_ctx->getHandleGen(DrawList::Resource::DynamicIndexBuffer, m_dynamic.m_indexBuffer.idx) );
+
+		if (isValid(draw.m_instanceDataBuffer) )
+		{
+			_drawList.addResource(DrawList::Resource::DynamicVertexBuffer, m_dynamic.m_instanceDataBuffer.idx, s_ctx->getHandleGen(DrawList::Resource::DynamicVertexBuffer, m_dynamic.m_instanceDataBuffer.idx) );
+		}
+
+		for (uint32_t idx = 0, streamMask = draw.m_streamMask
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1
+			)
+		{
+			const uint32_t ntz = bx::uint32_cnttz(streamMask);
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const uint16_t handle = m_dynamic.m_stream[idx].idx;
+			_drawList.addResource(DrawList::Resource::DynamicVertexBuffer, handle, s_ctx->getHandleGen(DrawList::Resource::DynamicVertexBuffer, handle) );
+		}
+
+		for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+		{
+			const uint16_t handle = m_dynamic.m_bind[stage];
+			const DrawList::Resource::Enum type = Binding::IndexBuffer == _item.m_bind.m_bind[stage].m_type
+				? DrawList::Resource::DynamicIndexBuffer
+				: DrawList::Resource::DynamicVertexBuffer
+				;
+			_drawList.addResource(type, handle, s_ctx->getHandleGen(type, handle) );
+		}
+	}
+
+	void EncoderImpl::submit(ViewId _id, const DrawList& _drawList, uint32_t _depth)
+	{
+		const uint32_t numItems = _drawList.m_numItems;
+		if (0 == numItems
+		||  m_discard)
+		{
+			return;
+		}
+
+		if (!s_ctx->isDrawListValid(_drawList) )
+		{
+			BX_WARN(false, "Draw list references destroyed resource, draw list with %d draw calls is dropped.", numItems);
+			m_numDropped += numItems;
+			return;
+		}
+
+		FrameCache& frameCache = m_frame->m_frameCache;
+
+		MatrixCache& matrixCache = frameCache.m_matrixCache;
+		const uint32_t numMatrices = _drawList.m_numMatrices;
+		const uint32_t firstMatrix = bx::atomicFetchAndAddsat<uint32_t>(&matrixCache.m_num, numMatrices, matrixCache.m_max - 1);
+
+		RectCache& rectCache = frameCache.m_rectCache;
+		const uint32_t numRects  = _drawList.m_numRects;
+		const uint32_t firstRect = bx::atomicFetchAndAddsat<uint32_t>(&rectCache.m_num, numRects, BGFX_CONFIG_MAX_RECT_CACHE-1);
+
+		if (firstMatrix + numMatrices >= matrixCache.m_max
+		||  firstRect   + numRects    >= BGFX_CONFIG_MAX_RECT_CACHE)
+		{
+			BX_WARN(false, "Frame cache overflow, draw list with %d draw calls is dropped.", numItems);
+			m_numDropped += numItems;
+			return;
+		}
+
+		bx::memCopy(&matrixCache.m_cache[firstMatrix], _drawList.m_matrix, sizeof(Matrix4)*numMatrices);
+		bx::memCopy(&rectCache.m_cache[firstRect], _drawList.m_rect, sizeof(Rect)*numRects);
+
+		// Uniforms are appended, uniforms set for next draw call are moved
+		// after them.
+		const uint32_t uniformSize = _drawList.m_uniformSize;
+		const uint32_t pendingSize = m_frame->m_uniformBuffer[m_uniformIdx]->getPos() - m_uniformBegin;
+		UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx], uniformSize + pendingSize, uniformSize + pendingSize);
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		const uint32_t pendingBegin = m_uniformBegin;
+		const uint32_t uniformBase  = uniformBuffer->getPos();
+		uniformBuffer->write(_drawList.m_uniform, uniformSize);
+
+		if (0 != pendingSize)
+		{
+			const uint32_t pos = uniformBuffer->getPos();
+			uniformBuffer->reset(pendingBegin);
+			const char* pending = uniformBuffer->read(pendingSize);
+			uniformBuffer->reset(pos);
+			uniformBuffer->write(pending, pendingSize);
+		}
+
+		m_uniformEnd   = uniformBase + uniformSize;
+		m_uniformBegin = m_uniformEnd;
+
+		const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+		const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, numItems, maxDrawCalls);
+		const uint32_t num   = bx::min(numItems, maxDrawCalls - bx::min(first, maxDrawCalls) );
+
+		m_numSubmitted += num;
+		m_numDropped   += numItems - num;
+
+		SortKey::Enum type = SortKey::SortProgram;
+		uint32_t seq = 0;
+		switch (s_ctx->m_view[_id].m_mode)
+		{
+		case ViewMode::Sequential:      seq = s_ctx->getSeqIncr(_id, num); type = SortKey::SortSequence; break;
+		case ViewMode::DepthAscending:                                      type = SortKey::SortDepth;    break;
+		case ViewMode::DepthDescending:                                     type = SortKey::SortDepth;    break;
+		default: break;
+		}
+
+		SortKey key;
+		key.m_view = _id;
+
+		SortKeyBuffer& sortKeyBuffer = m_frame->m_sortKeyBuffer[m_uniformIdx];
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			const DrawList::Item& item = _drawList.m_item[ii];
+			const uint32_t renderItemIdx = first + ii;
+
+			RenderDraw& draw = m_frame->m_renderItem[renderItemIdx].draw;
+			draw = item.m_draw;
+			draw.m_uniformIdx    = m_uniformIdx;
+			draw.m_uniformBegin += uniformBase;
+			draw.m_uniformEnd   += uniformBase;
+
+			if (0 != draw.m_startMatrix)
+			{
+				draw.m_startMatrix += firstMatrix - 1;
+			}
+
+			if (UINT16_MAX != draw.m_scissor)
+			{
+				draw.m_scissor = uint16_t(draw.m_scissor + firstRect);
+			}
+
+			m_frame->m_renderItemBind[renderItemIdx] = item.m_bind;
+
+			const uint32_t depth = item.m_depth + _depth;
+			key.m_program = item.m_program;
+			key.m_blend   = item.m_blend;
+			key.m_seq     = seq + ii;
+			key.m_depth   = ViewMode::DepthDescending == s_ctx->m_view[_id].m_mode
+				? UINT32_MAX-depth
+				: depth
+				;
+
+			sortKeyBuffer.add(key.encodeDraw(type), RenderItemCount(renderItemIdx) );
+		}
+	}
+
+	TransientIndexBuffer* EncoderImpl::getTransientIndexBufferPage(uint32_t _page)
+	{
+		if (_page >= Frame::getTransientMaxPages(g_caps.limits.transientIbSize) )
+		{
+			return NULL;
+		}
+
+		TransientIndexBuffer* tib = *(TransientIndexBuffer* volatile*)&m_frame->m_transientIb[_page];
+
+		if (NULL == tib)
+		{
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			tib = s_ctx->getTransientIndexBufferPage(m_frame, _page);
+		}
+
+		return tib;
+	}
+
+	TransientVertexBuffer* EncoderImpl::getTransientVertexBufferPage(uint32_t _page)
+	{
+		if (_page >= Frame::getTransientMaxPages(g_caps.limits.transientVbSize) )
+		{
+			return NULL;
+		}
+
+		TransientVertexBuffer* tvb = *(TransientVertexBuffer* volatile*)&m_frame->m_transientVb[_page];
+
+		if (NULL == tvb)
+		{
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			tvb = s_ctx->getTransientVertexBufferPage(m_frame, _page);
+		}
+
+		return tvb;
+	}
+
+	void EncoderImpl::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
+	{
+		const bool isIndex16     = !_index32;
+		const uint16_t indexSize = isIndex16 ? 2 : 4;
+		const uint32_t pageSize  = g_caps.limits.transientIbSize;
+		const uint32_t offset    = allocTransient(
+			  m_transientIbNext
+			, m_transientIbEnd
+			, &m_frame->m_iboffset
+			, pageSize
+			, _num
+			, indexSize
+			);
+		uint32_t local = offset % pageSize;
+
+		TransientIndexBuffer* tib = getTransientIndexBufferPage(offset/pageSize);
+		if (NULL == tib)
+		{
+			tib   = m_frame->m_transientIb[0];
+			local = 0;
+			_num  = 0;
+		}
+
+		_tib->data       = &tib->data[local];
+		_tib->size       = _num * indexSize;
+		_tib->handle     = tib->handle;
+		_tib->startIndex = local / indexSize;
+		_tib->isIndex16  = isIndex16;
+	}
+
+	void EncoderImpl::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout)
+	{
+		if (m_transientLayoutHash != _layout.m_hash)
+		{
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			m_transientLayout     = s_ctx->findTransientVertexLayout(_layout);
+			m_transientLayoutHash = _layout.m_hash;
+		}
+
+		const uint32_t pageSize = g_caps.limits.transientVbSize;
+		const uint32_t offset   = allocTransient(
+			  m_transientVbNext
+			, m_transientVbEnd
+			, &m_frame->m_vboffset
+			, pageSize
+			, _num
+			, _layout.m_stride
+			);
+		uint32_t local = offset % pageSize;
+
+		TransientVertexBuffer* dvb = getTransientVertexBufferPage(offset/pageSize);
+		if (NULL == dvb)
+		{
+			dvb   = m_frame->m_transientVb[0];
+			local = 0;
+			_num  = 0;
+		}
+
+		_tvb->data         = &dvb->data[local];
+		_tvb->size         = _num * _layout.m_stride;
+		_tvb->startVertex  = local/_layout.m_stride;
+		_tvb->stride       = _layout.m_stride;
+		_tvb->handle       = dvb->handle;
+		_tvb->layoutHandle = m_transientLayout;
+	}
+
+	void EncoderImpl::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		const uint16_t stride   = bx::alignUp(_stride, 16);
+		const uint32_t pageSize = g_caps.limits.transientVbSize;
+		const uint32_t offset   = allocTransient(
+			  m_transientVbNext
+			, m_transientVbEnd
+			, &m_frame->m_vboffset
+			, pageSize
+			, _num
+			, stride
+			);
+		uint32_t local = offset % pageSize;
+
+		TransientVertexBuffer* dvb = getTransientVertexBufferPage(offset/pageSize);
+		if (NULL == dvb)
+		{
+			dvb   = m_frame->m_transientVb[0];
+			local = 0;
+			_num  = 0;
+		}
+
+		_idb->data   = &dvb->data[local];
+		_idb->size   = _num * stride;
+		_idb->offset = local;
+		_idb->num    = _num;
+		_idb->stride = stride;
+		_idb->handle = dvb->handle;
+	}
+
 	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ, uint8_t _flags)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
@@ -1329,8 +1820,8 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard(_flags);
 			++m_numDropped;
@@ -1354,8 +1845,7 @@ namespace bgfx
 		m_key.m_seq     = s_ctx->getSeqIncr(_id);
 
 		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		m_frame->m_sortKeyBuffer[m_uniformIdx].add(key, RenderItemCount(renderItemIdx) );
 
 		m_compute.m_uniformIdx   = m_uniformIdx;
 		m_compute.m_uniformBegin = m_uniformBegin;
@@ -1365,6 +1855,7 @@ namespace bgfx
 
 		m_compute.clear(_flags);
 		m_bind.clear(_flags);
+		m_dynamic.clear(_flags);
 		m_uniformBegin = m_uniformEnd;
 	}
 
@@ -1400,31 +1891,686 @@ namespace bgfx
 		}
 	}
 
-	void Frame::sort()
+	JobPool::JobPool()
+		: m_fn(NULL)
+		, m_userData(NULL)
+		, m_num(0)
+		, m_next(0)
+		, m_numThreads(0)
+		, m_exit(false)
 	{
-		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+	}
 
-		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+	void JobPool::init(uint32_t _numThreads)
+	{
+		m_exit = false;
+
+#if BGFX_CONFIG_MULTITHREADED
+		m_numThreads = bx::min<uint32_t>(_numThreads, BGFX_CONFIG_MAX_WORKER_THREADS);
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
 		{
-			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+			m_thread[ii].init(workerThread, this, 0, "bgfx - worker thread");
+		}
+#else
+		BX_UNUSED(_numThreads);
+		m_numThreads = 0;
+#endif // BGFX_CONFIG_MULTITHREADED
 
-			View& view = m_view[ii];
-			Rect rect(0, 0, uint16_t(m_resolution.width), uint16_t(m_resolution.height) );
+		BX_TRACE("Job pool worker threads: %d", m_numThreads);
+	}
 
-			if (isValid(view.m_fbh) )
-			{
-				const FrameBufferRef& fbr = s_ctx->m_frameBufferRef[view.m_fbh.idx];
-				const BackbufferRatio::Enum bbRatio = fbr.m_window
-					? BackbufferRatio::Count
-					: BackbufferRatio::Enum(s_ctx->m_textureRef[fbr.un.m_th[0].idx].m_bbRatio)
-					;
+	void JobPool::shutdown()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		m_exit = true;
+		m_kick.post(m_numThreads);
 
-				if (BackbufferRatio::Count != bbRatio)
-				{
-					getTextureSizeFromRatio(bbRatio, rect.m_width, rect.m_height);
-				}
-				else
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_numThreads = 0;
+	}
+
+	void JobPool::execute()
+	{
+		for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			; idx < m_num
+			; idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			)
+		{
+			m_fn(m_userData, idx);
+		}
+	}
+
+	void JobPool::parallelFor(JobFn _fn, void* _userData, uint32_t _num)
+	{
+		if (0 == m_numThreads
+		||  2 > _num)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_fn(_userData, ii);
+			}
+
+			return;
+		}
+
+#if BGFX_CONFIG_MULTITHREADED
+		bx::MutexScope lock(m_lock);
+
+		m_fn       = _fn;
+		m_userData = _userData;
+		m_num      = _num;
+		m_next     = 0;
+
+		const uint32_t numWorkers = bx::min(m_numThreads, _num-1);
+		m_kick.post(numWorkers);
+
+		execute();
+
+		for (uint32_t ii = 0; ii < numWorkers; ++ii)
+		{
+			m_done.wait();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+#if BGFX_CONFIG_MULTITHREADED
+	int32_t JobPool::workerThread(bx::Thread* /*_self*/, void* _userData)
+	{
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Worker Thread");
+
+		JobPool* pool = static_cast<JobPool*>(_userData);
+
+		for (;;)
+		{
+			pool->m_kick.wait();
+
+			if (pool->m_exit)
+			{
+				break;
+			}
+
+			pool->execute();
+			pool->m_done.post();
+		}
+
+		return bx::kExitSuccess;
+	}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	// Releases texture creation memory, including data referenced by
+	// BGFX_CHUNK_MAGIC_TEX chunk.
+	static void releaseTextureMemory(const Memory* _mem)
+	{
+		bx::MemoryReader reader(_mem->data, _mem->size);
+
+		uint32_t magic;
+		bx::read(&reader, magic);
+
+		if (BGFX_CHUNK_MAGIC_TEX == magic)
+		{
+			TextureCreate tc;
+			bx::read(&reader, tc);
+
+			if (NULL != tc.m_mem)
+			{
+				release(tc.m_mem);
+			}
+		}
+
+		release(_mem);
+	}
+
+	// Decodes texture in format renderer can't sample natively to RGBA8, so
+	// that renderer doesn't have to decode it on render thread. Returns _mem
+	// when texture doesn't need decoding.
+	static const Memory* decodeTexture(const Memory* _mem, bool& _decoded)
+	{
+		_decoded = false;
+
+		bimg::ImageContainer imageContainer;
+		if (!bimg::imageParse(imageContainer, _mem->data, _mem->size)
+		||  NULL == imageContainer.m_data)
+		{
+			return _mem;
+		}
+
+		const bimg::TextureFormat::Enum format = imageContainer.m_format;
+		const uint32_t native = imageContainer.m_cubeMap
+			? BGFX_CAPS_FORMAT_TEXTURE_CUBE
+			: BGFX_CAPS_FORMAT_TEXTURE_2D
+			;
+
+		if (1 < imageContainer.m_depth
+		||  bimg::TextureFormat::RGBA8 == format
+		||  bimg::isDepth(format)
+		||  0 != (g_caps.formats[format] & native)
+		||  !bimg::imageConvert(bimg::TextureFormat::RGBA8, format) )
+		{
+			return _mem;
+		}
+
+		const uint16_t numSides = imageContainer.m_numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+		const uint8_t  numMips  = imageContainer.m_numMips;
+
+		uint32_t sideSize = 0;
+		for (uint8_t lod = 0; lod < numMips; ++lod)
+		{
+			const uint32_t width  = bx::max<uint32_t>(1, imageContainer.m_width  >> lod);
+			const uint32_t height = bx::max<uint32_t>(1, imageContainer.m_height >> lod);
+			sideSize += width*height*4;
+		}
+
+		const Memory* data = alloc(sideSize*numSides);
+		uint8_t* dst = data->data;
+
+		// Compressed mips are decoded in whole blocks, temp is cropped to mip size.
+		uint8_t* temp     = NULL;
+		uint32_t tempSize = 0;
+
+		for (uint16_t side = 0; side < numSides; ++side)
+		{
+			for (uint8_t lod = 0; lod < numMips; ++lod)
+			{
+				const uint32_t width  = bx::max<uint32_t>(1, imageContainer.m_width  >> lod);
+				const uint32_t height = bx::max<uint32_t>(1, imageContainer.m_height >> lod);
+				const uint32_t pitch  = width*4;
+
+				bimg::ImageMip mip;
+				if (bimg::imageGetRawData(imageContainer, side, lod, _mem->data, _mem->size, mip) )
+				{
+					const uint32_t srcPitch = mip.m_width*4;
+					const uint32_t size     = srcPitch*mip.m_height;
+
+					if (size > tempSize)
+					{
+						temp     = (uint8_t*)BX_REALLOC(g_allocator, temp, size);
+						tempSize = size;
+					}
+
+					bimg::imageDecodeToRgba8(g_allocator, temp, mip.m_data, mip.m_width, mip.m_height, srcPitch, mip.m_format);
+
+					for (uint32_t yy = 0, num = bx::min(height, mip.m_height); yy < num; ++yy)
+					{
+						bx::memCopy(&dst[yy*pitch], &temp[yy*srcPitch], bx::min(pitch, srcPitch) );
+					}
+				}
+
+				dst += pitch*height;
+			}
+		}
+
+		BX_FREE(g_allocator, temp);
+
+		const Memory* mem = alloc(sizeof(uint32_t)+sizeof(TextureCreate) );
+
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
+
+		TextureCreate tc;
+		tc.m_width     = uint16_t(imageContainer.m_width);
+		tc.m_height    = uint16_t(imageContainer.m_height);
+		tc.m_depth     = 0;
+		tc.m_numLayers = imageContainer.m_numLayers;
+		tc.m_numMips   = numMips;
+		tc.m_format    = TextureFormat::RGBA8;
+		tc.m_cubeMap   = imageContainer.m_cubeMap;
+		tc.m_mem       = data;
+		bx::write(&writer, tc);
+
+		BX_TRACE("Texture decoded from %s to RGBA8 on loader thread."
+			, bimg::getName(format)
+			);
+
+		releaseTextureMemory(_mem);
+
+		_decoded = true;
+		return mem;
+	}
+
+	struct ImageDecodeJob
+	{
+		ImageDecodeMip* mips;
+		const bimg::ImageContainer* imageContainer;
+		const Memory* mem;
+		bimg::TextureFormat::Enum dstFormat;
+		uint8_t startLod;
+		uint8_t numMips;
+	};
+
+	static void imageDecodeMip(void* _userData, uint32_t _idx)
+	{
+		const ImageDecodeJob& job = *static_cast<const ImageDecodeJob*>(_userData);
+		const ImageDecodeMip& dm  = job.mips[_idx];
+
+		if (NULL == dm.data)
+		{
+			return;
+		}
+
+		const uint16_t side = uint16_t(_idx / job.numMips);
+		const uint8_t  lod  = uint8_t(_idx % job.numMips);
+
+		bimg::ImageMip mip;
+		bimg::imageGetRawData(*job.imageContainer, side, lod + job.startLod, job.mem->data, job.mem->size, mip);
+
+		if (bimg::TextureFormat::RGBA8 == job.dstFormat)
+		{
+			bimg::imageDecodeToRgba8(g_allocator, dm.data, mip.m_data, mip.m_width, mip.m_height, dm.pitch, mip.m_format);
+		}
+		else
+		{
+			bimg::imageDecodeToBgra8(g_allocator, dm.data, mip.m_data, mip.m_width, mip.m_height, dm.pitch, mip.m_format);
+		}
+	}
+
+	uint8_t* imageDecodeParallel(
+		  ImageDecodeMip* _mips
+		, const bimg::ImageContainer& _imageContainer
+		, const Memory* _mem
+		, uint16_t _numSides
+		, uint8_t _startLod
+		, uint8_t _numMips
+		, bimg::TextureFormat::Enum _dstFormat
+		)
+	{
+		BX_ASSERT(bimg::TextureFormat::RGBA8 == _dstFormat || bimg::TextureFormat::BGRA8 == _dstFormat
+			, "Texture can be decoded only to RGBA8 or BGRA8."
+			);
+
+		const uint32_t num = _numSides*_numMips;
+
+		uint32_t total = 0;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			ImageDecodeMip& dm = _mips[ii];
+			bx::memSet(&dm, 0, sizeof(ImageDecodeMip) );
+
+			bimg::ImageMip mip;
+			if (bimg::imageGetRawData(_imageContainer, uint16_t(ii / _numMips), uint8_t(ii % _numMips) + _startLod, _mem->data, _mem->size, mip) )
+			{
+				dm.width  = mip.m_width;
+				dm.height = mip.m_height;
+				dm.depth  = mip.m_depth;
+				dm.pitch  = mip.m_width*4;
+				dm.size   = dm.pitch*mip.m_height*bx::max<uint32_t>(mip.m_depth, 1);
+				total += dm.size;
+			}
+		}
+
+		uint8_t* data = (uint8_t*)BX_ALLOC(g_allocator, bx::max<uint32_t>(total, 1) );
+
+		for (uint32_t ii = 0, offset = 0; ii < num; ++ii)
+		{
+			ImageDecodeMip& dm = _mips[ii];
+			if (0 != dm.size)
+			{
+				dm.data = &data[offset];
+				offset += dm.size;
+			}
+		}
+
+#if BGFX_CONFIG_TEXTURE_DECODE_CACHE
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(_mem->data, _mem->size);
+		murmur.add(_startLod);
+		murmur.add(_numMips);
+		murmur.add(_numSides);
+		murmur.add(_dstFormat);
+		const uint64_t id = (uint64_t(murmur.end() ) << 32) | total;
+
+		if (total == g_callback->cacheReadSize(id)
+		&&  g_callback->cacheRead(id, data, total) )
+		{
+			return data;
+		}
+#endif // BGFX_CONFIG_TEXTURE_DECODE_CACHE
+
+		BGFX_PROFILER_SCOPE("bgfx/Decode texture", 0xff2040ff);
+
+		ImageDecodeJob job;
+		job.mips           = _mips;
+		job.imageContainer = &_imageContainer;
+		job.mem            = _mem;
+		job.dstFormat      = _dstFormat;
+		job.startLod       = _startLod;
+		job.numMips        = _numMips;
+		getJobPool().parallelFor(imageDecodeMip, &job, num);
+
+#if BGFX_CONFIG_TEXTURE_DECODE_CACHE
+		g_callback->cacheWrite(id, data, total);
+#endif // BGFX_CONFIG_TEXTURE_DECODE_CACHE
+
+		return data;
+	}
+
+	ResourceLoader::ResourceLoader()
+		: m_read(0)
+		, m_write(0)
+		, m_numThreads(0)
+		, m_exit(false)
+	{
+	}
+
+	void ResourceLoader::init(uint32_t _numThreads)
+	{
+		m_exit  = false;
+		m_read  = 0;
+		m_write = 0;
+		m_requestHandle.reset();
+
+#if BGFX_CONFIG_MULTITHREADED
+		m_numThreads = bx::min<uint32_t>(_numThreads, BGFX_CONFIG_MAX_LOADER_THREADS);
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].init(loaderThread, this, 0, "bgfx - loader thread");
+		}
+#else
+		BX_UNUSED(_numThreads);
+		m_numThreads = 0;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		BX_TRACE("Resource loader threads: %d", m_numThreads);
+	}
+
+	void ResourceLoader::shutdown()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		{
+			bx::MutexScope lock(m_lock);
+			m_exit = true;
+		}
+
+		m_kick.post(m_numThreads);
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		// Requests that never reached loader thread.
+		for (; m_read != m_write; ++m_read)
+		{
+			const uint16_t idx = m_queue[m_read % BX_COUNTOF(m_queue)];
+			releaseTextureMemory(m_request[idx].m_mem);
+			m_requestHandle.free(idx);
+		}
+
+		m_numThreads = 0;
+	}
+
+	uint16_t ResourceLoader::createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip)
+	{
+		const uint16_t idx = m_requestHandle.alloc();
+		BX_ASSERT(UINT16_MAX != idx, "Too many pending texture loads.");
+
+		Request& req = m_request[idx];
+		req.m_mem      = _mem;
+		req.m_flags    = _flags;
+		req.m_handle   = _handle;
+		req.m_skip     = _skip;
+		req.m_decoded  = false;
+		req.m_canceled = false;
+
+		if (0 == m_numThreads)
+		{
+			process(idx);
+			complete(idx);
+			return UINT16_MAX;
+		}
+
+#if BGFX_CONFIG_MULTITHREADED
+		{
+			bx::MutexScope lock(m_lock);
+			m_queue[m_write % BX_COUNTOF(m_queue)] = idx;
+			++m_write;
+		}
+
+		m_kick.post();
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return idx;
+	}
+
+	void ResourceLoader::cancel(uint16_t _idx)
+	{
+		m_request[_idx].m_canceled = true;
+	}
+
+	void ResourceLoader::process(uint16_t _idx)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Load texture", 0xff2040ff);
+
+		Request& req = m_request[_idx];
+		req.m_mem = decodeTexture(req.m_mem, req.m_decoded);
+	}
+
+	void ResourceLoader::complete(uint16_t _idx)
+	{
+		const Request& req = m_request[_idx];
+
+		if (req.m_canceled)
+		{
+			releaseTextureMemory(req.m_mem);
+		}
+		else
+		{
+			s_ctx->textureLoaded(req.m_handle, req.m_mem, req.m_flags, req.m_skip, req.m_decoded);
+		}
+
+		m_requestHandle.free(_idx);
+	}
+
+#if BGFX_CONFIG_MULTITHREADED
+	int32_t ResourceLoader::loaderThread(bx::Thread* /*_self*/, void* _userData)
+	{
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Loader Thread");
+
+		ResourceLoader* loader = static_cast<ResourceLoader*>(_userData);
+
+		for (;;)
+		{
+			loader->m_kick.wait();
+
+			uint16_t idx;
+			{
+				bx::MutexScope lock(loader->m_lock);
+
+				if (loader->m_exit)
+				{
+					break;
+				}
+
+				BX_ASSERT(loader->m_read != loader->m_write, "Loader kicked with empty queue.");
+				idx = loader->m_queue[loader->m_read % BX_COUNTOF(loader->m_queue)];
+				++loader->m_read;
+			}
+
+			loader->process(idx);
+
+			// Canceled flag and request handles are owned by resource API lock.
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			loader->complete(idx);
+		}
+
+		return bx::kExitSuccess;
+	}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+	void SortKeyBuffer::grow()
+	{
+		const uint32_t max = bx::min<uint32_t>(bx::max(m_max*2, kSortKeyBufferMinCapacity), g_caps.limits.maxDrawCalls);
+		BX_ASSERT(max > m_max, "Sort key buffer overflow (max: %d).", g_caps.limits.maxDrawCalls);
+
+		m_keys       = (uint64_t*       )BX_REALLOC(g_allocator, m_keys,       max*sizeof(uint64_t) );
+		m_tempKeys   = (uint64_t*       )BX_REALLOC(g_allocator, m_tempKeys,   max*sizeof(uint64_t) );
+		m_values     = (RenderItemCount*)BX_REALLOC(g_allocator, m_values,     max*sizeof(RenderItemCount) );
+		m_tempValues = (RenderItemCount*)BX_REALLOC(g_allocator, m_tempValues, max*sizeof(RenderItemCount) );
+		m_max        = max;
+	}
+
+	void SortKeyBuffer::sort()
+	{
+		const uint32_t numSorted = m_numSorted;
+		const uint32_t num       = m_num;
+
+		if (numSorted == num)
+		{
+			return;
+		}
+
+		bx::radixSort(
+			  &m_keys[numSorted]
+			, &m_tempKeys[numSorted]
+			, &m_values[numSorted]
+			, &m_tempValues[numSorted]
+			, num - numSorted
+			);
+
+		if (0 != numSorted
+		&&  m_keys[numSorted-1] > m_keys[numSorted])
+		{
+			// Encoder was used more than once this frame, merge with previous keys.
+			uint32_t ii = 0;
+			uint32_t jj = numSorted;
+			uint32_t kk = 0;
+
+			while (ii < numSorted
+			&&     jj < num)
+			{
+				const uint32_t src = m_keys[jj] < m_keys[ii] ? jj++ : ii++;
+				m_tempKeys[kk]   = m_keys[src];
+				m_tempValues[kk] = m_values[src];
+				++kk;
+			}
+
+			for (; ii < numSorted; ++ii, ++kk)
+			{
+				m_tempKeys[kk]   = m_keys[ii];
+				m_tempValues[kk] = m_values[ii];
+			}
+
+			for (; jj < num; ++jj, ++kk)
+			{
+				m_tempKeys[kk]   = m_keys[jj];
+				m_tempValues[kk] = m_values[jj];
+			}
+
+			bx::swap(m_keys,   m_tempKeys);
+			bx::swap(m_values, m_tempValues);
+		}
+
+		m_numSorted = num;
+	}
+
+	struct SortMergeJob
+	{
+		const SortKeyBuffer* buffer[kMaxEncoders];
+		const uint32_t*      bound[kMaxEncoders];
+		uint32_t             numBuffers;
+
+		uint64_t*        keys;
+		RenderItemCount* values;
+		const ViewId*    viewRemap;
+		uint32_t         offset[BGFX_CONFIG_MAX_VIEWS+1];
+		ViewId           view[BGFX_CONFIG_MAX_VIEWS];
+	};
+
+	static void sortMergeView(void* _userData, uint32_t _idx)
+	{
+		const SortMergeJob& job = *static_cast<const SortMergeJob*>(_userData);
+
+		const ViewId   view    = job.view[_idx];
+		const ViewId   srcView = job.viewRemap[view];
+		const uint64_t viewBits = uint64_t(view) << kSortKeyViewBitShift;
+
+		uint32_t cursor[kMaxEncoders];
+		uint32_t end[kMaxEncoders];
+		const SortKeyBuffer* buffer[kMaxEncoders];
+		uint32_t num = 0;
+
+		for (uint32_t ii = 0; ii < job.numBuffers; ++ii)
+		{
+			const uint32_t first = job.bound[ii][srcView];
+			const uint32_t last  = job.bound[ii][srcView+1];
+
+			if (first != last)
+			{
+				cursor[num] = first;
+				end[num]    = last;
+				buffer[num] = job.buffer[ii];
+				++num;
+			}
+		}
+
+		// All keys in this range share the same view bits, comparing keys
+		// directly is the same as comparing remapped keys.
+		uint32_t out = job.offset[view];
+
+		while (0 < num)
+		{
+			uint32_t minIdx = 0;
+			uint64_t minKey = buffer[0]->m_keys[cursor[0] ];
+
+			for (uint32_t ii = 1; ii < num; ++ii)
+			{
+				const uint64_t key = buffer[ii]->m_keys[cursor[ii] ];
+				if (key < minKey)
+				{
+					minIdx = ii;
+					minKey = key;
+				}
+			}
+
+			const SortKeyBuffer& src = *buffer[minIdx];
+			job.keys[out]   = (minKey & ~kSortKeyViewMask) | viewBits;
+			job.values[out] = src.m_values[cursor[minIdx] ];
+			++out;
+
+			if (++cursor[minIdx] == end[minIdx])
+			{
+				--num;
+				cursor[minIdx] = cursor[num];
+				end[minIdx]    = end[num];
+				buffer[minIdx] = buffer[num];
+			}
+		}
+	}
+
+	void Frame::sort()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+
+		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+
+			View& view = m_view[ii];
+			Rect rect(0, 0, uint16_t(m_resolution.width), uint16_t(m_resolution.height) );
+
+			if (isValid(view.m_fbh) )
+			{
+				const FrameBufferRef& fbr = s_ctx->m_frameBufferRef[view.m_fbh.idx];
+				const BackbufferRatio::Enum bbRatio = fbr.m_window
+					? BackbufferRatio::Count
+					: BackbufferRatio::Enum(s_ctx->m_textureRef[fbr.un.m_th[0].idx].m_bbRatio)
+					;
+
+				if (BackbufferRatio::Count != bbRatio)
+				{
+					getTextureSizeFromRatio(bbRatio, rect.m_width, rect.m_height);
+				}
+				else
 				{
 					rect.m_width  = fbr.m_width;
 					rect.m_height = fbr.m_height;
@@ -1439,19 +2585,120 @@ namespace bgfx
 			}
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		// Encoders already sorted their keys, only merge them per view.
+		SortMergeJob job;
+		job.numBuffers = 0;
+		job.keys       = m_sortKeys;
+		job.values     = m_sortValues;
+		job.viewRemap  = m_viewRemap;
+
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			const SortKeyBuffer& buffer = m_sortKeyBuffer[ii];
+
+			if (0 != buffer.m_numSorted)
+			{
+				BX_ASSERT(buffer.m_num == buffer.m_numSorted, "Encoder %d didn't sort its keys.", ii);
+
+				uint32_t* bound = &m_sortKeyBound[job.numBuffers*(BGFX_CONFIG_MAX_VIEWS+1)];
+				for (uint32_t view = 0; view < BGFX_CONFIG_MAX_VIEWS; ++view)
+				{
+					bound[view] = buffer.lowerBound(uint64_t(view) << kSortKeyViewBitShift);
+				}
+				bound[BGFX_CONFIG_MAX_VIEWS] = buffer.m_numSorted;
+
+				job.buffer[job.numBuffers] = &buffer;
+				job.bound[job.numBuffers]  = bound;
+				++job.numBuffers;
+			}
 		}
 
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+		uint32_t count[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t numViews = 0;
+
+		job.offset[0] = 0;
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			const ViewId srcView = m_viewRemap[ii];
+
+			count[ii] = 0;
+			for (uint32_t jj = 0; jj < job.numBuffers; ++jj)
+			{
+				count[ii] += job.bound[jj][srcView+1] - job.bound[jj][srcView];
+			}
+
+			job.offset[ii+1] = job.offset[ii] + count[ii];
+
+			if (0 != count[ii])
+			{
+				// Largest views first, so that workers finish at about the same time.
+				uint32_t pos = numViews++;
+				for (; 0 < pos && count[job.view[pos-1] ] < count[ii]; --pos)
+				{
+					job.view[pos] = job.view[pos-1];
+				}
+
+				job.view[pos] = ViewId(ii);
+			}
+		}
+
+		m_numRenderItems = job.offset[BGFX_CONFIG_MAX_VIEWS];
+		bx::memCopy(m_viewOffset, job.offset, sizeof(m_viewOffset) );
+
+		if (0 != BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS
+		&&  BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS <= m_numRenderItems)
+		{
+			s_ctx->m_jobPool.parallelFor(sortMergeView, &job, numViews);
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < numViews; ++ii)
+			{
+				sortMergeView(&job, ii);
+			}
+		}
 
 		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
 		{
 			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
 		}
 
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+		bx::radixSort(m_blitKeys, s_ctx->m_tempBlitKeys, m_numBlitItems);
+	}
+
+	uint32_t Frame::getViewBatches(ViewBatch* _outBatch, uint32_t _maxBatches, uint32_t _minItems) const
+	{
+		BX_ASSERT(0 < _maxBatches, "At least one batch is required.");
+
+		const uint32_t numItems = m_numRenderItems;
+		const uint32_t perBatch = bx::max<uint32_t>(bx::max(_minItems, (numItems + _maxBatches - 1) / _maxBatches), 1);
+
+		uint32_t num = 0;
+		ViewBatch* batch = &_outBatch[0];
+		batch->m_begin     = 0;
+		batch->m_viewBegin = 0;
+
+		for (uint32_t view = 0; view < BGFX_CONFIG_MAX_VIEWS-1; ++view)
+		{
+			const uint32_t end = m_viewOffset[view+1];
+
+			if (end - batch->m_begin >= perBatch
+			&&  end < numItems
+			&&  num+1 < _maxBatches)
+			{
+				batch->m_end     = end;
+				batch->m_viewEnd = uint16_t(view+1);
+
+				batch = &_outBatch[++num];
+				batch->m_begin     = end;
+				batch->m_viewBegin = uint16_t(view+1);
+			}
+		}
+
+		batch->m_end     = numItems;
+		batch->m_viewEnd = BGFX_CONFIG_MAX_VIEWS;
+
+		return num+1;
 	}
 
     // 在还没有创建Context实例初始化，就调用这个，会被认为是外部主动调用renderFrame (s_renderFrameCalled=true)
@@ -1497,31 +2744,102 @@ namespace bgfx
 				ctx->renderSemPost();
 			}
 
-			return result;
-		} // 如果没有配置多线程 那么不用调用这个方法 而是直接调用 bgfx::frame(); -- Context::swap(里面会调用 Context::renderFrame)
+			return result;
+		} // 如果没有配置多线程 那么不用调用这个方法 而是直接调用 bgfx::frame(); -- Context::swap(里面会调用 Context::renderFrame)
+
+		BX_ASSERT(false, "This call only makes sense if used with multi-threaded renderer.");
+		return RenderFrame::NoContext;
+	}
+
+	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
+	{
+		sizeof(int32_t), // Sampler     
+		0, // End
+		4*sizeof(float), // Vec4
+		3*3*sizeof(float), // Mat3
+		4*4*sizeof(float), // Mat4
+		1, // Count
+	};
+
+    // writeUniformHandle  copy=false    << RendderContextMtl::processArguments   _loc shader形参结构体中的偏移
+    // writeUniform         copy=true    << bgfx::setUniform  _loc UnformHandle 索引
+
+	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, true); // 需要copy ??
+		write(opcode);
+		write(_value, g_uniformTypeSize[_type]*_num); // 根据类型大小和数量 写入 UniformBuffer   UniformBuffer当前偏移是m_pos
+	}
+
+	void UniformBuffer::writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(_pos);
+	}
+
+	bool UniformBuffer::isUniformEqual(uint32_t _pos, UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num) const
+	{
+		uint32_t opcode;
+		bx::memCopy(&opcode, &m_buffer[_pos - sizeof(uint32_t)], sizeof(uint32_t) );
+
+		return opcode == encodeOpcode(_type, _loc, _num, true)
+			&& 0 == bx::memCmp(&m_buffer[_pos], _value, g_uniformTypeSize[_type]*_num)
+			;
+	}
+
+	uint32_t UniformBuffer::copyResolved(void* _dst, uint32_t _begin, uint32_t _end) const
+	{
+		uint8_t* dst = (uint8_t*)_dst;
+		uint32_t size = 0;
+
+		for (uint32_t pos = _begin; pos < _end;)
+		{
+			uint32_t opcode;
+			bx::memCopy(&opcode, &m_buffer[pos], sizeof(uint32_t) );
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			decodeOpcode(opcode, type, loc, num, copy);
+
+			const uint32_t dataSize = g_uniformTypeSize[type]*num;
+
+			if (UniformType::Count > type
+			&&  !copy)
+			{
+				uint32_t ref;
+				bx::memCopy(&ref, &m_buffer[pos + sizeof(uint32_t)], sizeof(uint32_t) );
+
+				if (NULL != dst)
+				{
+					opcode = encodeOpcode(type, loc, num, true);
+					bx::memCopy(&dst[size], &opcode, sizeof(uint32_t) );
+					bx::memCopy(&dst[size + sizeof(uint32_t)], &m_buffer[ref], dataSize);
+				}
 
-		BX_ASSERT(false, "This call only makes sense if used with multi-threaded renderer.");
-		return RenderFrame::NoContext;
-	}
+				pos += sizeof(uint32_t) + sizeof(uint32_t);
+			}
+			else
+			{
+				if (NULL != dst)
+				{
+					bx::memCopy(&dst[size], &m_buffer[pos], sizeof(uint32_t) + dataSize);
+				}
 
-	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
-	{
-		sizeof(int32_t), // Sampler     
-		0, // End
-		4*sizeof(float), // Vec4
-		3*3*sizeof(float), // Mat3
-		4*4*sizeof(float), // Mat4
-		1, // Count
-	};
+				pos += sizeof(uint32_t) + dataSize;
+			}
 
-    // writeUniformHandle  copy=false    << RendderContextMtl::processArguments   _loc shader形参结构体中的偏移
-    // writeUniform         copy=true    << bgfx::setUniform  _loc UnformHandle 索引
+			size += sizeof(uint32_t) + dataSize;
+		}
 
-	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
-	{
-		uint32_t opcode = encodeOpcode(_type, _loc, _num, true); // 需要copy ??
-		write(opcode);
-		write(_value, g_uniformTypeSize[_type]*_num); // 根据类型大小和数量 写入 UniformBuffer   UniformBuffer当前偏移是m_pos
+		return size;
 	}
 
     // 没有 read UniformHandle  //  void RenderContext::commit(UniformBuffer& _uniformBuffer)
@@ -1881,12 +3199,20 @@ namespace bgfx
 	{
 		BX_ASSERT(!m_rendererInitialized, "Already initialized?");
 
+#if BGFX_CONFIG_TRACE_RECORDER
+		g_traceRecorder = traceRecorderCreate(BGFX_CONFIG_TRACE_RECORDER_MAX_EVENTS);
+		traceSetThreadName(g_traceRecorder, bx::getTid(), "bgfx API thread");
+#endif // BGFX_CONFIG_TRACE_RECORDER
+
 		m_init = _init;
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
 		m_init.resolution.numBackBuffers  = bx::clamp<uint8_t>(_init.resolution.numBackBuffers, 2, BGFX_CONFIG_MAX_BACK_BUFFERS);
 		m_init.resolution.maxFrameLatency = bx::min<uint8_t>(_init.resolution.maxFrameLatency, BGFX_CONFIG_MAX_FRAME_LATENCY);
 		dump(m_init.resolution);
 
+		m_transientVbPages.reset();
+		m_transientIbPages.reset();
+
 		if (g_platformData.ndt          == NULL
 		&&  g_platformData.nwh          == NULL
 		&&  g_platformData.context      == NULL
@@ -1919,11 +3245,31 @@ namespace bgfx
 		m_debug   = BGFX_DEBUG_NONE;
 		m_frameTimeLast = bx::getHPCounter();
 
-		m_submit->create(_init.limits.minResourceCbSize);
+		m_numFrames = _init.limits.numFrames;
 
 #if BGFX_CONFIG_MULTITHREADED
-		m_render->create(_init.limits.minResourceCbSize);
+		if (s_renderFrameCalled
+		&&  ~BGFX_API_THREAD_MAGIC == s_threadIndex)
+		{
+			// Frame is rendered immediately on swap, ring deeper than double
+			// buffer only wastes memory.
+			m_numFrames = 2;
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		// Render thread advances to next frame before rendering, so it starts
+		// one frame behind first submitted one.
+		m_render = &m_frame[0];
+		m_submit = getNextFrame(m_render);
+
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			m_frame[ii].create(_init.limits.minResourceCbSize);
+		}
 
+		bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
+
+#if BGFX_CONFIG_MULTITHREADED
 		if (s_renderFrameCalled) // true
 		{
 			// When bgfx::renderFrame is called before init render thread
@@ -1973,12 +3319,19 @@ namespace bgfx
 
 		m_vertexLayoutRef.init();
 
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_drawList); ++ii)
+		{
+			m_drawList[ii].create();
+		}
+
+		bx::memSet(m_handleGen, 0, sizeof(m_handleGen) );
+
 		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
 		cmdbuf.write(_init);
 
 		frameNoRenderWait(); // --> swap(); apiSemPost();
 
-		m_encoderHandle = bx::createHandleAlloc(g_allocator, _init.limits.maxEncoders); // 8
+		m_encoderPool   = 0;
 		m_encoder       = (EncoderImpl*)BX_ALIGNED_ALLOC(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders, BX_ALIGNOF(EncoderImpl) );
 		m_encoderStats  = (EncoderStats*)BX_ALLOC(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
 		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
@@ -1986,8 +3339,7 @@ namespace bgfx
 			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
 		}
 
-		uint16_t idx = m_encoderHandle->alloc();
-		BX_ASSERT(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
+		m_encoderPool = 1; // Internal encoder 0 is always allocated.
 		m_encoder[0].begin(m_submit, 0); // frame() 中会把 encoder0.end()
 		m_encoder0 = BX_ENABLED(BGFX_CONFIG_ENCODER_API_ONLY)
 			? NULL
@@ -2009,13 +3361,26 @@ namespace bgfx
 			frame();
 			frame();
 			m_vertexLayoutRef.shutdown(m_layoutHandle);
-			m_submit->destroy();
-#if BGFX_CONFIG_MULTITHREADED
-			m_render->destroy();
-#endif // BGFX_CONFIG_MULTITHREADED
+
+			for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+			{
+				m_frame[ii].destroy();
+			}
+
 			return false;
 		}
 
+		// Up to this point API thread waited for each frame to be rendered
+		// before submitting next, same as with double buffering. Remaining
+		// frames in ring let API thread run ahead of render thread.
+		for (uint32_t ii = 2; ii < m_numFrames; ++ii)
+		{
+			renderSemPost();
+		}
+
+		m_jobPool.init(BGFX_CONFIG_MAX_WORKER_THREADS);
+		m_resourceLoader.init(BGFX_CONFIG_MAX_LOADER_THREADS);
+
 		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
 		{
 			const uint32_t fmt = s_emulatedFormats[ii];
@@ -2033,6 +3398,7 @@ namespace bgfx
 		}
 
 		g_caps.rendererType = m_renderCtx->getRendererType();
+		m_readBackLatency   = m_renderCtx->getReadBackLatency();
 		initAttribTypeSizeTable(g_caps.rendererType);
 
 		g_caps.supported &= _init.capabilities;
@@ -2046,14 +3412,10 @@ namespace bgfx
 		m_textVideoMemBlitter.init();
 		m_clearQuad.init();
 
-		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
-		frame();
-
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
 		{
-			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+			getTransientVertexBufferPage(m_submit, 0);
+			getTransientIndexBufferPage(m_submit, 0);
 			frame();
 		}
 
@@ -2064,19 +3426,22 @@ namespace bgfx
 
 	void Context::shutdown()
 	{
+		frameReplayDestroy(m_frameReplay, this);
+		m_frameReplay = NULL;
+
+		m_resourceLoader.shutdown();
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
-		destroyTransientVertexBuffer(m_submit->m_transientVb);
-		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		destroyTransientBuffers(m_submit, 0, 0);
 		m_textVideoMemBlitter.shutdown();
 		m_clearQuad.shutdown();
 		frame();
 
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		for (uint32_t ii = 1; ii < m_numFrames; ++ii)
 		{
-			destroyTransientVertexBuffer(m_submit->m_transientVb);
-			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			destroyTransientBuffers(m_submit, 0, 0);
 			frame();
 		}
 
@@ -2086,9 +3451,7 @@ namespace bgfx
 		frame();
 
 		m_encoder[0].end(true);
-		m_encoderHandle->free(0);
-		bx::destroyHandleAlloc(g_allocator, m_encoderHandle);
-		m_encoderHandle = NULL;
+		m_encoderPool = 0;
 
 		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 		{
@@ -2098,8 +3461,10 @@ namespace bgfx
 		BX_ALIGNED_FREE(g_allocator, m_encoder, BX_ALIGNOF(EncoderImpl) );
 		BX_FREE(g_allocator, m_encoderStats);
 
-		m_dynVertexBufferAllocator.compact();
-		m_dynIndexBufferAllocator.compact();
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_drawList); ++ii)
+		{
+			m_drawList[ii].destroy();
+		}
 
 		BX_ASSERT(
 			  m_layoutHandle.getNumHandles() == m_vertexLayoutRef.m_vertexLayoutMap.getNumElements()
@@ -2112,7 +3477,11 @@ namespace bgfx
 
 #if BGFX_CONFIG_MULTITHREADED
 		// Render thread shutdown sequence.
-		renderSemWait(); // Wait for previous frame.
+		for (uint32_t ii = 1; ii < m_numFrames; ++ii)
+		{
+			renderSemWait(); // Wait for all frames in flight.
+		}
+
 		apiSemPost();   // OK to set context to NULL.
 		// s_ctx is NULL here.
 		renderSemWait(); // In RenderFrame::Exiting state.
@@ -2121,14 +3490,24 @@ namespace bgfx
 		{
 			m_thread.shutdown();
 		}
-
-		m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		m_jobPool.shutdown();
+
+		frameCaptureDestroy(m_frameCapture);
+		m_frameCapture = NULL;
+
+		TraceRecorder* traceRecorder = g_traceRecorder;
+		g_traceRecorder = NULL;
+		traceRecorderDestroy(traceRecorder);
+
 		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
-		m_submit->destroy();
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			m_frame[ii].destroy();
+		}
 
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		{
@@ -2204,6 +3583,7 @@ namespace bgfx
 			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
 			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
 			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+			CHECK_HANDLE_LEAK        ("DrawListHandle",            m_drawListHandle                                            );
 #undef CHECK_HANDLE_LEAK
 #undef CHECK_HANDLE_LEAK_NAME
 		}
@@ -2236,6 +3616,16 @@ namespace bgfx
 			m_occlusionQueryHandle.free(m_freeOcclusionQueryHandle[ii].idx);
 		} // ?? 这个啥 不用加什么命令到 mCmdPost
 		m_numFreeOcclusionQueryHandles = 0;
+
+		// Draw list is copied into frame on submit, and renderer never
+		// references it.
+		for (uint16_t ii = 0, num = m_numFreeDrawListHandles; ii < num; ++ii)
+		{
+			const uint16_t idx = m_freeDrawListHandle[ii].idx;
+			m_drawList[idx].destroy();
+			m_drawListHandle.free(idx);
+		}
+		m_numFreeDrawListHandles = 0;
 	}
 
 	void Context::freeAllHandles(Frame* _frame)
@@ -2288,20 +3678,84 @@ namespace bgfx
 #if BGFX_CONFIG_MULTITHREADED
 		if (_forThread || BGFX_API_THREAD_MAGIC != s_threadIndex)
 		{
-			bx::MutexScope scopeLock(m_encoderApiLock);
+			// Reserve end signal first, frame can't be swapped until this
+			// encoder is ended.
+			for (uint32_t state = m_encoderPool;; state = m_encoderPool)
+			{
+				if (0 != (state & kEncoderPoolLocked) )
+				{
+					bx::yield();
+					continue;
+				}
+
+				const uint32_t newState = state + (1<<kEncoderPoolBeginShift);
+				if (state == bx::atomicCompareAndSwap<uint32_t>(&m_encoderPool, state, newState) )
+				{
+					break;
+				}
+			}
+
+			// Frame number is stable while end signal is reserved.
+			const uint32_t frameKey = (m_frames & 0xffffff) << 8;
+
+			if (BX_ENABLED(BGFX_CONFIG_ENCODER_THREAD_CACHE) )
+			{
+				// Thread local key is truncated frame number, it matches again after
+				// 2^24 frames or after shutdown and init. Reuse encoder only if it
+				// was taken from pool in this frame by this thread.
+				const uint32_t cached = uint32_t(s_threadEncoder);
+				if (0    != cached
+				&&  frameKey == (cached & UINT32_C(0xffffff00) )
+				&&  (cached & 0xff) < g_caps.limits.maxEncoders)
+				{
+					EncoderImpl* cachedEncoder = &m_encoder[cached & 0xff];
+					if (m_frames   == cachedEncoder->m_ownerFrame
+					&&  m_submit   == cachedEncoder->m_frame
+					&&  bx::getTid() == cachedEncoder->m_ownerTid)
+					{
+						cachedEncoder->resume();
+						return reinterpret_cast<Encoder*>(cachedEncoder);
+					}
+				}
+			}
+
+			uint32_t idx = UINT32_MAX;
+
+			for (uint32_t state = m_encoderPool;; state = m_encoderPool)
+			{
+				const uint32_t num = state & kEncoderPoolNumMask;
+				if (num >= g_caps.limits.maxEncoders)
+				{
+					break;
+				}
+
+				if (state == bx::atomicCompareAndSwap<uint32_t>(&m_encoderPool, state, state + 1) )
+				{
+					idx = num;
+					break;
+				}
+			}
 
-			uint16_t idx = m_encoderHandle->alloc();  // 这个返回是 1 2 3  不会是1
-			if (kInvalidHandle == idx)
+			if (UINT32_MAX == idx)
 			{
+				// Out of encoders, release reserved end signal.
+				m_encoderEndSem.post();
 				return NULL;
 			}
-            
+
             // 这两个数目应该是一样的
             // Context::m_frame[0|1]->m_uniformBuffer[THREAD_NUM]
             // Context::m_encoder[THREAD_NUM]
 
 			encoder = &m_encoder[idx]; // 多线程会取出一个 m_encoder是个数组 EncoderImpl*
 			encoder->begin(m_submit, uint8_t(idx) ); // EncoderImpl 有多少个  idx 就有多大, 传入这个可以对应Frame.uniformBuffer[线程号] <---> 跟encoder对应
+
+			if (BX_ENABLED(BGFX_CONFIG_ENCODER_THREAD_CACHE) )
+			{
+				encoder->m_ownerFrame = m_frames;
+				encoder->m_ownerTid   = bx::getTid();
+				s_threadEncoder = frameKey | idx;
+			}
 		}
 #else
 		BX_UNUSED(_forThread);
@@ -2332,7 +3786,6 @@ namespace bgfx
 		bx::MutexScope resourceApiScope(m_resourceApiLock);
 
 		encoderApiWait(); // !!! 等待所有的encoder完成   新的一帧开始 ???  清除一下handle ？ //  [api|render|encoderApi]SemWait  等待所有的encoder的end信号
-		bx::MutexScope encoderApiScope(m_encoderApiLock);
 #else
 		encoderApiWait();
 #endif // BGFX_CONFIG_MULTITHREADED
@@ -2346,6 +3799,8 @@ namespace bgfx
 
 		m_encoder[0].begin(m_submit, 0);
 
+		encoderApiUnlock();
+
 		return m_frames;
 	}
 
@@ -2390,11 +3845,15 @@ namespace bgfx
 		freeAllHandles(m_submit); // 调用 context.[xxx]Handle.free( _frame->m_free[xxx]]Buffer )  归还给 context ??
 		m_submit->resetFreeHandles(); // _frame->m_free[xxx]Buffer.queue清空 num=0
 
-		m_submit->finish(); // pre和post的CommandBuffer都插入 end命令
+		m_transientVbPages.update(m_submit->m_vboffset, g_caps.limits.transientVbSize);
+		m_transientIbPages.update(m_submit->m_iboffset, g_caps.limits.transientIbSize);
 
-		bx::swap(m_render, m_submit); // 相当于 把 当前所有submit的提交到 render线程 来执行command
+		m_submit->finish(); // pre和post的CommandBuffer都插入 end命令
 
-		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );// 之前一帧的遮挡查询要给到下一帧 ？？
+		// Submitted frame is queued for render thread, next frame in ring was
+		// already rendered since renderSemWait returned.
+		Frame* submitted = m_submit;
+		m_submit = getNextFrame(m_submit); // 相当于 把 当前所有submit的提交到 render线程 来执行command
 
 		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
 		||  m_singleThreaded)
@@ -2405,10 +3864,13 @@ namespace bgfx
 		m_frames++;
 		m_submit->start();
 
+		// Frame in ring is reused, release pages it no longer needs.
+		destroyTransientBuffers(m_submit, m_transientIbPages.m_num, m_transientVbPages.m_num);
+
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
 
 		m_submit->m_textVideoMem->resize( // ??? 啥作用 ???
-			  m_render->m_textVideoMem->m_small
+			  submitted->m_textVideoMem->m_small
 			, m_init.resolution.width
 			, m_init.resolution.height
 			);
@@ -2479,8 +3941,27 @@ namespace bgfx
 			flip(); // 要么在前面flip 要么在后面flip
 		}
 
+		if (UINT32_MAX == m_renderTid)
+		{
+			m_renderTid = bx::getTid();
+			traceSetThreadName(g_traceRecorder, m_renderTid, "bgfx render thread");
+		}
+
 		if (apiSemWait(_msecs) ) // 卡在这里 要等bgfx::init执行完毕 并且 每次渲染都要等这个信号
 		{
+			// Results written by previous frame are starting point for this
+			// one, no matter how many frames API thread is ahead.
+			bx::memCopy(m_render->m_occlusion, m_occlusion, sizeof(m_occlusion) );
+
+#if BGFX_CONFIG_FRAME_CAPTURE
+			if (NULL == m_frameCapture)
+			{
+				m_frameCapture = frameCaptureCreate(BGFX_CONFIG_FRAME_CAPTURE_FILE_PATH);
+			}
+
+			frameCaptureCommands(m_frameCapture, m_render->m_cmdPre);
+#endif // BGFX_CONFIG_FRAME_CAPTURE
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
 				rendererExecCommands(m_render->m_cmdPre);
@@ -2488,10 +3969,20 @@ namespace bgfx
 
 			if (m_rendererInitialized)
 			{
+#if BGFX_CONFIG_FRAME_CAPTURE
+				if (m_render->m_capture)
+				{
+					frameCaptureFrame(m_frameCapture, m_render);
+				}
+#endif // BGFX_CONFIG_FRAME_CAPTURE
+
 				{
 					BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
+					const int64_t submitBegin = bx::getHPCounter();
 					m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter); // RenderContextMtl 渲染指令 submit metal drawPrimitives
 					m_flipped = false;
+
+					traceRecordViews(g_traceRecorder, m_render->m_perfStats, m_renderTid, submitBegin);
 				}
 
 				{
@@ -2504,11 +3995,17 @@ namespace bgfx
 				}
 			}
 
+#if BGFX_CONFIG_FRAME_CAPTURE
+			frameCaptureCommands(m_frameCapture, m_render->m_cmdPost);
+#endif // BGFX_CONFIG_FRAME_CAPTURE
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands post", 0xff2040ff);
 				rendererExecCommands(m_render->m_cmdPost);
 			}
 
+			bx::memCopy(m_occlusion, m_render->m_occlusion, sizeof(m_occlusion) );
+
 			renderSemPost();
 
 			if (m_flipAfterRender)
@@ -2528,6 +4025,11 @@ namespace bgfx
 			;
 	}
 
+	JobPool& getJobPool()
+	{
+		return s_ctx->m_jobPool;
+	}
+
     // bgfx::rendererUpdateUniforms 全局函数 bgfx_p.h
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
 	{
@@ -2554,20 +4056,23 @@ namespace bgfx
 			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
 
 			uint32_t size = g_uniformTypeSize[type]*num;
-			const char* data = _uniformBuffer->read(size);
 			if (UniformType::Count > type)
 			{
 				if (copy) // bgfx::setUniform
 				{
+					const char* data = _uniformBuffer->read(size);
 					_renderCtx->updateUniform(loc, data, size); // 设置到 RenderContextMtl::m_uniforms[loc]  loc是 createUniform返回的 UnformHandle句柄 
 				}
 				else
 				{
-					_renderCtx->updateUniform(loc, *(const char**)(data), size);
+					// Value didn't change, encoder wrote position of previous value.
+					const uint32_t pos = _uniformBuffer->read();
+					_renderCtx->updateUniform(loc, _uniformBuffer->getData(pos), size);
 				}
 			}
 			else
 			{
+				const char* data = _uniformBuffer->read(size);
 				_renderCtx->setMarker(data, uint16_t(size)-1);
 			}
 		}
@@ -2720,9 +4225,11 @@ namespace bgfx
 		return *(const int32_t*)_rhs - *(const int32_t*)_lhs;
 	}
 
-	RendererContextI* rendererCreate(const Init& _init)
+	// Scores of supported renderers sorted best first, renderer type is in
+	// low 8 bits of score.
+	static uint32_t getRendererScores(const Init& _init, int32_t* _outScores)
 	{
-		int32_t scores[RendererType::Count];
+		int32_t* scores = _outScores;
 		uint32_t numScores = 0;
 
 		for (uint32_t ii = 0; ii < RendererType::Count; ++ii)
@@ -2799,6 +4306,22 @@ namespace bgfx
 
 		bx::quickSort(scores, numScores, sizeof(int32_t), compareDescending);
 
+		return numScores;
+	}
+
+	// Renderer rendererCreate tries first.
+	static RendererType::Enum getPreferredRenderer(const Init& _init)
+	{
+		int32_t scores[RendererType::Count];
+		const uint32_t numScores = getRendererScores(_init, scores);
+		return 0 < numScores ? RendererType::Enum(scores[0] & 0xff) : RendererType::Noop;
+	}
+
+	RendererContextI* rendererCreate(const Init& _init)
+	{
+		int32_t scores[RendererType::Count];
+		const uint32_t numScores = getRendererScores(_init, scores);
+
 		RendererContextI* renderCtx = NULL;
 		for (uint32_t ii = 0; ii < numScores; ++ii)
 		{
@@ -3165,23 +4688,9 @@ namespace bgfx
 						setDirectAccessPtr(handle, ptr);
 					}
 
-					bx::MemoryReader reader(mem->data, mem->size);
-
-					uint32_t magic;
-					bx::read(&reader, magic);
-
-					if (BGFX_CHUNK_MAGIC_TEX == magic)
-					{
-						TextureCreate tc;
-						bx::read(&reader, tc);
-
-						if (NULL != tc.m_mem)
-						{
-							release(tc.m_mem);
-						}
-					}
+					m_textureRef[handle.idx].setReady(true);
 
-					release(mem);
+					releaseTextureMemory(mem);
 				}
 				break;
 
@@ -3268,6 +4777,7 @@ namespace bgfx
 					_cmdbuf.read(handle);
 
 					m_renderCtx->destroyTexture(handle);
+					m_textureRef[handle.idx].setReady(false);
 				}
 				break;
 
@@ -3484,6 +4994,9 @@ namespace bgfx
 		, minResourceCbSize(BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE)
 		, transientVbSize(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE)
 		, transientIbSize(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE)
+		, stagingBufferSize(BGFX_CONFIG_STAGING_BUFFER_SIZE)
+		, maxDrawCalls(BGFX_CONFIG_MAX_DRAW_CALLS)
+		, numFrames(BGFX_CONFIG_DEFAULT_NUM_FRAMES)
 	{
 	}
 
@@ -3519,8 +5032,25 @@ namespace bgfx
 
 		Init init = _userInit; // 用户初始化数据。
 
-		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? 128 : 1);
+		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? kMaxEncoders : 1);
 		init.limits.minResourceCbSize = bx::min<uint32_t>(init.limits.minResourceCbSize, BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE);
+		init.limits.maxDrawCalls      = bx::clamp<uint32_t>(init.limits.maxDrawCalls, 1, INT32_MAX-1);
+
+		{
+			// Direct3D 12 and WebGPU scratch buffers are not grown, limit is
+			// lowered before frames are sized with it.
+			const RendererType::Enum renderer = getPreferredRenderer(init);
+			if ( (RendererType::Direct3D12 == renderer || RendererType::WebGPU == renderer)
+			&&  BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS < init.limits.maxDrawCalls)
+			{
+				BX_WARN(false, "Init::Limits::maxDrawCalls %d is lowered to %d (BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS)."
+					, init.limits.maxDrawCalls
+					, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+					);
+				init.limits.maxDrawCalls = BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS;
+			}
+		}
+		init.limits.numFrames         = bx::clamp<uint8_t>(init.limits.numFrames, (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 1, BGFX_CONFIG_MAX_FRAMES);
         // 如果多线程 init.limits.maxEncoders 设置为 8 (虽然这里写了128) init.limits.minResourceCbSize 设置为 65536
 		struct ErrorState
 		{
@@ -3555,7 +5085,7 @@ namespace bgfx
 		}
 
 		bx::memSet(&g_caps, 0, sizeof(g_caps) );
-		g_caps.limits.maxDrawCalls            = BGFX_CONFIG_MAX_DRAW_CALLS;
+		g_caps.limits.maxDrawCalls            = init.limits.maxDrawCalls;
 		g_caps.limits.maxBlits                = BGFX_CONFIG_MAX_BLIT_ITEMS;
 		g_caps.limits.maxTextureSize          = 0;
 		g_caps.limits.maxTextureLayers        = 1;
@@ -3725,6 +5255,16 @@ namespace bgfx
 		return BGFX_ENCODER(allocTransform(_transform, _num) );
 	}
 
+	uint32_t Encoder::allocTransformSrt(const TransformSrt* _srt, uint16_t _num)
+	{
+		return BGFX_ENCODER(allocTransformSrt(_srt, _num) );
+	}
+
+	uint32_t Encoder::allocTransform4x3(const Transform4x3* _mtx, uint16_t _num)
+	{
+		return BGFX_ENCODER(allocTransform4x3(_mtx, _num) );
+	}
+
 	void Encoder::setTransform(uint32_t _cache, uint16_t _num)
 	{
 		BGFX_ENCODER(setTransform(_cache, _num) );
@@ -3763,7 +5303,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
-		BGFX_ENCODER(setIndexBuffer(dib, _firstIndex, _numIndices) );
+		BGFX_ENCODER(setIndexBuffer(_handle, dib, _firstIndex, _numIndices) );
 	}
 
 	void Encoder::setIndexBuffer(const TransientIndexBuffer* _tib)
@@ -3807,7 +5347,7 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_layoutHandle, _layoutHandle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
-		BGFX_ENCODER(setVertexBuffer(_stream, dvb, _startVertex, _numVertices, _layoutHandle) );
+		BGFX_ENCODER(setVertexBuffer(_stream, _handle, dvb, _startVertex, _numVertices, _layoutHandle) );
 	}
 
 	void Encoder::setVertexBuffer(uint8_t _stream, DynamicVertexBufferHandle _handle)
@@ -3840,6 +5380,59 @@ namespace bgfx
 		BGFX_ENCODER(setVertexCount(_numVertices) );
 	}
 
+	void Encoder::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32)
+	{
+		BX_ASSERT(NULL != _tib, "_tib can't be NULL");
+		BX_ASSERT(0 < _num, "Requesting 0 indices.");
+		BX_ASSERT(
+			  !_index32 || 0 != (g_caps.supported & BGFX_CAPS_INDEX32)
+			, "32-bit indices are not supported. Use bgfx::getCaps to check BGFX_CAPS_INDEX32 backend renderer capabilities."
+			);
+
+		BGFX_ENCODER(allocTransientIndexBuffer(_tib, _num, _index32) );
+
+		const uint32_t indexSize = _tib->isIndex16 ? 2 : 4;
+		BX_ASSERT(_num == _tib->size/ indexSize
+			, "Failed to allocate transient index buffer (requested %d, available %d). "
+			  "Use bgfx::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tib->size/indexSize
+			);
+		BX_UNUSED(indexSize);
+	}
+
+	void Encoder::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout)
+	{
+		BX_ASSERT(NULL != _tvb, "_tvb can't be NULL");
+		BX_ASSERT(0 < _num, "Requesting 0 vertices.");
+		BX_ASSERT(isValid(_layout), "Invalid VertexLayout.");
+
+		BGFX_ENCODER(allocTransientVertexBuffer(_tvb, _num, _layout) );
+
+		BX_ASSERT(_num == _tvb->size / _layout.m_stride
+			, "Failed to allocate transient vertex buffer (requested %d, available %d). "
+			  "Use bgfx::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tvb->size / _layout.m_stride
+			);
+	}
+
+	void Encoder::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
+		BX_ASSERT(bx::isAligned(_stride, 16), "Stride must be multiple of 16.");
+		BX_ASSERT(0 < _num, "Requesting 0 instanced data vertices.");
+
+		BGFX_ENCODER(allocInstanceDataBuffer(_idb, _num, _stride) );
+
+		BX_ASSERT(_num == _idb->size / _stride
+			, "Failed to allocate instance data buffer (requested %d, available %d). "
+			  "Use bgfx::getAvailTransient* functions to ensure availability."
+			, _num
+			, _idb->size / _stride
+			);
+	}
+
 	void Encoder::setInstanceDataBuffer(const InstanceDataBuffer* _idb)
 	{
 		setInstanceDataBuffer(_idb, 0, UINT32_MAX);
@@ -3862,11 +5455,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
-		BGFX_ENCODER(setInstanceDataBuffer(dvb.m_handle
-			, dvb.m_startVertex + _startVertex
-			, _num
-			, dvb.m_stride
-			) );
+		BGFX_ENCODER(setInstanceDataBuffer(_handle, dvb, _startVertex, _num) );
 	}
 
 	void Encoder::setInstanceCount(uint32_t _numInstances)
@@ -3880,6 +5469,16 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setTexture/UniformHandle", s_ctx->m_uniformHandle, _sampler);
 		BGFX_CHECK_HANDLE_INVALID_OK("setTexture/TextureHandle", s_ctx->m_textureHandle, _handle);
 		BX_ASSERT(_stage < g_caps.limits.maxTextureSamplers, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxTextureSamplers);
+
+		if (isValid(_handle)
+		&&  s_ctx->m_textureRef[_handle.idx].isLoading() )
+		{
+			// CreateTexture command is not issued yet, renderer doesn't know
+			// about texture.
+			BX_WARN(false, "Texture %d is bound before asynchronous creation is done, draw call is discarded.", _handle.idx);
+			BGFX_ENCODER(m_discard = true);
+		}
+
 		BGFX_ENCODER(setTexture(_stage, _sampler, _handle, _flags) );
 	}
 
@@ -3915,6 +5514,19 @@ namespace bgfx
 		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _flags) );
 	}
 
+	void Encoder::record(DrawListHandle _handle, ProgramHandle _program, uint32_t _depth, uint8_t _flags)
+	{
+		BGFX_CHECK_HANDLE("record", s_ctx->m_drawListHandle, _handle);
+		BGFX_CHECK_HANDLE_INVALID_OK("record", s_ctx->m_programHandle, _program);
+		BGFX_ENCODER(record(s_ctx->m_drawList[_handle.idx], _program, _depth, _flags) );
+	}
+
+	void Encoder::submit(ViewId _id, DrawListHandle _handle, uint32_t _depth)
+	{
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_drawListHandle, _handle);
+		BGFX_ENCODER(submit(_id, s_ctx->m_drawList[_handle.idx], _depth) );
+	}
+
 	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
@@ -3934,7 +5546,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
-		BGFX_ENCODER(setBuffer(_stage, dib.m_handle, _access) );
+		BGFX_ENCODER(setBuffer(_stage, _handle, dib, _access) );
 	}
 
 	void Encoder::setBuffer(uint8_t _stage, DynamicVertexBufferHandle _handle, Access::Enum _access)
@@ -3942,7 +5554,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
-		BGFX_ENCODER(setBuffer(_stage, dvb.m_handle, _access) );
+		BGFX_ENCODER(setBuffer(_stage, _handle, dvb, _access) );
 	}
 
 	void Encoder::setBuffer(uint8_t _stage, IndirectBufferHandle _handle, Access::Enum _access)
@@ -3964,6 +5576,14 @@ namespace bgfx
 		BX_ASSERT(_format != TextureFormat::BGRA8
 			, "Can't use TextureFormat::BGRA8 with compute, use TextureFormat::RGBA8 instead."
 			);
+
+		if (isValid(_handle)
+		&&  s_ctx->m_textureRef[_handle.idx].isLoading() )
+		{
+			BX_WARN(false, "Texture %d is bound before asynchronous creation is done, dispatch is discarded.", _handle.idx);
+			BGFX_ENCODER(m_discard = true);
+		}
+
 		BGFX_ENCODER(setImage(_stage, _handle, _mip, _access, _format) );
 	}
 
@@ -4899,6 +6519,11 @@ namespace bgfx
 		return s_ctx->getDirectAccessPtr(_handle);
 	}
 
+	bool isTextureReady(TextureHandle _handle)
+	{
+		return s_ctx->isTextureReady(_handle);
+	}
+
 	void destroy(TextureHandle _handle)
 	{
 		s_ctx->destroyTexture(_handle);
@@ -5069,6 +6694,16 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	DrawListHandle createDrawList()
+	{
+		return s_ctx->createDrawList();
+	}
+
+	void destroy(DrawListHandle _handle)
+	{
+		s_ctx->destroyDrawList(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -5228,6 +6863,18 @@ namespace bgfx
 		return s_ctx->m_encoder0->allocTransform(_transform, _num);
 	}
 
+	uint32_t allocTransformSrt(const TransformSrt* _srt, uint16_t _num)
+	{
+		BGFX_CHECK_ENCODER0();
+		return s_ctx->m_encoder0->allocTransformSrt(_srt, _num);
+	}
+
+	uint32_t allocTransform4x3(const Transform4x3* _mtx, uint16_t _num)
+	{
+		BGFX_CHECK_ENCODER0();
+		return s_ctx->m_encoder0->allocTransform4x3(_mtx, _num);
+	}
+
 	void setTransform(uint32_t _cache, uint16_t _num)
 	{
 		BGFX_CHECK_ENCODER0();
@@ -5390,6 +7037,18 @@ namespace bgfx
 		s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _num, _depth, _flags);
 	}
 
+	void record(DrawListHandle _handle, ProgramHandle _program, uint32_t _depth, uint8_t _flags)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->record(_handle, _program, _depth, _flags);
+	}
+
+	void submit(ViewId _id, DrawListHandle _handle, uint32_t _depth)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->submit(_id, _handle, _depth);
+	}
+
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_ENCODER0();
@@ -5461,6 +7120,17 @@ namespace bgfx
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
 
+	uint32_t replayFrame(const void* _data, uint32_t _size, uint32_t _offset)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->replayFrame(_data, _size, _offset);
+	}
+
+	bool saveTrace(const char* _filePath)
+	{
+		return traceSave(g_traceRecorder, _filePath);
+	}
+
 #undef BGFX_CHECK_ENCODER0
 
 } // namespace bgfx
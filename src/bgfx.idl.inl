@@ -515,6 +515,12 @@ BGFX_C_API void* bgfx_get_direct_access_ptr(bgfx_texture_handle_t _handle)
 	return bgfx::getDirectAccessPtr(handle.cpp);
 }
 
+BGFX_C_API bool bgfx_is_texture_ready(bgfx_texture_handle_t _handle)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	return bgfx::isTextureReady(handle.cpp);
+}
+
 BGFX_C_API void bgfx_destroy_texture(bgfx_texture_handle_t _handle)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
@@ -615,6 +621,19 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_draw_list_handle_t bgfx_create_draw_list(void)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createDrawList();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_destroy_draw_list(bgfx_draw_list_handle_t _handle)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -746,6 +765,18 @@ BGFX_C_API uint32_t bgfx_encoder_alloc_transform(bgfx_encoder_t* _this, bgfx_tra
 	return This->allocTransform((bgfx::Transform*)_transform, _num);
 }
 
+BGFX_C_API uint32_t bgfx_encoder_alloc_transform_srt(bgfx_encoder_t* _this, const bgfx_transform_srt_t* _srt, uint16_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	return This->allocTransformSrt( (const bgfx::TransformSrt*)_srt, _num);
+}
+
+BGFX_C_API uint32_t bgfx_encoder_alloc_transform_4x3(bgfx_encoder_t* _this, const bgfx_transform_4x3_t* _mtx, uint16_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	return This->allocTransform4x3( (const bgfx::Transform4x3*)_mtx, _num);
+}
+
 BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -885,6 +916,40 @@ BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id
 	This->submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_encoder_record(bgfx_encoder_t* _this, bgfx_draw_list_handle_t _handle, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	This->record(handle.cpp, program.cpp, _depth, _flags);
+}
+
+BGFX_C_API void bgfx_encoder_submit_draw_list(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, uint32_t _depth)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	This->submit((bgfx::ViewId)_id, handle.cpp, _depth);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->allocTransientIndexBuffer((bgfx::TransientIndexBuffer*)_tib, _num, _index32);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_layout_t * _layout)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	const bgfx::VertexLayout & layout = *(const bgfx::VertexLayout *)_layout;
+	This->allocTransientVertexBuffer((bgfx::TransientVertexBuffer*)_tvb, _num, layout);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->allocInstanceDataBuffer((bgfx::InstanceDataBuffer*)_idb, _num, _stride);
+}
+
 BGFX_C_API void bgfx_encoder_set_compute_index_buffer(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -990,6 +1055,16 @@ BGFX_C_API uintptr_t bgfx_override_internal_texture(bgfx_texture_handle_t _handl
 	return bgfx::overrideInternal(handle.cpp, _width, _height, _numMips, (bgfx::TextureFormat::Enum)_format, _flags);
 }
 
+BGFX_C_API uint32_t bgfx_replay_frame(const void* _data, uint32_t _size, uint32_t _offset)
+{
+	return bgfx::replayFrame(_data, _size, _offset);
+}
+
+BGFX_C_API bool bgfx_save_trace(const char* _filePath)
+{
+	return bgfx::saveTrace(_filePath);
+}
+
 BGFX_C_API void bgfx_set_marker(const char* _marker)
 {
 	bgfx::setMarker(_marker);
@@ -1036,6 +1111,16 @@ BGFX_C_API uint32_t bgfx_alloc_transform(bgfx_transform_t* _transform, uint16_t
 	return bgfx::allocTransform((bgfx::Transform*)_transform, _num);
 }
 
+BGFX_C_API uint32_t bgfx_alloc_transform_srt(const bgfx_transform_srt_t* _srt, uint16_t _num)
+{
+	return bgfx::allocTransformSrt( (const bgfx::TransformSrt*)_srt, _num);
+}
+
+BGFX_C_API uint32_t bgfx_alloc_transform_4x3(const bgfx_transform_4x3_t* _mtx, uint16_t _num)
+{
+	return bgfx::allocTransform4x3( (const bgfx::Transform4x3*)_mtx, _num);
+}
+
 BGFX_C_API void bgfx_set_uniform(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num)
 {
 	union { bgfx_uniform_handle_t c; bgfx::UniformHandle cpp; } handle = { _handle };
@@ -1155,6 +1240,19 @@ BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _
 	bgfx::submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_record(bgfx_draw_list_handle_t _handle, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	bgfx::record(handle.cpp, program.cpp, _depth, _flags);
+}
+
+BGFX_C_API void bgfx_submit_draw_list(bgfx_view_id_t _id, bgfx_draw_list_handle_t _handle, uint32_t _depth)
+{
+	union { bgfx_draw_list_handle_t c; bgfx::DrawListHandle cpp; } handle = { _handle };
+	bgfx::submit((bgfx::ViewId)_id, handle.cpp, _depth);
+}
+
 BGFX_C_API void bgfx_set_compute_index_buffer(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1334,6 +1432,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_read_texture,
 			bgfx_set_texture_name,
 			bgfx_get_direct_access_ptr,
+			bgfx_is_texture_ready,
 			bgfx_destroy_texture,
 			bgfx_create_frame_buffer,
 			bgfx_create_frame_buffer_scaled,
@@ -1349,6 +1448,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_create_draw_list,
+			bgfx_destroy_draw_list,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba8,
 			bgfx_set_view_name,
@@ -1373,6 +1474,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_set_transform,
 			bgfx_encoder_set_transform_cached,
 			bgfx_encoder_alloc_transform,
+			bgfx_encoder_alloc_transform_srt,
+			bgfx_encoder_alloc_transform_4x3,
 			bgfx_encoder_set_uniform,
 			bgfx_encoder_set_index_buffer,
 			bgfx_encoder_set_dynamic_index_buffer,
@@ -1393,6 +1496,11 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_submit,
 			bgfx_encoder_submit_occlusion_query,
 			bgfx_encoder_submit_indirect,
+			bgfx_encoder_record,
+			bgfx_encoder_submit_draw_list,
+			bgfx_encoder_alloc_transient_index_buffer,
+			bgfx_encoder_alloc_transient_vertex_buffer,
+			bgfx_encoder_alloc_instance_data_buffer,
 			bgfx_encoder_set_compute_index_buffer,
 			bgfx_encoder_set_compute_vertex_buffer,
 			bgfx_encoder_set_compute_dynamic_index_buffer,
@@ -1409,6 +1517,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_get_internal_data,
 			bgfx_override_internal_texture_ptr,
 			bgfx_override_internal_texture,
+			bgfx_replay_frame,
+			bgfx_save_trace,
 			bgfx_set_marker,
 			bgfx_set_state,
 			bgfx_set_condition,
@@ -1418,6 +1528,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_set_transform,
 			bgfx_set_transform_cached,
 			bgfx_alloc_transform,
+			bgfx_alloc_transform_srt,
+			bgfx_alloc_transform_4x3,
 			bgfx_set_uniform,
 			bgfx_set_index_buffer,
 			bgfx_set_dynamic_index_buffer,
@@ -1438,6 +1550,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_submit,
 			bgfx_submit_occlusion_query,
 			bgfx_submit_indirect,
+			bgfx_record,
+			bgfx_submit_draw_list,
 			bgfx_set_compute_index_buffer,
 			bgfx_set_compute_vertex_buffer,
 			bgfx_set_compute_dynamic_index_buffer,
@@ -50,14 +50,18 @@
 #	define BGFX_MUTEX_SCOPE(_mutex) BX_NOOP()
 #endif // BGFX_CONFIG_MULTITHREADED
 
-#if BGFX_CONFIG_PROFILER
+#if BGFX_CONFIG_PROFILER || BGFX_CONFIG_TRACE_RECORDER
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
+#else
+#	define BGFX_PROFILER_SCOPE(_name, _abgr)            BX_NOOP()
+#endif // BGFX_CONFIG_PROFILER || BGFX_CONFIG_TRACE_RECORDER
+
+#if BGFX_CONFIG_PROFILER
 #	define BGFX_PROFILER_BEGIN(_name, _abgr)            g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
 #	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
 #	define BGFX_PROFILER_END()                          g_callback->profilerEnd()
 #	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
 #else
-#	define BGFX_PROFILER_SCOPE(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    BX_NOOP()
 #	define BGFX_PROFILER_END()                          BX_NOOP()
@@ -153,6 +157,8 @@ namespace bgfx
 
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
+#include "debug_capture.h"
+#include "debug_trace.h"
 #include "shader.h"
 #include "vertexlayout.h"
 #include "version.h"
@@ -304,11 +310,9 @@ namespace bgfx
 	extern bool g_platformDataChangedSinceReset;
 	extern void isFrameBufferValid(uint8_t _num, const Attachment* _attachment, bx::Error* _err);
 
-#if BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
-	typedef uint16_t RenderItemCount;
-#else
+	// Number of draw calls is runtime limit (see Init::Limits::maxDrawCalls),
+	// and it's not known at compile time if it fits into 16-bit.
 	typedef uint32_t RenderItemCount;
-#endif // BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
 
 	struct Handle
 	{
@@ -501,14 +505,35 @@ namespace bgfx
 	struct ProfilerScope
 	{
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
+#if BGFX_CONFIG_TRACE_RECORDER
+			: m_name(_name)
+			, m_begin(bx::getHPCounter() )
+#endif // BGFX_CONFIG_TRACE_RECORDER
 		{
-			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			if (BX_ENABLED(BGFX_CONFIG_PROFILER) )
+			{
+				g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			}
+
+			BX_UNUSED(_name, _abgr, _filePath, _line);
 		}
 
 		~ProfilerScope()
 		{
-			g_callback->profilerEnd();
+			if (BX_ENABLED(BGFX_CONFIG_PROFILER) )
+			{
+				g_callback->profilerEnd();
+			}
+
+#if BGFX_CONFIG_TRACE_RECORDER
+			traceRecord(g_traceRecorder, m_name, bx::getTid(), m_begin, bx::getHPCounter() );
+#endif // BGFX_CONFIG_TRACE_RECORDER
 		}
+
+#if BGFX_CONFIG_TRACE_RECORDER
+		const char* m_name;
+		int64_t     m_begin;
+#endif // BGFX_CONFIG_TRACE_RECORDER
 	};
 
 	void setGraphicsDebuggerPresent(bool _present);
@@ -1293,12 +1318,31 @@ namespace bgfx
 		}
 	};
 
+	void srtToMatrix4(void* _dst, const void* _src, uint32_t _num);
+	void mtx4x3ToMatrix4(void* _dst, const void* _src, uint32_t _num);
+
 	struct MatrixCache
 	{
 		MatrixCache()
-			: m_num(1)
+			: m_cache(NULL)
+			, m_num(1)
+			, m_max(0)
 		{
+		}
+
+		void create(uint32_t _max)
+		{
+			m_max   = _max;
+			m_cache = (Matrix4*)BX_ALIGNED_ALLOC(g_allocator, sizeof(Matrix4)*m_max, 64);
 			m_cache[0].setIdentity();
+			reset();
+		}
+
+		void destroy()
+		{
+			BX_ALIGNED_FREE(g_allocator, m_cache, 64);
+			m_cache = NULL;
+			m_max   = 0;
 		}
 
 		void reset()
@@ -1309,9 +1353,9 @@ namespace bgfx
 		uint32_t reserve(uint16_t* _num)
 		{
 			uint32_t num = *_num;
-			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_MATRIX_CACHE - 1);
-			BX_WARN(first+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-1-first);
+			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, m_max - 1);
+			BX_WARN(first+num < m_max, "Matrix cache overflow. %d (max: %d)", first+num, m_max);
+			num = bx::min(num, m_max-1-first);
 			*_num = (uint16_t)num;
 			return first;
 		}
@@ -1328,11 +1372,54 @@ namespace bgfx
 			return 0;
 		}
 
+		// Reserves all _num matrices or none, returns UINT32_MAX when cache
+		// can't fit all of them.
+		uint32_t reserveAll(uint16_t _num)
+		{
+			uint16_t num = _num;
+			const uint32_t first = reserve(&num);
+			return num == _num ? first : UINT32_MAX;
+		}
+
+		uint32_t addSrt(const TransformSrt* _srt, uint16_t _num)
+		{
+			if (NULL != _srt)
+			{
+				// Single atomic reserve for all matrices, transforms are expanded
+				// directly into m_cache.
+				const uint32_t first = reserveAll(_num);
+				if (UINT32_MAX != first)
+				{
+					srtToMatrix4(&m_cache[first], _srt, _num);
+				}
+
+				return first;
+			}
+
+			return 0;
+		}
+
+		uint32_t add4x3(const Transform4x3* _mtx, uint16_t _num)
+		{
+			if (NULL != _mtx)
+			{
+				const uint32_t first = reserveAll(_num);
+				if (UINT32_MAX != first)
+				{
+					mtx4x3ToMatrix4(&m_cache[first], _mtx, _num);
+				}
+
+				return first;
+			}
+
+			return 0;
+		}
+
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_ASSERT(_cacheIdx < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_ASSERT(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_max
 				);
 			return m_cache[_cacheIdx].un.val;
 		}
@@ -1342,8 +1429,9 @@ namespace bgfx
 			return uint32_t( (const Matrix4*)_ptr - m_cache);
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		Matrix4* m_cache;
 		uint32_t m_num;
+		uint32_t m_max;
 	};
 
 	struct RectCache
@@ -1494,6 +1582,11 @@ namespace bgfx
 			return m_pos;
 		}
 
+		const char* getData(uint32_t _pos) const
+		{
+			return &m_buffer[_pos];
+		}
+
 		void reset(uint32_t _pos = 0)
 		{
 			m_pos = _pos;
@@ -1506,6 +1599,20 @@ namespace bgfx
 		}
 
 		void writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
+
+		// In per draw uniform buffer, opcode without copy bit is followed by
+		// position of value already written into the same buffer, instead of
+		// copy of the value.
+		void writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num = 1);
+
+		// Returns true if value written at _pos is for the same uniform and
+		// equal to _value.
+		bool isUniformEqual(uint32_t _pos, UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num) const;
+
+		// Copies uniforms written between _begin and _end into _dst, replacing
+		// references with copy of the value. Returns number of bytes copied,
+		// when _dst is NULL only size is returned.
+		uint32_t copyResolved(void* _dst, uint32_t _begin, uint32_t _end) const;
         
         // void RenderContext::commit(UniformBuffer& _uniformBuffer)
 		void writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num = 1);
@@ -1884,6 +1991,24 @@ namespace bgfx
 			m_immutable   = _immutable;
 			m_cubeMap     = _cubeMap;
 			m_flags       = _flags;
+			m_loadIdx     = UINT16_MAX;
+			m_ready       = 0;
+		}
+
+		// Set on render thread once API object is created, read on API thread.
+		void setReady(bool _ready)
+		{
+			bx::atomicCompareAndSwap<int32_t>(&m_ready, _ready ? 0 : 1, _ready ? 1 : 0);
+		}
+
+		bool isReady()
+		{
+			return 0 != bx::atomicFetchAndAdd<int32_t>(&m_ready, 0);
+		}
+
+		bool isLoading() const
+		{
+			return UINT16_MAX != m_loadIdx;
 		}
 
 		bool isRt() const
@@ -1919,6 +2044,8 @@ namespace bgfx
 		uint8_t  m_numSamples;
 		uint8_t  m_numMips;
 		uint16_t m_numLayers;
+		uint16_t m_loadIdx;   // ResourceLoader request index, valid until CreateTexture command is issued.
+		int32_t  m_ready;
 		bool     m_owned;
 		bool     m_immutable;
 		bool     m_cubeMap;
@@ -2019,6 +2146,16 @@ namespace bgfx
 
 	struct FrameCache
 	{
+		void create(uint32_t _maxDrawCalls)
+		{
+			m_matrixCache.create(bx::max<uint32_t>(BGFX_CONFIG_MAX_MATRIX_CACHE, _maxDrawCalls+1) );
+		}
+
+		void destroy()
+		{
+			m_matrixCache.destroy();
+		}
+
 		void reset()
 		{
 			m_matrixCache.reset();
@@ -2041,12 +2178,105 @@ namespace bgfx
 		RectCache m_rectCache;
 	};
 
+	constexpr uint32_t kSortKeyBufferMinCapacity = 1<<10;
+
+	// Sort keys submitted by single encoder. Encoder sorts its keys when it
+	// ends, and frame only merges sorted key lists of all encoders.
+	struct SortKeyBuffer
+	{
+		void create()
+		{
+			m_keys       = NULL;
+			m_tempKeys   = NULL;
+			m_values     = NULL;
+			m_tempValues = NULL;
+			m_max        = 0;
+			reset();
+			grow();
+		}
+
+		void destroy()
+		{
+			BX_FREE(g_allocator, m_keys);
+			BX_FREE(g_allocator, m_tempKeys);
+			BX_FREE(g_allocator, m_values);
+			BX_FREE(g_allocator, m_tempValues);
+		}
+
+		void reset()
+		{
+			m_num       = 0;
+			m_numSorted = 0;
+		}
+
+		void add(uint64_t _key, RenderItemCount _value)
+		{
+			if (m_num == m_max)
+			{
+				grow();
+			}
+
+			m_keys[m_num]   = _key;
+			m_values[m_num] = _value;
+			++m_num;
+		}
+
+		void grow();
+
+		// Sorts keys added since last sort, and merges them with already sorted keys.
+		void sort();
+
+		// Returns index of first key not less than _key.
+		uint32_t lowerBound(uint64_t _key) const
+		{
+			uint32_t first = 0;
+			uint32_t count = m_numSorted;
+
+			while (0 < count)
+			{
+				const uint32_t step = count/2;
+				const uint32_t mid  = first + step;
+
+				if (m_keys[mid] < _key)
+				{
+					first  = mid + 1;
+					count -= step + 1;
+				}
+				else
+				{
+					count = step;
+				}
+			}
+
+			return first;
+		}
+
+		uint64_t*        m_keys;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_values;
+		RenderItemCount* m_tempValues;
+		uint32_t m_num;
+		uint32_t m_numSorted;
+		uint32_t m_max;
+	};
+
 	struct ScreenShot
 	{
 		bx::FilePath filePath;
 		FrameBufferHandle handle;
 	};
 
+	// Contiguous range of sorted render items covering whole views. Batches
+	// returned by Frame::getViewBatches can be walked independently starting
+	// from cleared state, since renderers reset state on view change.
+	struct ViewBatch
+	{
+		uint32_t m_begin;     // First sorted render item.
+		uint32_t m_end;       // One past last sorted render item.
+		uint16_t m_viewBegin; // First view, views without render items are included.
+		uint16_t m_viewEnd;   // One past last view.
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
@@ -2054,14 +2284,13 @@ namespace bgfx
 			, m_waitRender(0)
 			, m_capture(false)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = BGFX_INVALID_HANDLE;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
+			bx::memSet(m_transientIb, 0, sizeof(m_transientIb) );
+			bx::memSet(m_transientVb, 0, sizeof(m_transientVb) );
 
 			m_perfStats.viewStats = m_viewStats;
+			m_perfStats.descriptorSetHits   = 0;
+			m_perfStats.descriptorSetMisses = 0;
 		}
 
 		~Frame()
@@ -2073,6 +2302,26 @@ namespace bgfx
 			m_cmdPre.init(_minResourceCbSize);      // CommandBuffer Frame.m_cmdPre
 			m_cmdPost.init(_minResourceCbSize);     // CommandBuffer Frame.m_cmdPost
 
+			{
+				// Per draw call arrays are sized by runtime limit, and aligned to
+				// cache line so that encoders writing neighbouring items on
+				// different threads don't share lines at array start.
+				const uint32_t num = g_caps.limits.maxDrawCalls;
+
+				m_sortKeys       = (uint64_t*       )BX_ALIGNED_ALLOC(g_allocator, sizeof(uint64_t       )*(num+1), 64);
+				m_sortValues     = (RenderItemCount*)BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderItemCount)*(num+1), 64);
+				m_renderItem     = (RenderItem*     )BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderItem     )*(num+1), 64);
+				m_renderItemBind = (RenderBind*     )BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderBind     )*(num+1), 64);
+
+				SortKey term;
+				term.reset();
+				term.m_program = BGFX_INVALID_HANDLE;
+				m_sortKeys[num]   = term.encodeDraw(SortKey::SortProgram);
+				m_sortValues[num] = RenderItemCount(num);
+
+				m_frameCache.create(num);
+			}
+
 			{
 				const uint32_t num = g_caps.limits.maxEncoders; // 同时可以有多少个encoder   Frame.m_uniformBuffer[?] ---8个 init.limit.maxEncoders的默认值
 
@@ -2082,6 +2331,14 @@ namespace bgfx
 				{
 					m_uniformBuffer[ii] = UniformBuffer::create();
 				}
+
+				m_sortKeyBuffer = (SortKeyBuffer*)BX_ALLOC(g_allocator, sizeof(SortKeyBuffer)*num);
+				m_sortKeyBound  = (uint32_t*)BX_ALLOC(g_allocator, sizeof(uint32_t)*num*(BGFX_CONFIG_MAX_VIEWS+1) );
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					m_sortKeyBuffer[ii].create();
+				}
 			}
 
 			reset();
@@ -2094,9 +2351,19 @@ namespace bgfx
 			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 			{
 				UniformBuffer::destroy(m_uniformBuffer[ii]);
+				m_sortKeyBuffer[ii].destroy();
 			}
 
 			BX_FREE(g_allocator, m_uniformBuffer);
+			BX_FREE(g_allocator, m_sortKeyBuffer);
+			BX_FREE(g_allocator, m_sortKeyBound);
+
+			m_frameCache.destroy();
+			BX_ALIGNED_FREE(g_allocator, m_sortKeys,       64);
+			BX_ALIGNED_FREE(g_allocator, m_sortValues,     64);
+			BX_ALIGNED_FREE(g_allocator, m_renderItem,     64);
+			BX_ALIGNED_FREE(g_allocator, m_renderItemBind, 64);
+
 			BX_DELETE(g_allocator, m_textVideoMem);
 		}
 
@@ -2114,6 +2381,12 @@ namespace bgfx
 
 			m_frameCache.reset(); // ????
 			m_numRenderItems = 0;
+
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				m_sortKeyBuffer[ii].reset();
+			}
+
 			m_numBlitItems   = 0;
 			m_iboffset = 0;
 			m_vboffset = 0; // 重置为0
@@ -2131,44 +2404,156 @@ namespace bgfx
 
 		void sort();
 
+		// Splits sorted render items into at most _maxBatches batches at view
+		// boundaries, balanced by number of render items. Batch is not split
+		// if it would have less than _minItems render items. Valid after sort.
+		uint32_t getViewBatches(ViewBatch* _outBatch, uint32_t _maxBatches, uint32_t _minItems = 1) const;
+
 		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
 		{
-			const uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t iboffset = offset + _num*_indexSize;
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
-			const uint32_t num = (iboffset-offset)/_indexSize;
-			return num;
+			uint32_t size = _num*_indexSize;
+			findTransient(m_iboffset, size, _indexSize, g_caps.limits.transientIbSize);
+			return size/_indexSize;
 		}
 
 		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t num    = getAvailTransientIndexBuffer(_num, _indexSize);
-			m_iboffset = offset + num*_indexSize;
-			_num = num;
+			uint32_t size = _num*_indexSize;
+			const uint32_t offset = reserveTransient(&m_iboffset, size, _indexSize, g_caps.limits.transientIbSize);
+			_num = size/_indexSize;
 
 			return offset;
 		}
 
 		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
+			uint32_t size = _num*_stride;
+			findTransient(m_vboffset, size, _stride, g_caps.limits.transientVbSize);
+			return size/_stride;
 		}
 
 		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
+			uint32_t size = _num*_stride;
+			const uint32_t offset = reserveTransient(&m_vboffset, size, _stride, g_caps.limits.transientVbSize);
+			_num = size/_stride;
 
 			return offset;
 		}
 
+		// Transient buffer offsets are in paged space, page N starts at offset
+		// N*_pageSize. Number of pages is limited so that whole space fits into
+		// 32-bit offset.
+		static uint32_t getTransientMaxPages(uint32_t _pageSize)
+		{
+			return bx::min<uint32_t>(BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES, UINT32_MAX/_pageSize);
+		}
+
+		// Number of pages touched by transient buffer offset, at least one.
+		static uint32_t getTransientNumPages(uint32_t _offset, uint32_t _pageSize)
+		{
+			const uint32_t num = _offset/_pageSize + (0 != _offset%_pageSize);
+			return bx::max<uint32_t>(num, 1);
+		}
+
+		// Number of bytes used in transient buffer page, 0 if page is not used.
+		static uint32_t getTransientPageUsed(uint32_t _offset, uint32_t _pageSize, uint32_t _page)
+		{
+			if (_page >= getTransientMaxPages(_pageSize) )
+			{
+				return 0;
+			}
+
+			const uint32_t begin = _page*_pageSize;
+			return _offset > begin ? bx::min(_offset - begin, _pageSize) : 0;
+		}
+
+		// Calls _fn(page, used) for every transient index buffer page used by
+		// frame, where used is number of bytes written into page.
+		template<typename UpdateFnT>
+		void updateTransientIndexBuffers(UpdateFnT _fn) const
+		{
+			updateTransientPages(m_transientIb, m_iboffset, g_caps.limits.transientIbSize, _fn);
+		}
+
+		template<typename UpdateFnT>
+		void updateTransientVertexBuffers(UpdateFnT _fn) const
+		{
+			updateTransientPages(m_transientVb, m_vboffset, g_caps.limits.transientVbSize, _fn);
+		}
+
+		template<typename Ty, typename UpdateFnT>
+		static void updateTransientPages(Ty* const* _page, uint32_t _offset, uint32_t _pageSize, UpdateFnT& _fn)
+		{
+			const uint32_t numPages = bx::min(
+				  getTransientNumPages(_offset, _pageSize)
+				, getTransientMaxPages(_pageSize)
+				);
+
+			for (uint32_t ii = 0; ii < numPages; ++ii)
+			{
+				const uint32_t used = getTransientPageUsed(_offset, _pageSize, ii);
+				const Ty* page = _page[ii];
+
+				if (0 < used
+				&&  NULL != page)
+				{
+					_fn(*page, used);
+				}
+			}
+		}
+
+		// Finds place for up to _size bytes after _current offset aligned to
+		// _align, _size is rounded down to multiple of _align. Allocation never
+		// straddles page boundary, when it doesn't fit into rest of the page it
+		// continues at start of the next page.
+		static uint32_t findTransient(uint32_t _current, uint32_t& _size, uint32_t _align, uint32_t _pageSize)
+		{
+			const uint32_t maxPages = getTransientMaxPages(_pageSize);
+
+			uint32_t page  = bx::min(_current/_pageSize, maxPages-1);
+			uint32_t local = bx::min(bx::strideAlign(_current - page*_pageSize, _align), _pageSize);
+
+			if (_size > _pageSize - local
+			&&  0 != local
+			&&  page+1 < maxPages)
+			{
+				++page;
+				local = 0;
+			}
+
+			_size = bx::min(_size, (_pageSize - local)/_align*_align);
+
+			return page*_pageSize + local;
+		}
+
+		// Same as findTransient, but also reserves found range. Encoders reserve
+		// transient buffer chunks concurrently, so offset is bumped atomically.
+		static uint32_t reserveTransient(uint32_t* _offset, uint32_t& _size, uint32_t _align, uint32_t _pageSize)
+		{
+			for (;;)
+			{
+				const uint32_t current = *(volatile uint32_t*)_offset;
+				uint32_t size = _size;
+				const uint32_t offset = findTransient(current, size, _align, _pageSize);
+
+				if (current == bx::atomicCompareAndSwap<uint32_t>(_offset, current, offset + size) )
+				{
+					_size = size;
+					return offset;
+				}
+			}
+		}
+
+		// Gives back unused tail [_next, _end) of reserved range. It succeeds
+		// only if range is still the last one reserved from buffer.
+		static bool releaseTransient(uint32_t* _offset, uint32_t _next, uint32_t _end)
+		{
+			return _next == _end
+				|| _end == bx::atomicCompareAndSwap<uint32_t>(_offset, _end, _next)
+				;
+		}
+
 		bool free(IndexBufferHandle _handle)
 		{
 			return m_freeIndexBuffer.queue(_handle);
@@ -2228,24 +2613,35 @@ namespace bgfx
 
 		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		uint64_t*        m_sortKeys;
+		RenderItemCount* m_sortValues;
+		RenderItem*      m_renderItem;
+		RenderBind*      m_renderItemBind;
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 
 		FrameCache m_frameCache;
 		UniformBuffer** m_uniformBuffer;
+		SortKeyBuffer*  m_sortKeyBuffer;
+		uint32_t*       m_sortKeyBound;
 
+		// While submitting it's number of reserved render items, after sort it's
+		// number of sorted keys.
 		uint32_t m_numRenderItems;
+
+		// Offset of first sorted render item for each view, valid after sort.
+		uint32_t m_viewOffset[BGFX_CONFIG_MAX_VIEWS+1];
+
 		uint16_t m_numBlitItems;
 
 		uint32_t m_iboffset;
 		uint32_t m_vboffset;
-		TransientIndexBuffer* m_transientIb;
-		TransientVertexBuffer* m_transientVb;
+
+		// Transient buffer pages, first page is always allocated, others are
+		// created on demand when frame runs out of space.
+		TransientIndexBuffer*  m_transientIb[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		TransientVertexBuffer* m_transientVb[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
 
 		Resolution m_resolution;
 		uint32_t m_debug;
@@ -2332,11 +2728,231 @@ namespace bgfx
 		bool m_capture;
 	};
 
+	// Maximum number of encoders that can be requested via `Init::limits.maxEncoders`.
+	constexpr uint16_t kMaxEncoders = 128;
+
+	// Number of render items encoder reserves from frame at once.
+	constexpr uint32_t kRenderItemChunkSize = 64;
+
+	// Maximum size of transient vertex and index buffer chunk encoder reserves
+	// from frame at once. Larger requests reserve chunk of their own size.
+	constexpr uint32_t kTransientChunkSize = 64<<10;
+
+	// Tracks number of transient buffer pages submitted frames need. Number
+	// of pages kept grows immediately, and shrinks back to what frames used
+	// once fewer pages were used for BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES
+	// frames in a row.
+	struct TransientPages
+	{
+		void reset()
+		{
+			m_max         = 0;
+			m_num         = 1;
+			m_numQuiet    = 1;
+			m_quietFrames = 0;
+		}
+
+		void update(uint32_t _used, uint32_t _pageSize)
+		{
+			m_max = bx::max(m_max, _used);
+
+			const uint16_t num = uint16_t(Frame::getTransientNumPages(_used, _pageSize) );
+
+			if (num >= m_num)
+			{
+				m_num         = num;
+				m_numQuiet    = 1;
+				m_quietFrames = 0;
+				return;
+			}
+
+			m_numQuiet = bx::max(m_numQuiet, num);
+
+			if (++m_quietFrames >= BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES)
+			{
+				m_num         = m_numQuiet;
+				m_numQuiet    = 1;
+				m_quietFrames = 0;
+			}
+		}
+
+		uint32_t m_max;         // Peak usage in single frame.
+		uint16_t m_num;         // Number of pages kept allocated.
+		uint16_t m_numQuiet;    // Most pages used while below m_num.
+		uint32_t m_quietFrames; // Frames in a row that used fewer than m_num pages.
+	};
+
+	// Encoder pool state is single atomic word: number of encoders allocated
+	// this frame, number of begin calls frame must wait to end, and lock bit
+	// set by frame while it's swapping.
+	constexpr uint32_t kEncoderPoolNumMask    = UINT32_C(0x000000ff);
+	constexpr uint32_t kEncoderPoolBeginShift = 8;
+	constexpr uint32_t kEncoderPoolBeginMask  = UINT32_C(0x7fffff00);
+	constexpr uint32_t kEncoderPoolLocked     = UINT32_C(0x80000000);
+	BX_STATIC_ASSERT(kMaxEncoders <= kEncoderPoolNumMask);
+
+	constexpr uint32_t kMaxDrawListHandles = bx::max<uint32_t>(
+		  bx::max<uint32_t>(
+			  bx::max<uint32_t>(BGFX_CONFIG_MAX_INDEX_BUFFERS, BGFX_CONFIG_MAX_VERTEX_BUFFERS)
+			, bx::max<uint32_t>(BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS, BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS)
+			)
+		, bx::max<uint32_t>(BGFX_CONFIG_MAX_PROGRAMS, bx::max<uint32_t>(BGFX_CONFIG_MAX_TEXTURES, BGFX_CONFIG_MAX_UNIFORMS) )
+		);
+
+	// Draw calls recorded once with `Encoder::record`. Everything that is
+	// stored per frame (transforms, scissor rects and uniforms) is copied
+	// into draw list, and indices in RenderDraw are relative to it. Handles
+	// are stored with their generation, draw list is dropped on submit if
+	// any of them was destroyed after recording.
+	struct DrawList
+	{
+		struct Resource
+		{
+			enum Enum
+			{
+				IndexBuffer,
+				VertexBuffer,
+				DynamicIndexBuffer,
+				DynamicVertexBuffer,
+				Program,
+				Texture,
+				Uniform,
+
+				Count
+			};
+		};
+
+		struct Item
+		{
+			RenderDraw    m_draw;
+			RenderBind    m_bind;
+			ProgramHandle m_program;
+			uint32_t      m_depth;
+			uint8_t       m_blend;
+		};
+
+		void create()
+		{
+			m_item        = NULL;
+			m_matrix      = NULL;
+			m_rect        = NULL;
+			m_uniform     = NULL;
+			m_maxItems    = 0;
+			m_maxMatrices = 0;
+			m_maxRects    = 0;
+			m_maxUniform  = 0;
+			reset();
+		}
+
+		void destroy()
+		{
+			if (NULL != m_item)    { BX_ALIGNED_FREE(g_allocator, m_item,    BX_ALIGNOF(Item)    ); }
+			if (NULL != m_matrix)  { BX_ALIGNED_FREE(g_allocator, m_matrix,  BX_ALIGNOF(Matrix4) ); }
+			if (NULL != m_rect)    { BX_ALIGNED_FREE(g_allocator, m_rect,    BX_ALIGNOF(Rect)    ); }
+			if (NULL != m_uniform) { BX_ALIGNED_FREE(g_allocator, m_uniform, BX_ALIGNOF(uint8_t) ); }
+			create();
+		}
+
+		void reset()
+		{
+			m_numItems    = 0;
+			m_numMatrices = 0;
+			m_numRects    = 0;
+			m_uniformSize = 0;
+			m_resource.clear();
+		}
+
+		// Remembers generation of first recorded use of handle.
+		void addResource(Resource::Enum _type, uint16_t _idx, uint16_t _gen)
+		{
+			if (kInvalidHandle != _idx)
+			{
+				m_resource.insert(stl::make_pair(uint32_t(_type)<<16 | _idx, _gen) );
+			}
+		}
+
+		template<typename Ty>
+		static Ty* append(Ty*& _data, uint32_t& _num, uint32_t& _max, uint32_t _count)
+		{
+			if (_num + _count > _max)
+			{
+				_max  = bx::max<uint32_t>(_num + _count, bx::max<uint32_t>(_max*2, 64) );
+				_data = (Ty*)BX_ALIGNED_REALLOC(g_allocator, _data, sizeof(Ty)*_max, BX_ALIGNOF(Ty) );
+			}
+
+			Ty* result = &_data[_num];
+			_num += _count;
+			return result;
+		}
+
+		Item*    m_item;
+		Matrix4* m_matrix; // First matrix is identity, and it's not stored.
+		Rect*    m_rect;
+		uint8_t* m_uniform;
+
+		uint32_t m_numItems;
+		uint32_t m_numMatrices;
+		uint32_t m_numRects;
+		uint32_t m_uniformSize;
+
+		uint32_t m_maxItems;
+		uint32_t m_maxMatrices;
+		uint32_t m_maxRects;
+		uint32_t m_maxUniform;
+
+		// Key is type<<16 | handle index, value is handle generation.
+		typedef stl::unordered_map<uint32_t, uint16_t> ResourceMap;
+		ResourceMap m_resource;
+	};
+
+	// Dynamic buffer handles set for current draw call. RenderDraw and
+	// RenderBind keep only handles of buffers dynamic buffers are allocated
+	// from, draw list records these to check generation on submit.
+	struct DynamicBufferBind
+	{
+		void clear(uint8_t _flags)
+		{
+			if (0 != (_flags & BGFX_DISCARD_INSTANCE_DATA) )
+			{
+				m_instanceDataBuffer.idx = kInvalidHandle;
+			}
+
+			if (0 != (_flags & BGFX_DISCARD_VERTEX_STREAMS) )
+			{
+				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
+				{
+					m_stream[ii].idx = kInvalidHandle;
+				}
+			}
+
+			if (0 != (_flags & BGFX_DISCARD_INDEX_BUFFER) )
+			{
+				m_indexBuffer.idx = kInvalidHandle;
+			}
+
+			if (0 != (_flags & BGFX_DISCARD_BINDINGS) )
+			{
+				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+				{
+					m_bind[ii] = kInvalidHandle;
+				}
+			}
+		}
+
+		DynamicIndexBufferHandle  m_indexBuffer;
+		DynamicVertexBufferHandle m_instanceDataBuffer;
+		DynamicVertexBufferHandle m_stream[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint16_t                  m_bind[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS]; // Dynamic index or vertex buffer, see Binding::m_type.
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
 	{
 		EncoderImpl()
+			: m_ownerFrame(UINT32_MAX)
+			, m_ownerTid(0)
 		{
 			discard(BGFX_DISCARD_ALL);
+			resetRenderItems();
 		}
 
         // Context::m_frame数组中其中一个 此时应该和 Context::m_submit 一致
@@ -2354,18 +2970,46 @@ namespace bgfx
 
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 			uniformBuffer->reset();
+			bx::memSet(m_uniformLastPos, 0xff, sizeof(m_uniformLastPos) );
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+			m_uniformBytesSaved = 0;
+
+			m_ownerFrame = UINT32_MAX;
+			m_ownerTid   = 0;
+		}
+
+		// Continue encoding with encoder that was already used and ended
+		// during this frame by the same thread.
+		void resume()
+		{
+			m_uniformBegin = m_uniformEnd;
+
+			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			uniformBuffer->reset(m_uniformEnd);
+
+			// Values written after m_uniformEnd are overwritten.
+			bx::memSet(m_uniformLastPos, 0xff, sizeof(m_uniformLastPos) );
 		}
 
 		void end(bool _finalize)
 		{
+			// Encoder can be resumed later in frame, it reserves new chunks then.
+			Frame::releaseTransient(&m_frame->m_iboffset, m_transientIbNext, m_transientIbEnd);
+			Frame::releaseTransient(&m_frame->m_vboffset, m_transientVbNext, m_transientVbEnd);
+			Frame::releaseTransient(&m_frame->m_numRenderItems, m_renderItemNext, m_renderItemEnd);
+			m_transientIbEnd = m_transientIbNext;
+			m_transientVbEnd = m_transientVbNext;
+			m_renderItemEnd  = m_renderItemNext;
+
 			if (_finalize)
 			{
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx]; // m_uniformIdx = 3 ?
 				uniformBuffer->finish(); // 这个算是encoder对应的 UniformBuffer  ---- Frame.m_uniformBuffer[encoder编号]
 
+				m_frame->m_sortKeyBuffer[m_uniformIdx].sort();
+
 				m_cpuTimeEnd = bx::getHPCounter();
 			}
 
@@ -2380,6 +3024,80 @@ namespace bgfx
 			}
 		}
 
+		// Called once all encoders ended, reserved render items and transient
+		// buffer chunks belong to frame that is about to be swapped.
+		void resetRenderItems()
+		{
+			m_renderItemNext = 0;
+			m_renderItemEnd  = 0;
+
+			m_transientVbNext = 0;
+			m_transientVbEnd  = 0;
+			m_transientIbNext = 0;
+			m_transientIbEnd  = 0;
+
+			m_transientLayoutHash = 0;
+		}
+
+		uint32_t allocRenderItem()
+		{
+			if (m_renderItemNext == m_renderItemEnd)
+			{
+				const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+				const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, kRenderItemChunkSize, maxDrawCalls);
+				if (maxDrawCalls <= first)
+				{
+					return UINT32_MAX;
+				}
+
+				m_renderItemNext = first;
+				m_renderItemEnd  = bx::min<uint32_t>(first + kRenderItemChunkSize, maxDrawCalls);
+			}
+
+			return m_renderItemNext++;
+		}
+
+		// Chunks are small enough that tails left by all encoders can't take
+		// more than 1/8 of page.
+		static uint32_t getTransientChunkSize(uint32_t _pageSize)
+		{
+			return bx::min<uint32_t>(kTransientChunkSize, _pageSize/(g_caps.limits.maxEncoders*8) );
+		}
+
+		// Sub-allocates _num items of _stride bytes from chunk reserved from
+		// frame transient buffer. When request doesn't fit, rest of the chunk is
+		// given back if no other encoder reserved after it, otherwise it's
+		// dropped, and new chunk is reserved. _num is set to number of allocated
+		// items, same as Frame::allocTransient*. Chunk never straddles page.
+		static uint32_t allocTransient(uint32_t& _next, uint32_t& _end, uint32_t* _frameOffset, uint32_t _pageSize, uint32_t& _num, uint16_t _stride)
+		{
+			const uint32_t size = _num*_stride;
+			uint32_t offset = bx::strideAlign(_next, _stride);
+
+			if (offset + size > _end)
+			{
+				Frame::releaseTransient(_frameOffset, _next, _end);
+
+				uint32_t chunkSize = bx::max(size, getTransientChunkSize(_pageSize) );
+				offset = Frame::reserveTransient(_frameOffset, chunkSize, _stride, _pageSize);
+
+				_end = offset + chunkSize;
+			}
+
+			const uint32_t num = bx::min(_num, (_end - offset)/_stride);
+			_next = offset + num*_stride;
+			_num  = num;
+
+			return offset;
+		}
+
+		TransientIndexBuffer*  getTransientIndexBufferPage(uint32_t _page);
+		TransientVertexBuffer* getTransientVertexBufferPage(uint32_t _page);
+
+		void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32);
+		void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout);
+		void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride);
+
 		void setMarker(const char* _name)
 		{
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
@@ -2401,6 +3119,21 @@ namespace bgfx
             // 当前Frame* m_frame 就是  Context::m_submit   Frame中对应分配给这个Encoder的UniformBuffer  m_uniformIdx
 			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+
+			// When value didn't change since it was last written by this
+			// encoder, only reference to previous value is written.
+			const uint32_t size = g_uniformTypeSize[_type]*_num;
+			const uint32_t last = m_uniformLastPos[_handle.idx];
+			if (sizeof(uint32_t) < size
+			&&  UINT32_MAX != last
+			&&  uniformBuffer->isUniformEqual(last, _type, _handle.idx, _value, _num) )
+			{
+				uniformBuffer->writeUniformRef(_type, _handle.idx, last, _num);
+				m_uniformBytesSaved += size - sizeof(uint32_t);
+				return;
+			}
+
+			m_uniformLastPos[_handle.idx] = uniformBuffer->getPos() + sizeof(uint32_t);
 			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num); // 编码指令   RenderContext::commit(UniformBuffer) 中执行
 		}
 
@@ -2454,14 +3187,27 @@ namespace bgfx
 			return first;
 		}
 
+		// Doesn't modify m_draw, following submits reference matrices with
+		// setTransform(first+ii).
+		uint32_t allocTransformSrt(const TransformSrt* _srt, uint16_t _num)
+		{
+			return m_frame->m_frameCache.m_matrixCache.addSrt(_srt, _num);
+		}
+
+		uint32_t allocTransform4x3(const Transform4x3* _mtx, uint16_t _num)
+		{
+			return m_frame->m_frameCache.m_matrixCache.add4x3(_mtx, _num);
+		}
+
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
-			BX_ASSERT(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			const uint32_t max = m_frame->m_frameCache.m_matrixCache.m_max;
+			BX_ASSERT(_cache < max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, max
 				);
 			m_draw.m_startMatrix = _cache;
-			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
+			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, max-1) - _cache);
 		}
 
 		void setIndexBuffer(IndexBufferHandle _handle, const IndexBuffer& _ib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2471,9 +3217,10 @@ namespace bgfx
 			m_draw.m_numIndices  = _numIndices;
 			m_draw.m_indexBuffer = _handle;
 			m_draw.m_submitFlags |= 0 == (_ib.m_flags & BGFX_BUFFER_INDEX32) ? BGFX_SUBMIT_INTERNAL_NONE : BGFX_SUBMIT_INTERNAL_INDEX32;
+			m_dynamic.m_indexBuffer.idx = kInvalidHandle;
 		}
 
-		void setIndexBuffer(const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
+		void setIndexBuffer(DynamicIndexBufferHandle _handle, const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
 		{
 			BX_ASSERT(UINT8_MAX != m_draw.m_streamMask, "bgfx::setVertexCount was already called for this draw call.");
 			const uint32_t indexSize = 0 == (_dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
@@ -2481,6 +3228,7 @@ namespace bgfx
 			m_draw.m_numIndices  = bx::min(_numIndices, _dib.m_size/indexSize);
 			m_draw.m_indexBuffer = _dib.m_handle;
 			m_draw.m_submitFlags |= 0 == (_dib.m_flags & BGFX_BUFFER_INDEX32) ? BGFX_SUBMIT_INTERNAL_NONE : BGFX_SUBMIT_INTERNAL_INDEX32;
+			m_dynamic.m_indexBuffer = _handle;
 		}
 
 		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2493,6 +3241,7 @@ namespace bgfx
 			m_draw.m_numIndices  = numIndices;
 			m_draw.m_submitFlags |= _tib->isIndex16 ? BGFX_SUBMIT_INTERNAL_NONE : BGFX_SUBMIT_INTERNAL_INDEX32;
 			m_discard            = 0 == numIndices;
+			m_dynamic.m_indexBuffer.idx = kInvalidHandle;
 		}
 
 		void setVertexBuffer(
@@ -2513,10 +3262,13 @@ namespace bgfx
 				stream.m_layoutHandle  = _layoutHandle;
 				m_numVertices[_stream] = _numVertices;
 			}
+
+			m_dynamic.m_stream[_stream].idx = kInvalidHandle;
 		}
 
 		void setVertexBuffer(
 			  uint8_t _stream
+			, DynamicVertexBufferHandle _handle
 			, const DynamicVertexBuffer& _dvb
 			, uint32_t _startVertex
 			, uint32_t _numVertices
@@ -2535,6 +3287,8 @@ namespace bgfx
 					bx::min(bx::uint32_imax(0, _dvb.m_numVertices - _startVertex), _numVertices)
 					;
 			}
+
+			m_dynamic.m_stream[_stream] = _handle;
 		}
 
 		void setVertexBuffer(
@@ -2555,6 +3309,8 @@ namespace bgfx
 				stream.m_layoutHandle  = isValid(_layoutHandle) ? _layoutHandle : _tvb->layoutHandle;
 				m_numVertices[_stream] = bx::min(bx::uint32_imax(0, _tvb->size/_tvb->stride - _startVertex), _numVertices);
 			}
+
+			m_dynamic.m_stream[_stream].idx = kInvalidHandle;
 		}
 
 		void setVertexCount(uint32_t _numVertices)
@@ -2576,6 +3332,7 @@ namespace bgfx
 			m_draw.m_instanceDataStride = _idb->stride;
 			m_draw.m_numInstances       = num;
 			m_draw.m_instanceDataBuffer = _idb->handle;
+			m_dynamic.m_instanceDataBuffer.idx = kInvalidHandle;
 		}
 
 		void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num, uint16_t _stride)
@@ -2584,6 +3341,13 @@ namespace bgfx
 			m_draw.m_instanceDataStride = _stride;
 			m_draw.m_numInstances       = _num;
 			m_draw.m_instanceDataBuffer = _handle;
+			m_dynamic.m_instanceDataBuffer.idx = kInvalidHandle;
+		}
+
+		void setInstanceDataBuffer(DynamicVertexBufferHandle _handle, const DynamicVertexBuffer& _dvb, uint32_t _startVertex, uint32_t _num)
+		{
+			setInstanceDataBuffer(_dvb.m_handle, _dvb.m_startVertex + _startVertex, _num, _dvb.m_stride);
+			m_dynamic.m_instanceDataBuffer = _handle;
 		}
 
 		void setInstanceCount(uint32_t _numInstances)
@@ -2601,6 +3365,7 @@ namespace bgfx
 				? BGFX_SAMPLER_INTERNAL_DEFAULT
 				: _flags
 				;
+			m_dynamic.m_bind[_stage] = kInvalidHandle;
 
 			if (isValid(_sampler) )
 			{
@@ -2617,6 +3382,13 @@ namespace bgfx
 			bind.m_format = 0;
 			bind.m_access = uint8_t(_access);
 			bind.m_mip    = 0;
+			m_dynamic.m_bind[_stage] = kInvalidHandle;
+		}
+
+		void setBuffer(uint8_t _stage, DynamicIndexBufferHandle _handle, const DynamicIndexBuffer& _dib, Access::Enum _access)
+		{
+			setBuffer(_stage, _dib.m_handle, _access);
+			m_dynamic.m_bind[_stage] = _handle.idx;
 		}
 
 		void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access)
@@ -2627,6 +3399,13 @@ namespace bgfx
 			bind.m_format = 0;
 			bind.m_access = uint8_t(_access);
 			bind.m_mip    = 0;
+			m_dynamic.m_bind[_stage] = kInvalidHandle;
+		}
+
+		void setBuffer(uint8_t _stage, DynamicVertexBufferHandle _handle, const DynamicVertexBuffer& _dvb, Access::Enum _access)
+		{
+			setBuffer(_stage, _dvb.m_handle, _access);
+			m_dynamic.m_bind[_stage] = _handle.idx;
 		}
 
 		void setImage(uint8_t _stage, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format)
@@ -2637,6 +3416,7 @@ namespace bgfx
 			bind.m_format = uint8_t(_format);
 			bind.m_access = uint8_t(_access);
 			bind.m_mip    = _mip;
+			m_dynamic.m_bind[_stage] = kInvalidHandle;
 		}
 
 		void discard(uint8_t _flags)
@@ -2650,6 +3430,7 @@ namespace bgfx
 			m_draw.clear(_flags);
 			m_compute.clear(_flags);
 			m_bind.clear(_flags);
+			m_dynamic.clear(_flags);
 		}
 
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags);
@@ -2675,6 +3456,33 @@ namespace bgfx
 
 		void blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
 
+		void record(DrawList& _drawList, ProgramHandle _program, uint32_t _depth, uint8_t _flags);
+
+		void submit(ViewId _id, const DrawList& _drawList, uint32_t _depth);
+		void recordResources(DrawList& _drawList, const DrawList::Item& _item);
+
+		uint32_t getNumVertices() const
+		{
+			if (UINT8_MAX != m_draw.m_streamMask)
+			{
+				uint32_t numVertices = UINT32_MAX;
+				for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+					numVertices = bx::min(numVertices, m_numVertices[idx]);
+				}
+
+				return numVertices;
+			}
+
+			return m_numVertices[0];
+		}
+
 		Frame* m_frame;
 
 		SortKey m_key;
@@ -2683,21 +3491,46 @@ namespace bgfx
 		RenderCompute m_compute;
 		RenderBind    m_bind;
 
+		DynamicBufferBind m_dynamic;
+
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
+		uint32_t m_renderItemNext;
+		uint32_t m_renderItemEnd;
+
+		uint32_t m_transientVbNext;
+		uint32_t m_transientVbEnd;
+		uint32_t m_transientIbNext;
+		uint32_t m_transientIbEnd;
+
+		// Last vertex layout used for transient vertex buffer, saves taking
+		// resource API lock to find layout handle.
+		uint32_t           m_transientLayoutHash;
+		VertexLayoutHandle m_transientLayout;
+
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
 		uint8_t  m_uniformIdx;
 		bool     m_discard;
 
+		// Position of last value written for each uniform in encoder uniform
+		// buffer, UINT32_MAX when it's not written yet.
+		uint32_t m_uniformLastPos[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_uniformBytesSaved;
+
 		typedef stl::unordered_set<uint16_t> HandleSet;
 		HandleSet m_uniformSet;
 		HandleSet m_occlusionQuerySet;
 
 		int64_t m_cpuTimeBegin;
 		int64_t m_cpuTimeEnd;
+
+		// Frame number and thread that took encoder from pool, thread encoder
+		// cache hands encoder out again only when both match.
+		uint32_t m_ownerFrame;
+		uint32_t m_ownerTid;
 	};
 
 	struct VertexLayoutRef  // VertexLayoutRef  包含了 m_vertexLayoutMap 通过layout的hash来找 layout句柄 VertexLayoutHandle
@@ -2801,14 +3634,27 @@ namespace bgfx
 		VertexLayoutHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 	};
 
-	// First-fit non-local allocator.
+	// Two-level segregated fit (TLSF) allocator for space in memory that's not
+	// directly accessible. Pointer is buffer handle in upper 32 bits and offset
+	// in lower 32 bits. Alloc and free are O(1), free block is coalesced with
+	// its neighbours immediately, so compact is no-op.
 	class NonLocalAllocator
 	{
 	public:
 		static const uint64_t kInvalidBlock = UINT64_MAX;
 
+		struct Stats
+		{
+			uint64_t totalSize;    // Size of all added blocks.
+			uint64_t freeSize;     // Size of all free blocks.
+			uint32_t largestFree;  // Size of largest free block.
+			uint32_t numFree;      // Number of free blocks.
+			uint32_t numUsed;      // Number of allocated blocks.
+		};
+
 		NonLocalAllocator()
 		{
+			reset();
 		}
 
 		~NonLocalAllocator()
@@ -2817,113 +3663,428 @@ namespace bgfx
 
 		void reset()
 		{
-			m_free.clear();
+			m_block.clear();
 			m_used.clear();
+
+			m_unused    = kInvalidIndex;
+			m_flBitmap  = 0;
+			m_totalSize = 0;
+			m_freeSize  = 0;
+			m_numFree   = 0;
+
+			bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+			bx::memSet(m_freeHead, 0xff, sizeof(m_freeHead) );
 		}
 
-		void add(uint64_t _ptr, uint32_t _size)
-		{
-			m_free.push_back(Free(_ptr, _size) );
+		void add(uint64_t _ptr, uint32_t _size)
+		{
+			const uint32_t idx = allocNode();
+
+			Block& block = m_block[idx];
+			block.m_ptr      = _ptr;
+			block.m_size     = _size;
+			block.m_prevPhys = kInvalidIndex;
+			block.m_nextPhys = kInvalidIndex;
+
+			m_totalSize += _size;
+			insertFree(idx);
+		}
+
+		// Removes one of added blocks, only valid when nothing is allocated.
+		uint64_t remove()
+		{
+			BX_ASSERT(0 == m_used.size(), "");
+
+			for (uint32_t ii = 0, num = uint32_t(m_block.size() ); ii < num; ++ii)
+			{
+				const Block& block = m_block[ii];
+
+				if (BlockState::Free == block.m_state)
+				{
+					const uint64_t ptr = block.m_ptr;
+					m_totalSize -= block.m_size;
+					removeFree(ii);
+					freeNode(ii);
+					return ptr;
+				}
+			}
+
+			return 0;
+		}
+
+		uint64_t alloc(uint32_t _size)
+		{
+			if (_size > UINT32_MAX - kMinBlockSize)
+			{
+				return kInvalidBlock;
+			}
+
+			const uint32_t size = bx::alignUp(_size < kMinBlockSize ? uint32_t(kMinBlockSize) : _size, kMinBlockSize);
+
+			uint32_t fl;
+			uint32_t sl;
+			if (!findFree(size, fl, sl) )
+			{
+				// there is no block large enough.
+				return kInvalidBlock;
+			}
+
+			const uint32_t idx = m_freeHead[fl][sl];
+			removeFree(idx);
+
+			return use(idx, size);
+		}
+
+		// Allocates block with pointer aligned to _align, which must be power
+		// of two. Space skipped to align pointer stays free.
+		uint64_t alloc(uint32_t _size, uint32_t _align)
+		{
+			if (_align <= kMinBlockSize)
+			{
+				return alloc(_size);
+			}
+
+			if (_size > UINT32_MAX - _align)
+			{
+				return kInvalidBlock;
+			}
+
+			const uint32_t size = bx::alignUp(_size < kMinBlockSize ? uint32_t(kMinBlockSize) : _size, kMinBlockSize);
+
+			// Pointers are multiple of kMinBlockSize, aligning skips at most
+			// _align-kMinBlockSize bytes.
+			uint32_t fl;
+			uint32_t sl;
+			if (!findFree(size + _align - kMinBlockSize, fl, sl) )
+			{
+				return kInvalidBlock;
+			}
+
+			uint32_t idx = m_freeHead[fl][sl];
+			removeFree(idx);
+
+			const uint64_t ptr = m_block[idx].m_ptr;
+			const uint32_t pad = uint32_t( ( (ptr + _align - 1) & ~uint64_t(_align - 1) ) - ptr);
+
+			if (0 != pad)
+			{
+				// Node array might grow, take block reference after allocating node.
+				const uint32_t alignedIdx = allocNode();
+				Block& block   = m_block[idx];
+				Block& aligned = m_block[alignedIdx];
+
+				aligned.m_ptr      = block.m_ptr + pad;
+				aligned.m_size     = block.m_size - pad;
+				aligned.m_prevPhys = idx;
+				aligned.m_nextPhys = block.m_nextPhys;
+
+				if (kInvalidIndex != block.m_nextPhys)
+				{
+					m_block[block.m_nextPhys].m_prevPhys = alignedIdx;
+				}
+
+				block.m_size     = pad;
+				block.m_nextPhys = alignedIdx;
+
+				insertFree(idx);
+				idx = alignedIdx;
+			}
+
+			return use(idx, size);
+		}
+
+		void free(uint64_t _block)
+		{
+			UsedList::iterator it = m_used.find(_block);
+			if (it == m_used.end() )
+			{
+				return;
+			}
+
+			uint32_t idx = it->second;
+			m_used.erase(it);
+
+			const uint32_t next = m_block[idx].m_nextPhys;
+			if (kInvalidIndex != next
+			&&  BlockState::Free == m_block[next].m_state)
+			{
+				removeFree(next);
+				merge(idx, next);
+			}
+
+			const uint32_t prev = m_block[idx].m_prevPhys;
+			if (kInvalidIndex != prev
+			&&  BlockState::Free == m_block[prev].m_state)
+			{
+				removeFree(prev);
+				merge(prev, idx);
+				idx = prev;
+			}
+
+			insertFree(idx);
+		}
+
+		// Free blocks are coalesced on free, returns true when nothing is
+		// allocated and all added blocks can be removed.
+		bool compact()
+		{
+			return 0 == m_used.size();
+		}
+
+		void getStats(Stats& _stats) const
+		{
+			_stats.totalSize   = m_totalSize;
+			_stats.freeSize    = m_freeSize;
+			_stats.largestFree = 0;
+			_stats.numFree     = m_numFree;
+			_stats.numUsed     = uint32_t(m_used.size() );
+
+			if (0 != m_flBitmap)
+			{
+				// Largest free block is in highest non-empty size class.
+				const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+				const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+
+				for (uint32_t idx = m_freeHead[fl][sl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+				{
+					_stats.largestFree = bx::max(_stats.largestFree, m_block[idx].m_size);
+				}
+			}
+		}
+
+	private:
+		static constexpr uint32_t kInvalidIndex     = UINT32_MAX;
+		static constexpr uint32_t kMinBlockSizeLog2 = 4;
+		static constexpr uint32_t kMinBlockSize     = 1<<kMinBlockSizeLog2;
+		static constexpr uint32_t kSlCountLog2      = 4;
+		static constexpr uint32_t kSlCount          = 1<<kSlCountLog2;
+		static constexpr uint32_t kFlCount          = 32 - kMinBlockSizeLog2 - kSlCountLog2 + 1;
+
+		struct BlockState
+		{
+			enum Enum
+			{
+				Unused,
+				Free,
+				Used,
+			};
+		};
+
+		struct Block
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys; // Neighbour blocks in the same buffer.
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree; // Free list links, or unused node list link.
+			uint32_t m_nextFree;
+			BlockState::Enum m_state;
+		};
+
+		// First level is power of two size class, second level splits it into
+		// kSlCount linear classes. Sizes below kSlCount*kMinBlockSize are in
+		// first level 0.
+		static void mapping(uint32_t _units, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_units < kSlCount)
+			{
+				_fl = 0;
+				_sl = _units;
+			}
+			else
+			{
+				const uint32_t log2 = 31 - bx::uint32_cntlz(_units);
+				_fl = log2 - kSlCountLog2 + 1;
+				_sl = (_units >> (log2 - kSlCountLog2) ) - kSlCount;
+			}
+		}
+
+		// Finds non-empty size class where every block is at least _size.
+		bool findFree(uint32_t _size, uint32_t& _fl, uint32_t& _sl) const
+		{
+			uint32_t units = _size >> kMinBlockSizeLog2;
+			if (units >= kSlCount)
+			{
+				// Round up to next size class.
+				const uint32_t log2 = 31 - bx::uint32_cntlz(units);
+				units += (UINT32_C(1) << (log2 - kSlCountLog2) ) - 1;
+			}
+
+			mapping(units, _fl, _sl);
+			if (_fl >= kFlCount)
+			{
+				return false;
+			}
+
+			uint32_t slMap = m_slBitmap[_fl] & (UINT32_MAX << _sl);
+			if (0 == slMap)
+			{
+				const uint32_t flMap = m_flBitmap & (UINT32_MAX << (_fl + 1) );
+				if (0 == flMap)
+				{
+					return false;
+				}
+
+				_fl   = bx::uint32_cnttz(flMap);
+				slMap = m_slBitmap[_fl];
+			}
+
+			_sl = bx::uint32_cnttz(slMap);
+
+			return true;
 		}
 
-		uint64_t remove()
+		void insertFree(uint32_t _idx)
 		{
-			BX_ASSERT(0 == m_used.size(), "");
+			Block& block = m_block[_idx];
+
+			uint32_t fl;
+			uint32_t sl;
+			mapping(block.m_size >> kMinBlockSizeLog2, fl, sl);
+
+			const uint32_t head = m_freeHead[fl][sl];
+			block.m_state    = BlockState::Free;
+			block.m_prevFree = kInvalidIndex;
+			block.m_nextFree = head;
 
-			if (0 < m_free.size() )
+			if (kInvalidIndex != head)
 			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
+				m_block[head].m_prevFree = _idx;
 			}
 
-			return 0;
+			m_freeHead[fl][sl] = _idx;
+			m_slBitmap[fl] |= UINT32_C(1) << sl;
+			m_flBitmap     |= UINT32_C(1) << fl;
+
+			m_freeSize += block.m_size;
+			++m_numFree;
 		}
 
-		uint64_t alloc(uint32_t _size)
+		void removeFree(uint32_t _idx)
 		{
-			_size = bx::max(_size, 16u);
+			Block& block = m_block[_idx];
+
+			uint32_t fl;
+			uint32_t sl;
+			mapping(block.m_size >> kMinBlockSizeLog2, fl, sl);
 
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			if (kInvalidIndex != block.m_prevFree)
 			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
+				m_block[block.m_prevFree].m_nextFree = block.m_nextFree;
+			}
+			else
+			{
+				m_freeHead[fl][sl] = block.m_nextFree;
 
-					m_used.insert(stl::make_pair(ptr, _size) );
+				if (kInvalidIndex == block.m_nextFree)
+				{
+					m_slBitmap[fl] &= ~(UINT32_C(1) << sl);
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
+					if (0 == m_slBitmap[fl])
 					{
-						m_free.erase(it);
+						m_flBitmap &= ~(UINT32_C(1) << fl);
 					}
-
-					return ptr;
 				}
 			}
 
-			// there is no block large enough.
-			return kInvalidBlock;
-		}
-
-		void free(uint64_t _block)
-		{
-			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
+			if (kInvalidIndex != block.m_nextFree)
 			{
-				m_free.push_front(Free(it->first, it->second) );
-				m_used.erase(it);
+				m_block[block.m_nextFree].m_prevFree = block.m_prevFree;
 			}
+
+			block.m_state = BlockState::Used;
+
+			m_freeSize -= block.m_size;
+			--m_numFree;
 		}
 
-		bool compact()
+		// Marks free node _idx as used, tail beyond _size is split off into
+		// new free block.
+		uint64_t use(uint32_t _idx, uint32_t _size)
 		{
-			m_free.sort();
-
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
+			if (m_block[_idx].m_size - _size >= kMinBlockSize)
 			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
-				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
-				}
-				else
+				// Node array might grow, take block reference after allocating node.
+				const uint32_t restIdx = allocNode();
+				Block& block = m_block[_idx];
+				Block& rest  = m_block[restIdx];
+
+				rest.m_ptr      = block.m_ptr + _size;
+				rest.m_size     = block.m_size - _size;
+				rest.m_prevPhys = _idx;
+				rest.m_nextPhys = block.m_nextPhys;
+
+				if (kInvalidIndex != block.m_nextPhys)
 				{
-					it = next;
-					++next;
+					m_block[block.m_nextPhys].m_prevPhys = restIdx;
 				}
+
+				block.m_size     = _size;
+				block.m_nextPhys = restIdx;
+
+				insertFree(restIdx);
 			}
 
-			return 0 == m_used.size();
+			Block& block = m_block[_idx];
+			block.m_state = BlockState::Used;
+			m_used.insert(stl::make_pair(block.m_ptr, _idx) );
+
+			return block.m_ptr;
 		}
 
-	private:
-		struct Free
+		// Merges _next block into physically preceding _idx block.
+		void merge(uint32_t _idx, uint32_t _next)
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
+			Block& block = m_block[_idx];
+			const Block& next = m_block[_next];
+
+			block.m_size    += next.m_size;
+			block.m_nextPhys = next.m_nextPhys;
+
+			if (kInvalidIndex != next.m_nextPhys)
 			{
+				m_block[next.m_nextPhys].m_prevPhys = _idx;
 			}
 
-			bool operator<(const Free& rhs) const
+			freeNode(_next);
+		}
+
+		uint32_t allocNode()
+		{
+			if (kInvalidIndex != m_unused)
 			{
-				return m_ptr < rhs.m_ptr;
+				const uint32_t idx = m_unused;
+				m_unused = m_block[idx].m_nextFree;
+				return idx;
 			}
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+			const uint32_t idx = uint32_t(m_block.size() );
+			m_block.push_back(Block() );
+			return idx;
+		}
+
+		void freeNode(uint32_t _idx)
+		{
+			Block& block = m_block[_idx];
+			block.m_state    = BlockState::Unused;
+			block.m_nextFree = m_unused;
+			m_unused = _idx;
+		}
 
-		typedef stl::list<Free> FreeList;
-		FreeList m_free;
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
+		uint32_t   m_unused;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
+
+		uint32_t m_flBitmap;
+		uint32_t m_slBitmap[kFlCount];
+		uint32_t m_freeHead[kFlCount][kSlCount];
+
+		uint64_t m_totalSize;
+		uint64_t m_freeSize;
+		uint32_t m_numFree;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -2932,6 +4093,7 @@ namespace bgfx
 		virtual RendererType::Enum getRendererType() const = 0;
 		virtual const char* getRendererName() const = 0;
 		virtual bool isDeviceRemoved() = 0;
+		virtual uint32_t getReadBackLatency() const = 0;
 		virtual void flip() = 0;
 		virtual void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) = 0;
 		virtual void destroyIndexBuffer(IndexBufferHandle _handle) = 0;
@@ -2977,10 +4139,132 @@ namespace bgfx
 	inline RendererContextI::~RendererContextI()
 	{
 	}
+
+	// Fixed size pool of worker threads. Calling thread participates in work,
+	// so pool with zero threads executes everything inline.
+	class JobPool
+	{
+	public:
+		typedef void (*JobFn)(void* _userData, uint32_t _idx);
+
+		JobPool();
+
+		void init(uint32_t _numThreads);
+		void shutdown();
+
+		// Invokes _fn for each index in [0, _num), blocks until all jobs are done.
+		void parallelFor(JobFn _fn, void* _userData, uint32_t _num);
+
+		uint32_t getNumThreads() const
+		{
+			return m_numThreads;
+		}
+
+	private:
+		void execute();
+
+#if BGFX_CONFIG_MULTITHREADED
+		static int32_t workerThread(bx::Thread* _self, void* _userData);
+
+		bx::Thread    m_thread[BGFX_CONFIG_MAX_WORKER_THREADS+1];
+		bx::Semaphore m_kick;
+		bx::Semaphore m_done;
+		bx::Mutex     m_lock;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		JobFn    m_fn;
+		void*    m_userData;
+		uint32_t m_num;
+		uint32_t m_next;
+		uint32_t m_numThreads;
+		bool     m_exit;
+	};
+
+	// Background threads for asynchronous texture creation. Image parse and
+	// software decode of formats renderer can't sample natively run on loader
+	// thread, render thread only creates API object. Loader with zero threads
+	// executes requests inline. Source memory of decoded texture is released
+	// on loader thread, so user ReleaseFn is called from it, which is allowed
+	// since ReleaseFn must be callable from any thread.
+	class ResourceLoader
+	{
+	public:
+		ResourceLoader();
+
+		void init(uint32_t _numThreads);
+		void shutdown();
+
+		// Must be called with resource API lock held. Takes ownership of _mem,
+		// CreateTexture command is issued once CPU side work is done. Returns
+		// request index, or UINT16_MAX if request was completed inline.
+		uint16_t createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip);
+
+		// Must be called with resource API lock held. Result of canceled
+		// request is released instead of being passed to renderer.
+		void cancel(uint16_t _idx);
+
+	private:
+		struct Request
+		{
+			const Memory* m_mem;
+			uint64_t      m_flags;
+			TextureHandle m_handle;
+			uint8_t       m_skip;
+			bool          m_decoded;
+			bool          m_canceled;
+		};
+
+		void process(uint16_t _idx);
+		void complete(uint16_t _idx);
+
+#if BGFX_CONFIG_MULTITHREADED
+		static int32_t loaderThread(bx::Thread* _self, void* _userData);
+
+		bx::Thread    m_thread[BGFX_CONFIG_MAX_LOADER_THREADS+1];
+		bx::Semaphore m_kick;
+		bx::Mutex     m_lock;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		bx::HandleAllocT<BGFX_CONFIG_MAX_TEXTURES> m_requestHandle;
+		Request  m_request[BGFX_CONFIG_MAX_TEXTURES];
+		uint16_t m_queue[BGFX_CONFIG_MAX_TEXTURES];
+		uint32_t m_read;
+		uint32_t m_write;
+		uint32_t m_numThreads;
+		bool     m_exit;
+	};
     
     //
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
 
+	// Worker threads shared with frame sort, renderer can use them to translate
+	// view batches in parallel.
+	JobPool& getJobPool();
+
+	struct ImageDecodeMip
+	{
+		uint8_t* data;   // NULL when mip is not present in image.
+		uint32_t width;  // Mip size in whole blocks, as returned by bimg::imageGetRawData.
+		uint32_t height;
+		uint32_t depth;
+		uint32_t pitch;
+		uint32_t size;
+	};
+
+	// Decodes texture renderer can't sample natively to RGBA8 or BGRA8 on job
+	// pool, each side and mip is separate job. Result for side/mip pair is in
+	// _mips[side*_numMips + lod]. Decoded mips are stored in returned block,
+	// which caller frees with BX_FREE.
+	uint8_t* imageDecodeParallel(
+		  ImageDecodeMip* _mips
+		, const bimg::ImageContainer& _imageContainer
+		, const Memory* _mem
+		, uint16_t _numSides
+		, uint8_t _startLod
+		, uint8_t _numMips
+		, bimg::TextureFormat::Enum _dstFormat
+		);
+
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
 #else
@@ -2993,16 +4277,22 @@ namespace bgfx
 
 		Context()
 			: m_render(&m_frame[0])
-			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			, m_submit(&m_frame[0])
+			, m_numFrames(1)
+			, m_readBackLatency(0)
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
+			, m_numFreeDrawListHandles(0)
 			, m_colorPaletteDirty(0)
 			, m_frames(0)
 			, m_debug(BGFX_DEBUG_NONE)
 			, m_rtMemoryUsed(0)
 			, m_textureMemoryUsed(0)
 			, m_renderCtx(NULL)
+			, m_frameCapture(NULL)
+			, m_frameReplay(NULL)
+			, m_renderTid(UINT32_MAX)
 			, m_rendererInitialized(false)
 			, m_exit(false)
 			, m_flipAfterRender(false)
@@ -3132,6 +4422,18 @@ namespace bgfx
 			stats.textWidth  = tvm->m_width;
 			stats.textHeight = tvm->m_height;
 			stats.encoderStats = m_encoderStats;
+			stats.transientVbMax   = int32_t(m_transientVbPages.m_max);
+			stats.transientIbMax   = int32_t(m_transientIbPages.m_max);
+			stats.transientVbPages = m_transientVbPages.m_num;
+			stats.transientIbPages = m_transientIbPages.m_num;
+
+			NonLocalAllocator::Stats allocStats;
+			m_dynVertexBufferAllocator.getStats(allocStats);
+			stats.dynamicVbFree        = int64_t(allocStats.freeSize);
+			stats.dynamicVbLargestFree = allocStats.largestFree;
+			m_dynIndexBufferAllocator.getStats(allocStats);
+			stats.dynamicIbFree        = int64_t(allocStats.freeSize);
+			stats.dynamicIbLargestFree = allocStats.largestFree;
 
 			stats.numDynamicIndexBuffers  = m_dynamicIndexBufferHandle.getNumHandles();
 			stats.numDynamicVertexBuffers = m_dynamicVertexBufferHandle.getNumHandles();
@@ -3201,6 +4503,7 @@ namespace bgfx
 
 			IndexBuffer& ref = m_indexBuffers[_handle.idx]; // IndexBuffer 也只是个名字 大小和 type
 			ref.m_name.clear(); // 把名字清除了 还是在 m_indexBuffers中
+			++m_handleGen[DrawList::Resource::IndexBuffer][_handle.idx];
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyIndexBuffer); // 这个还是Frame* m_submit  但是是mCmdPost 执行渲染后的命令
 			cmdbuf.write(_handle); // 删除index buffer 加入到命令中 _handle给定句柄
@@ -3321,6 +4624,7 @@ namespace bgfx
 
 			VertexBuffer& ref = m_vertexBuffers[_handle.idx];
 			ref.m_name.clear(); // VertexBuffer 有什么作用的 ??  只是把名字清除了 ??
+			++m_handleGen[DrawList::Resource::VertexBuffer][_handle.idx];
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexBuffer);
 			cmdbuf.write(_handle);
@@ -3334,7 +4638,7 @@ namespace bgfx
 			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				getNextFrame(m_submit)->free(layoutHandle);
 			}
 
 			m_vertexBufferHandle.free(_handle.idx);
@@ -3459,7 +4763,6 @@ namespace bgfx
 			&&  0 != (dib.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
-				m_dynIndexBufferAllocator.compact();
 
 				const uint64_t ptr = (0 != (dib.m_flags & BGFX_BUFFER_COMPUTE_READ) )
 					? allocIndexBuffer(_mem->size, dib.m_flags)
@@ -3494,6 +4797,7 @@ namespace bgfx
 
 			BGFX_CHECK_HANDLE("destroyDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
+			++m_handleGen[DrawList::Resource::DynamicIndexBuffer][_handle.idx];
 			m_freeDynamicIndexBufferHandle[m_numFreeDynamicIndexBufferHandles++] = _handle;
 		}
 
@@ -3651,7 +4955,6 @@ namespace bgfx
 			&&  0 != (dvb.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
-				m_dynVertexBufferAllocator.compact();
 
 				const uint32_t size = bx::strideAlign<16>(_mem->size, dvb.m_stride)+dvb.m_stride;
 
@@ -3690,6 +4993,7 @@ namespace bgfx
 
 			BGFX_CHECK_HANDLE("destroyDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
+			++m_handleGen[DrawList::Resource::DynamicVertexBuffer][_handle.idx];
 			m_freeDynamicVertexBufferHandle[m_numFreeDynamicVertexBufferHandles++] = _handle;
 		}
 
@@ -3702,7 +5006,7 @@ namespace bgfx
 			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				getNextFrame(m_submit)->free(layoutHandle);
 			}
 
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
@@ -3787,14 +5091,22 @@ namespace bgfx
 
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
+			const uint32_t pageSize  = g_caps.limits.transientIbSize;
 			const uint32_t offset    = m_submit->allocTransientIndexBuffer(_num, indexSize);
+			uint32_t local = offset % pageSize;
 
-			TransientIndexBuffer& tib = *m_submit->m_transientIb;
+			TransientIndexBuffer* tib = getTransientIndexBufferPage(m_submit, offset/pageSize);
+			if (NULL == tib)
+			{
+				tib   = m_submit->m_transientIb[0];
+				local = 0;
+				_num  = 0;
+			}
 
-			_tib->data       = &tib.data[offset];
+			_tib->data       = &tib->data[local];
 			_tib->size       = _num * indexSize;
-			_tib->handle     = tib.handle;
-			_tib->startIndex = bx::strideAlign(offset, indexSize) / indexSize;
+			_tib->handle     = tib->handle;
+			_tib->startIndex = local / indexSize;
 			_tib->isIndex16  = isIndex16;
 		}
 
@@ -3851,13 +5163,83 @@ namespace bgfx
 			BX_ALIGNED_FREE(g_allocator, _tvb, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout) )
+		// Returns transient buffer page of frame, page is created first time
+		// frame uses it. Returns NULL when _page is past last page, which is
+		// what allocation returns once all pages are full. Must be called with
+		// resource API lock held.
+		TransientIndexBuffer* getTransientIndexBufferPage(Frame* _frame, uint32_t _page)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			if (_page >= Frame::getTransientMaxPages(g_caps.limits.transientIbSize) )
+			{
+				return NULL;
+			}
 
-			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
+			TransientIndexBuffer* tib = _frame->m_transientIb[_page];
+
+			if (NULL == tib)
+			{
+				tib = createTransientIndexBuffer(g_caps.limits.transientIbSize);
+
+				if (NULL != tib)
+				{
+					// Encoders check page without lock, publish it once it's initialized.
+					bx::atomicExchangePtr( (void**)&_frame->m_transientIb[_page], tib);
+				}
+			}
+
+			return tib;
+		}
+
+		TransientVertexBuffer* getTransientVertexBufferPage(Frame* _frame, uint32_t _page)
+		{
+			if (_page >= Frame::getTransientMaxPages(g_caps.limits.transientVbSize) )
+			{
+				return NULL;
+			}
+
+			TransientVertexBuffer* tvb = _frame->m_transientVb[_page];
+
+			if (NULL == tvb)
+			{
+				tvb = createTransientVertexBuffer(g_caps.limits.transientVbSize);
+
+				if (NULL != tvb)
+				{
+					bx::atomicExchangePtr( (void**)&_frame->m_transientVb[_page], tvb);
+				}
+			}
+
+			return tvb;
+		}
+
+		// Destroys transient buffer pages of frame, except first _numIbPages
+		// index and _numVbPages vertex buffer pages.
+		void destroyTransientBuffers(Frame* _frame, uint32_t _numIbPages, uint32_t _numVbPages)
+		{
+			for (uint32_t ii = _numIbPages; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+			{
+				if (NULL != _frame->m_transientIb[ii])
+				{
+					destroyTransientIndexBuffer(_frame->m_transientIb[ii]);
+					_frame->m_transientIb[ii] = NULL;
+				}
+			}
+
+			for (uint32_t ii = _numVbPages; ii < BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES; ++ii)
+			{
+				if (NULL != _frame->m_transientVb[ii])
+				{
+					destroyTransientVertexBuffer(_frame->m_transientVb[ii]);
+					_frame->m_transientVb[ii] = NULL;
+				}
+			}
+		}
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+		// Finds vertex layout used by transient vertex buffer, or creates it.
+		// Must be called with resource API lock held.
+		VertexLayoutHandle findTransientVertexLayout(const VertexLayout& _layout)
+		{
+			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
 
 			if (!isValid(layoutHandle) )
 			{
@@ -3869,13 +5251,32 @@ namespace bgfx
 				m_vertexLayoutRef.add(layoutHandle, _layout.m_hash);
 			}
 
-			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _layout.m_stride);
+			return layoutHandle;
+		}
+
+		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexLayout& _layout) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			VertexLayoutHandle layoutHandle = findTransientVertexLayout(_layout);
+
+			const uint32_t pageSize = g_caps.limits.transientVbSize;
+			const uint32_t offset   = m_submit->allocTransientVertexBuffer(_num, _layout.m_stride);
+			uint32_t local = offset % pageSize;
 
-			_tvb->data = &dvb.data[offset];
+			TransientVertexBuffer* dvb = getTransientVertexBufferPage(m_submit, offset/pageSize);
+			if (NULL == dvb)
+			{
+				dvb   = m_submit->m_transientVb[0];
+				local = 0;
+				_num  = 0;
+			}
+
+			_tvb->data = &dvb->data[local];
 			_tvb->size = _num * _layout.m_stride;
-			_tvb->startVertex = bx::strideAlign(offset, _layout.m_stride)/_layout.m_stride;
+			_tvb->startVertex = local/_layout.m_stride;
 			_tvb->stride = _layout.m_stride;
-			_tvb->handle = dvb.handle;
+			_tvb->handle = dvb->handle;
 			_tvb->layoutHandle   = layoutHandle;
 		}
 
@@ -3883,16 +5284,25 @@ namespace bgfx
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			const uint16_t stride = bx::alignUp(_stride, 16);
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
+			const uint16_t stride   = bx::alignUp(_stride, 16);
+			const uint32_t pageSize = g_caps.limits.transientVbSize;
+			const uint32_t offset   = m_submit->allocTransientVertexBuffer(_num, stride);
+			uint32_t local = offset % pageSize;
+
+			TransientVertexBuffer* dvb = getTransientVertexBufferPage(m_submit, offset/pageSize);
+			if (NULL == dvb)
+			{
+				dvb   = m_submit->m_transientVb[0];
+				local = 0;
+				_num  = 0;
+			}
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
-			_idb->data   = &dvb.data[offset];
+			_idb->data   = &dvb->data[local];
 			_idb->size   = _num * stride;
-			_idb->offset = offset;
+			_idb->offset = local;
 			_idb->num    = _num;
 			_idb->stride = stride;
-			_idb->handle = dvb.handle;
+			_idb->handle = dvb->handle;
 		}
 
 		IndirectBufferHandle createIndirectBuffer(uint32_t _num)
@@ -3923,6 +5333,7 @@ namespace bgfx
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicVertexBuffer);
 			cmdbuf.write(handle);
 			m_submit->free(handle);
+			++m_handleGen[DrawList::Resource::VertexBuffer][handle.idx];
 		}
 
 		BGFX_API_FUNC(ShaderHandle createShader(const Memory* _mem) )
@@ -4326,6 +5737,7 @@ namespace bgfx
 				cmdbuf.write(_handle);
 
 				m_programHashMap.removeByHandle(_handle.idx);
+				++m_handleGen[DrawList::Resource::Program][_handle.idx];
 			}
 		}
 
@@ -4402,15 +5814,62 @@ namespace bgfx
 				m_textureMemoryUsed += int64_t(ref.m_storageSize);
 			}
 
+			if (0 != (_flags & BGFX_TEXTURE_ASYNC) )
+			{
+				ref.m_loadIdx = m_resourceLoader.createTexture(handle, _mem, _flags, _skip);
+			}
+			else
+			{
+				textureLoaded(handle, _mem, _flags, _skip, false);
+			}
+
+			setDebugName(convert(handle) );
+
+			return handle;
+		}
+
+		// Called with resource API lock held, once texture memory is ready to
+		// be passed to renderer.
+		void textureLoaded(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip, bool _decoded)
+		{
+			TextureRef& ref = m_textureRef[_handle.idx];
+			ref.m_loadIdx    = UINT16_MAX;
+			ref.m_immutable |= _decoded; // Decoded to RGBA8, can't be updated with data in original format.
+
+			if (_decoded)
+			{
+				// Renderer creates texture from decoded data, memory used is
+				// size of RGBA8 texture instead of size in original format.
+				TextureInfo ti;
+				calcTextureSize(ti
+					, ref.m_width
+					, ref.m_height
+					, ref.m_depth
+					, ref.m_cubeMap
+					, ref.m_numMips > 1
+					, ref.m_numLayers
+					, TextureFormat::RGBA8
+					);
+
+				int64_t& memoryUsed = ref.isRt() ? m_rtMemoryUsed : m_textureMemoryUsed;
+				memoryUsed += int64_t(ti.storageSize) - int64_t(ref.m_storageSize);
+				ref.m_storageSize = ti.storageSize;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
-			cmdbuf.write(handle);
+			cmdbuf.write(_handle);
 			cmdbuf.write(_mem);
 			cmdbuf.write(_flags);
 			cmdbuf.write(_skip);
+		}
 
-			setDebugName(convert(handle) );
+		BGFX_API_FUNC(bool isTextureReady(TextureHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_CHECK_HANDLE("isTextureReady", m_textureHandle, _handle);
 
-			return handle;
+			TextureRef& ref = m_textureRef[_handle.idx];
+			return ref.isReady();
 		}
 
 		BGFX_API_FUNC(void setName(TextureHandle _handle, const bx::StringView& _name) )
@@ -4462,6 +5921,7 @@ namespace bgfx
 
 			const TextureRef& ref = m_textureRef[_handle.idx];
 			BX_ASSERT(ref.isReadBack(), "Can't read from texture which was not created with BGFX_TEXTURE_READ_BACK.");
+			BX_ASSERT(!ref.isLoading(), "Can't read from texture %d before asynchronous creation is done.", _handle.idx);
 			BX_ASSERT(_mip < ref.m_numMips, "Invalid mip: %d num mips:", _mip, ref.m_numMips);
 			BX_UNUSED(ref);
 
@@ -4469,7 +5929,7 @@ namespace bgfx
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_frames + 2;
+			return m_frames + m_numFrames + m_readBackLatency;
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
@@ -4530,9 +5990,19 @@ namespace bgfx
 
 				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 				BX_ASSERT(ok, "Texture handle %d is already destroyed!", _handle.idx);
+				++m_handleGen[DrawList::Resource::Texture][_handle.idx];
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
-				cmdbuf.write(_handle);
+				if (ref.isLoading() )
+				{
+					// CreateTexture command was never issued, nothing to destroy on render thread.
+					m_resourceLoader.cancel(ref.m_loadIdx);
+					ref.m_loadIdx = UINT16_MAX;
+				}
+				else
+				{
+					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
+					cmdbuf.write(_handle);
+				}
 			}
 		}
 
@@ -4560,6 +6030,13 @@ namespace bgfx
 				return;
 			}
 
+			if (ref.isLoading() )
+			{
+				BX_WARN(false, "Can't update texture %d before asynchronous creation is done.", _handle.idx);
+				release(_mem);
+				return;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
@@ -4615,6 +6092,10 @@ namespace bgfx
 				for (uint32_t ii = 0; ii < _num; ++ii)
 				{
 					TextureHandle texHandle = _attachment[ii].handle;
+					BX_ASSERT(!m_textureRef[texHandle.idx].isLoading()
+						, "Can't attach texture %d before asynchronous creation is done."
+						, texHandle.idx
+						);
 					fbr.un.m_th[ii] = texHandle;
 					textureIncRef(texHandle);
 				}
@@ -4822,6 +6303,7 @@ namespace bgfx
 
 				uniform.m_name.clear();
 				m_uniformHashMap.removeByHandle(_handle.idx);
+				++m_handleGen[DrawList::Resource::Uniform][_handle.idx];
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyUniform);
 				cmdbuf.write(_handle);
@@ -4874,6 +6356,55 @@ namespace bgfx
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		BGFX_API_FUNC(DrawListHandle createDrawList() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			DrawListHandle handle = { m_drawListHandle.alloc() };
+			if (isValid(handle) )
+			{
+				m_drawList[handle.idx].reset();
+			}
+			else
+			{
+				BX_TRACE("Failed to allocate draw list handle.");
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyDrawList(DrawListHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyDrawList", m_drawListHandle, _handle);
+
+			// Encoders might still submit draw list during this frame, it's
+			// released at frame swap once all encoders are ended.
+			m_freeDrawListHandle[m_numFreeDrawListHandles++] = _handle;
+		}
+
+		uint16_t getHandleGen(DrawList::Resource::Enum _type, uint16_t _idx) const
+		{
+			return kInvalidHandle != _idx ? m_handleGen[_type][_idx] : 0;
+		}
+
+		bool isDrawListValid(const DrawList& _drawList) const
+		{
+			for (DrawList::ResourceMap::const_iterator it = _drawList.m_resource.begin(), itEnd = _drawList.m_resource.end(); it != itEnd; ++it)
+			{
+				const DrawList::Resource::Enum type = DrawList::Resource::Enum(it->first >> 16);
+				const uint16_t idx = uint16_t(it->first);
+
+				if (it->second != m_handleGen[type][idx])
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4911,6 +6442,18 @@ namespace bgfx
 			screenShot.filePath.set(_filePath);
 		}
 
+		BGFX_API_FUNC(uint32_t replayFrame(const void* _data, uint32_t _size, uint32_t _offset) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (NULL == m_frameReplay)
+			{
+				m_frameReplay = frameReplayCreate();
+			}
+
+			return frameReplay(m_frameReplay, this, _data, _size, _offset);
+		}
+
 		BGFX_API_FUNC(void setPaletteColor(uint8_t _index, const float _rgba[4]) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -5008,9 +6551,14 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint32_t frame(bool _capture = false) );
 
-		uint32_t getSeqIncr(ViewId _id)
+		uint32_t getSeqIncr(ViewId _id, uint32_t _num = 1)
 		{
-			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], 1);
+			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], _num);
+		}
+
+		Frame* getNextFrame(Frame* _frame)
+		{
+			return &m_frame[(uint32_t(_frame - m_frame) + 1) % m_numFrames];
 		}
 
 		void dumpViewStats();
@@ -5038,6 +6586,7 @@ namespace bgfx
 		{
 			if (m_singleThreaded)
 			{
+				m_render = getNextFrame(m_render);
 				return true;
 			}
 
@@ -5046,6 +6595,9 @@ namespace bgfx
 			bool ok = m_apiSem.wait(_msecs);
 			if (ok)
 			{
+				// Render thread takes frames from ring in the same order API
+				// thread submitted them.
+				m_render = getNextFrame(m_render);
 				m_render->m_waitSubmit = bx::getHPCounter()-start;
 				m_submit->m_perfStats.waitSubmit = m_submit->m_waitSubmit;
 				return true;
@@ -5077,31 +6629,48 @@ namespace bgfx
 
 		void encoderApiWait()
 		{
-			uint16_t numEncoders = m_encoderHandle->getNumHandles(); // _init.limits.maxEncoders 编码线程的数量
+			// Lock pool, any begin from now on waits until frame is swapped.
+			const uint32_t state = bx::atomicFetchAndAdd<uint32_t>(&m_encoderPool, kEncoderPoolLocked);
+			BX_ASSERT(0 == (state & kEncoderPoolLocked), "Encoder pool is already locked.");
 
-			for (uint16_t ii = 1; ii < numEncoders; ++ii) // 这里就从1开始  如果只有1个直接跳过  不算 m_encoder0 m_encoder[0]
+			for (uint32_t ii = 0, num = (state & kEncoderPoolBeginMask) >> kEncoderPoolBeginShift; ii < num; ++ii)
 			{
-				m_encoderEndSem.wait(); // 等待所有的encoder的end信号 
+				m_encoderEndSem.wait();
 			}
 
-			for (uint16_t ii = 0; ii < numEncoders; ++ii) // 这里就从0开始
+			// All begins ended, number of encoders can't change anymore.
+			const uint32_t current = m_encoderPool;
+			const uint16_t numEncoders = uint16_t(current & kEncoderPoolNumMask);
+
+			for (uint16_t ii = 0; ii < numEncoders; ++ii)
 			{
-				uint16_t idx = m_encoderHandle->getHandleAt(ii);
-				m_encoderStats[ii].cpuTimeBegin = m_encoder[idx].m_cpuTimeBegin;
-				m_encoderStats[ii].cpuTimeEnd   = m_encoder[idx].m_cpuTimeEnd;
+				m_encoderStats[ii].cpuTimeBegin = m_encoder[ii].m_cpuTimeBegin;
+				m_encoderStats[ii].cpuTimeEnd   = m_encoder[ii].m_cpuTimeEnd;
+				m_encoderStats[ii].uniformBytesSaved = m_encoder[ii].m_uniformBytesSaved;
+
+				traceRecord(g_traceRecorder, "bgfx/Encoder", kTraceEncoderTid + ii, m_encoder[ii].m_cpuTimeBegin, m_encoder[ii].m_cpuTimeEnd);
 			}
 
 			m_submit->m_perfStats.numEncoders = uint8_t(numEncoders);
 
-			m_encoderHandle->reset();
-			uint16_t idx = m_encoderHandle->alloc(); // 预先分配 0 
-			BX_ASSERT(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				m_encoder[ii].resetRenderItems();
+			}
+
+			// Only internal encoder 0 stays allocated, pool remains locked
+			// until encoderApiUnlock.
+			bx::atomicCompareAndSwap<uint32_t>(&m_encoderPool, current, kEncoderPoolLocked|1);
+		}
+
+		void encoderApiUnlock()
+		{
+			bx::atomicFetchAndSub<uint32_t>(&m_encoderPool, kEncoderPoolLocked);
 		}
 
 		bx::Semaphore m_renderSem;
 		bx::Semaphore m_apiSem;
 		bx::Semaphore m_encoderEndSem;
-		bx::Mutex     m_encoderApiLock;
 		bx::Mutex     m_resourceApiLock;
 		bx::Thread    m_thread;
 #else
@@ -5112,6 +6681,7 @@ namespace bgfx
 		bool apiSemWait(int32_t _msecs = -1)
 		{
 			BX_UNUSED(_msecs);
+			m_render = getNextFrame(m_render);
 			return true;
 		}
 
@@ -5127,7 +6697,15 @@ namespace bgfx
 		{
 			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
 			m_encoderStats[0].cpuTimeEnd   = m_encoder[0].m_cpuTimeEnd;
+			m_encoderStats[0].uniformBytesSaved = m_encoder[0].m_uniformBytesSaved;
 			m_submit->m_perfStats.numEncoders = 1;
+
+			traceRecord(g_traceRecorder, "bgfx/Encoder", kTraceEncoderTid, m_encoder[0].m_cpuTimeBegin, m_encoder[0].m_cpuTimeEnd);
+			m_encoder[0].resetRenderItems();
+		}
+
+		void encoderApiUnlock()
+		{
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
@@ -5135,14 +6713,24 @@ namespace bgfx
 		Encoder*      m_encoder0;
 		EncoderImpl*  m_encoder;  // EncoderImpl 数组
 		uint32_t      m_numEncoders; // EncoderImpl 数组 元素个数
-		bx::HandleAlloc* m_encoderHandle;
+		uint32_t      m_encoderPool;
 
-		Frame  m_frame[1+(BGFX_CONFIG_MULTITHREADED ? 1 : 0)]; // 如果多线程 有两个 m_frame 切换
-		Frame* m_render; // 指向上面 m_frame数组其中一个
-		Frame* m_submit; // 指向上面 m_frame数组其中一个   如果 BGFX_CONFIG_MULTITHREADED 为false的话 那么这两个指向同一个m_frame[0]
+		JobPool m_jobPool;
+		ResourceLoader m_resourceLoader;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		Frame  m_frame[BGFX_CONFIG_MAX_FRAMES]; // 如果多线程 m_numFrames 个 m_frame 组成环
+		Frame* m_render; // 指向上面 m_frame数组其中一个  只有渲染线程修改
+		Frame* m_submit; // 指向上面 m_frame数组其中一个  只有API线程修改  如果 m_numFrames 为1的话 那么这两个指向同一个m_frame[0]
+		uint32_t m_numFrames;
+		uint32_t m_readBackLatency; // Frames until renderer delivers read back, 0 for renderers with synchronous read back.
+
+		TransientPages m_transientVbPages;
+		TransientPages m_transientIbPages;
+
+		// Occlusion query results carried from frame to frame on render thread.
+		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
+
+		uint32_t m_tempBlitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS];
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS]; // 预先分配了4096个 ??
@@ -5153,9 +6741,11 @@ namespace bgfx
 		uint16_t m_numFreeDynamicIndexBufferHandles;
 		uint16_t m_numFreeDynamicVertexBufferHandles;
 		uint16_t m_numFreeOcclusionQueryHandles;
+		uint16_t m_numFreeDrawListHandles;
 		DynamicIndexBufferHandle  m_freeDynamicIndexBufferHandle[BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS];
 		DynamicVertexBufferHandle m_freeDynamicVertexBufferHandle[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 		OcclusionQueryHandle      m_freeOcclusionQueryHandle[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
+		DrawListHandle            m_freeDrawListHandle[BGFX_CONFIG_MAX_DRAW_LISTS];
 
 		NonLocalAllocator m_dynIndexBufferAllocator;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS> m_dynamicIndexBufferHandle;
@@ -5172,6 +6762,12 @@ namespace bgfx
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_DRAW_LISTS> m_drawListHandle;
+
+		DrawList m_drawList[BGFX_CONFIG_MAX_DRAW_LISTS];
+
+		// Incremented when handle is destroyed, see DrawList.
+		uint16_t m_handleGen[DrawList::Resource::Count][kMaxDrawListHandles];
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
@@ -5210,6 +6806,11 @@ namespace bgfx
 
 		RendererContextI* m_renderCtx;
 
+		FrameCapture* m_frameCapture;
+		FrameReplay*  m_frameReplay;
+
+		uint32_t m_renderTid; // Set on first renderFrame, render thread doesn't change after that.
+
 		bool m_rendererInitialized;
 		bool m_exit;
 		bool m_flipAfterRender;
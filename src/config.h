@@ -214,6 +214,14 @@
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+/// `Init::Limits::maxDrawCalls` is clamped to this value when renderer with
+/// fixed size per frame scratch buffers (Direct3D 12 and WebGPU) is selected.
+/// Vulkan scratch buffers start at this size and grow when frame has more
+/// draw calls.
+#ifndef BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+#	define BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS BGFX_CONFIG_MAX_DRAW_CALLS
+#endif // BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
@@ -313,10 +321,32 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+/// Maximum number of texture read backs in flight. When all are in use,
+/// renderer waits only for the oldest one to complete.
+#ifndef BGFX_CONFIG_MAX_TEXTURE_READ_BACKS
+#	define BGFX_CONFIG_MAX_TEXTURE_READ_BACKS 64
+#endif // BGFX_CONFIG_MAX_TEXTURE_READ_BACKS
+
+#ifndef BGFX_CONFIG_MAX_DRAW_LISTS
+#	define BGFX_CONFIG_MAX_DRAW_LISTS 1024
+#endif // BGFX_CONFIG_MAX_DRAW_LISTS
+
 #ifndef BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 
+/// Size of per frame staging buffer from which renderer sub-allocates resource
+/// uploads. Default for Init::Limits::stagingBufferSize.
+#ifndef BGFX_CONFIG_STAGING_BUFFER_SIZE
+#	define BGFX_CONFIG_STAGING_BUFFER_SIZE (16<<20)
+#endif // BGFX_CONFIG_STAGING_BUFFER_SIZE
+
+/// Size of device memory block from which renderer sub-allocates buffers and
+/// textures. Resources larger than half of block get dedicated allocation.
+#ifndef BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE
+#	define BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE (64<<20)
+#endif // BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE
+
 #ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 #	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
 #endif // BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
@@ -325,6 +355,18 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Maximum number of pages transient vertex/index buffer can grow to within
+/// single frame. Page size is Init::Limits::transientVbSize/transientIbSize.
+#ifndef BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES
+#	define BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES 8
+#endif // BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES
+
+/// Number of frames in which fewer transient buffer pages were used before
+/// extra pages are released.
+#ifndef BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES
+#	define BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES 120
+#endif // BGFX_CONFIG_TRANSIENT_BUFFER_SHRINK_FRAMES
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -347,6 +389,37 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_RENDERDOC_CAPTURE_KEYS { eRENDERDOC_Key_F11 }
 #endif // BGFX_CONFIG_RENDERDOC_CAPTURE_KEYS
 
+/// Enable writing frames submitted with `bgfx::frame(true)` into capture file
+/// that can be replayed with `bgfx::replayFrame`. When enabled, all resource
+/// commands are recorded from initialization, so that capture file is self
+/// contained.
+#ifndef BGFX_CONFIG_FRAME_CAPTURE
+#	define BGFX_CONFIG_FRAME_CAPTURE 0
+#endif // BGFX_CONFIG_FRAME_CAPTURE
+
+#ifndef BGFX_CONFIG_FRAME_CAPTURE_FILE_PATH
+#	define BGFX_CONFIG_FRAME_CAPTURE_FILE_PATH "temp/bgfx.bgfxcap"
+#endif // BGFX_CONFIG_FRAME_CAPTURE_FILE_PATH
+
+/// Maximum size of resource command log kept between captured frames. Log
+/// keeps only commands of live resources, when it still grows over this size
+/// capturing is disabled.
+#ifndef BGFX_CONFIG_FRAME_CAPTURE_MAX_LOG_SIZE
+#	define BGFX_CONFIG_FRAME_CAPTURE_MAX_LOG_SIZE (256<<20)
+#endif // BGFX_CONFIG_FRAME_CAPTURE_MAX_LOG_SIZE
+
+/// Enable recording of API thread, encoder, render thread, profiler scope and
+/// per view CPU/GPU spans into ring buffer, that can be written as Chrome trace
+/// with `bgfx::saveTrace`. Doesn't require `BGFX_CONFIG_PROFILER`.
+#ifndef BGFX_CONFIG_TRACE_RECORDER
+#	define BGFX_CONFIG_TRACE_RECORDER 0
+#endif // BGFX_CONFIG_TRACE_RECORDER
+
+/// Number of spans kept by trace recorder, older spans are overwritten.
+#ifndef BGFX_CONFIG_TRACE_RECORDER_MAX_EVENTS
+#	define BGFX_CONFIG_TRACE_RECORDER_MAX_EVENTS (64<<10)
+#endif // BGFX_CONFIG_TRACE_RECORDER_MAX_EVENTS
+
 #ifndef BGFX_CONFIG_API_SEMAPHORE_TIMEOUT
 #	define BGFX_CONFIG_API_SEMAPHORE_TIMEOUT (5000)
 #endif // BGFX_CONFIG_API_SEMAPHORE_TIMEOUT
@@ -359,6 +432,47 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+/// Default number of frames in ring between API and render thread. API thread
+/// can submit up to number of frames minus one ahead of render thread.
+#ifndef BGFX_CONFIG_DEFAULT_NUM_FRAMES
+#	define BGFX_CONFIG_DEFAULT_NUM_FRAMES ( (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 1)
+#endif // BGFX_CONFIG_DEFAULT_NUM_FRAMES
+
+/// Maximum number of frames in ring between API and render thread.
+#ifndef BGFX_CONFIG_MAX_FRAMES
+#	define BGFX_CONFIG_MAX_FRAMES ( (0 != BGFX_CONFIG_MULTITHREADED) ? 4 : 1)
+#endif // BGFX_CONFIG_MAX_FRAMES
+
+/// Number of internal worker threads used to spread CPU heavy work (sorting, etc.).
+#ifndef BGFX_CONFIG_MAX_WORKER_THREADS
+#	define BGFX_CONFIG_MAX_WORKER_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 3 : 0)
+#endif // BGFX_CONFIG_MAX_WORKER_THREADS
+
+/// Number of internal threads used to prepare textures created with
+/// `BGFX_TEXTURE_ASYNC` flag.
+#ifndef BGFX_CONFIG_MAX_LOADER_THREADS
+#	define BGFX_CONFIG_MAX_LOADER_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 0)
+#endif // BGFX_CONFIG_MAX_LOADER_THREADS
+
+/// Store software decoded textures through `CallbackI::cacheWrite`, keyed by
+/// hash of texture data, so that next run doesn't decode them again.
+#ifndef BGFX_CONFIG_TEXTURE_DECODE_CACHE
+#	define BGFX_CONFIG_TEXTURE_DECODE_CACHE 0
+#endif // BGFX_CONFIG_TEXTURE_DECODE_CACHE
+
+/// Minimum number of render items before sort is split per view across worker
+/// threads. Set to 0 to disable parallel sort.
+#ifndef BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS
+#	define BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS (8<<10)
+#endif // BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS
+
+/// Minimum number of render items before renderer splits sorted render items
+/// into view batches, and creates pipelines missing from cache on worker
+/// threads. Command recording stays on render thread. Set to 0 to disable.
+#ifndef BGFX_CONFIG_PARALLEL_PIPELINE_MIN_ITEMS
+#	define BGFX_CONFIG_PARALLEL_PIPELINE_MIN_ITEMS (1<<10)
+#endif // BGFX_CONFIG_PARALLEL_PIPELINE_MIN_ITEMS
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
@@ -381,4 +495,11 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_ENCODER_API_ONLY 0
 #endif // BGFX_CONFIG_ENCODER_API_ONLY
 
+/// When enabled, thread that calls `bgfx::begin` more than once during the same
+/// frame gets back encoder it used before, instead of allocating new one. Thread
+/// must end encoder before calling `bgfx::begin` again.
+#ifndef BGFX_CONFIG_ENCODER_THREAD_CACHE
+#	define BGFX_CONFIG_ENCODER_THREAD_CACHE 0
+#endif // BGFX_CONFIG_ENCODER_THREAD_CACHE
+
 #endif // BGFX_CONFIG_H_HEADER_GUARD
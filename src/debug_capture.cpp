@@ -0,0 +1,2411 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+
+#include <bx/file.h>
+
+namespace bgfx
+{
+	constexpr uint32_t kCaptureMagic      = BX_MAKEFOURCC('C', 'A', 'P', 0x0);
+	constexpr uint32_t kCaptureFrameMagic = BX_MAKEFOURCC('F', 'R', 'M', 0x0);
+	constexpr uint32_t kCaptureVersion    = 2;
+
+	// Frame data is stored as raw structures, capture can be replayed only by
+	// library built with the same configuration.
+	struct CaptureHeader
+	{
+		uint32_t m_magic;
+		uint32_t m_version;
+		uint32_t m_apiVersion;
+		uint32_t m_maxViews;
+		uint32_t m_maxColorPalette;
+		uint32_t m_maxRectCache;
+		uint32_t m_renderItemSize;
+		uint32_t m_renderBindSize;
+		uint32_t m_viewSize;
+		uint32_t m_blitItemSize;
+		uint32_t m_vertexLayoutSize;
+		uint32_t m_attachmentSize;
+	};
+
+	static void initHeader(CaptureHeader& _header)
+	{
+		bx::memSet(&_header, 0, sizeof(CaptureHeader) );
+		_header.m_magic            = kCaptureMagic;
+		_header.m_version          = kCaptureVersion;
+		_header.m_apiVersion       = BGFX_API_VERSION;
+		_header.m_maxViews         = BGFX_CONFIG_MAX_VIEWS;
+		_header.m_maxColorPalette  = BGFX_CONFIG_MAX_COLOR_PALETTE;
+		_header.m_maxRectCache     = BGFX_CONFIG_MAX_RECT_CACHE;
+		_header.m_renderItemSize   = sizeof(RenderItem);
+		_header.m_renderBindSize   = sizeof(RenderBind);
+		_header.m_viewSize         = sizeof(View);
+		_header.m_blitItemSize     = sizeof(BlitItem);
+		_header.m_vertexLayoutSize = sizeof(VertexLayout);
+		_header.m_attachmentSize   = sizeof(Attachment);
+	}
+
+	constexpr uint32_t kCaptureNoOwner = UINT32_MAX;
+	constexpr uint32_t kCaptureNoRecord = UINT32_MAX;
+
+	// Range of resource written by update command. Buffers use only x range.
+	struct CaptureRegion
+	{
+		uint32_t m_sub;
+		uint32_t m_min[3];
+		uint32_t m_max[3];
+	};
+
+	// One command in resource log. Records are linked per owning resource, so
+	// that commands of destroyed resources, and updates overwritten by later
+	// updates can be dropped from the log before next captured frame.
+	struct CaptureRecord
+	{
+		CaptureRegion m_region;
+		uint32_t m_offset;
+		uint32_t m_size;
+		uint32_t m_owner;
+		uint32_t m_prev;
+		bool     m_create;
+		bool     m_update;
+		bool     m_live;
+	};
+
+	struct FrameCapture
+	{
+		FrameCapture(const char* _filePath)
+			: m_filePath(_filePath)
+			, m_log(g_allocator)
+			, m_logWriter(&m_log)
+			, m_deadSize(0)
+			, m_open(false)
+			, m_failed(false)
+		{
+		}
+
+		typedef stl::unordered_map<uint32_t, uint32_t> LastRecordMap;
+
+		bx::FilePath     m_filePath;
+		bx::FileWriter   m_writer;
+		bx::MemoryBlock  m_log;
+		bx::MemoryWriter m_logWriter;
+		stl::vector<CaptureRecord> m_record;
+		LastRecordMap    m_lastRecord;
+		uint32_t m_deadSize;
+		bool m_open;
+		bool m_failed;
+	};
+
+	static uint32_t getCaptureOwner(uint8_t _command, uint16_t _idx, uint8_t _type = 0)
+	{
+		return uint32_t(_command)<<24 | uint32_t(_type)<<16 | _idx;
+	}
+
+	static bool contains(const CaptureRegion& _outer, const CaptureRegion& _inner)
+	{
+		return _outer.m_sub    == _inner.m_sub
+			&& _outer.m_min[0] <= _inner.m_min[0] && _outer.m_max[0] >= _inner.m_max[0]
+			&& _outer.m_min[1] <= _inner.m_min[1] && _outer.m_max[1] >= _inner.m_max[1]
+			&& _outer.m_min[2] <= _inner.m_min[2] && _outer.m_max[2] >= _inner.m_max[2]
+			;
+	}
+
+	static void dropRecord(FrameCapture* _capture, CaptureRecord& _record)
+	{
+		_record.m_live = false;
+		_capture->m_deadSize += _record.m_size;
+	}
+
+	// Drops all logged commands of resource, returns true if resource was
+	// created since last captured frame, and replay never sees it.
+	static bool dropOwner(FrameCapture* _capture, uint32_t _owner)
+	{
+		FrameCapture::LastRecordMap::iterator it = _capture->m_lastRecord.find(_owner);
+		if (it == _capture->m_lastRecord.end() )
+		{
+			return false;
+		}
+
+		bool created = false;
+
+		for (uint32_t idx = it->second; kCaptureNoRecord != idx;)
+		{
+			CaptureRecord& record = _capture->m_record[idx];
+			created |= record.m_create;
+			dropRecord(_capture, record);
+			idx = record.m_prev;
+		}
+
+		_capture->m_lastRecord.erase(it);
+
+		return created;
+	}
+
+	// Drops earlier updates of the same resource fully covered by _region.
+	static void dropCovered(FrameCapture* _capture, uint32_t _owner, const CaptureRegion& _region)
+	{
+		FrameCapture::LastRecordMap::iterator it = _capture->m_lastRecord.find(_owner);
+		if (it == _capture->m_lastRecord.end() )
+		{
+			return;
+		}
+
+		for (uint32_t idx = it->second; kCaptureNoRecord != idx;)
+		{
+			CaptureRecord& record = _capture->m_record[idx];
+
+			if (record.m_live
+			&&  record.m_update
+			&&  contains(_region, record.m_region) )
+			{
+				dropRecord(_capture, record);
+			}
+
+			idx = record.m_prev;
+		}
+	}
+
+	static void addRecord(FrameCapture* _capture, uint32_t _offset, uint32_t _owner, bool _create, const CaptureRegion* _region)
+	{
+		const uint32_t end = uint32_t(bx::seek(&_capture->m_logWriter) );
+
+		if (NULL != _region)
+		{
+			dropCovered(_capture, _owner, *_region);
+		}
+
+		CaptureRecord record;
+		bx::memSet(&record.m_region, 0, sizeof(CaptureRegion) );
+		record.m_offset = _offset;
+		record.m_size   = end - _offset;
+		record.m_owner  = _owner;
+		record.m_prev   = kCaptureNoRecord;
+		record.m_create = _create;
+		record.m_update = NULL != _region;
+		record.m_live   = true;
+
+		if (NULL != _region)
+		{
+			record.m_region = *_region;
+		}
+
+		const uint32_t idx = uint32_t(_capture->m_record.size() );
+
+		if (kCaptureNoOwner != _owner)
+		{
+			FrameCapture::LastRecordMap::iterator it = _capture->m_lastRecord.find(_owner);
+			if (it != _capture->m_lastRecord.end() )
+			{
+				record.m_prev = it->second;
+				it->second    = idx;
+			}
+			else
+			{
+				_capture->m_lastRecord.insert(stl::make_pair(_owner, idx) );
+			}
+		}
+
+		_capture->m_record.push_back(record);
+	}
+
+	// Moves live records to the front of the log once at least half of it is
+	// dropped commands. Log size is bounded by commands needed to recreate
+	// resources alive at capture, instead of growing with every command since
+	// last captured frame.
+	static void compactLog(FrameCapture* _capture, bool _force)
+	{
+		const uint32_t logSize = uint32_t(bx::seek(&_capture->m_logWriter) );
+
+		if (0 == _capture->m_deadSize
+		|| (!_force
+		&& (_capture->m_deadSize < (64<<10) || _capture->m_deadSize < logSize/2) ) )
+		{
+			return;
+		}
+
+		uint8_t* data = (uint8_t*)_capture->m_log.more();
+		uint32_t offset = 0;
+		uint32_t num    = 0;
+
+		_capture->m_lastRecord.clear();
+
+		for (uint32_t ii = 0, numRecords = uint32_t(_capture->m_record.size() ); ii < numRecords; ++ii)
+		{
+			CaptureRecord record = _capture->m_record[ii];
+
+			if (!record.m_live)
+			{
+				continue;
+			}
+
+			bx::memMove(&data[offset], &data[record.m_offset], record.m_size);
+			record.m_offset = offset;
+			record.m_prev   = kCaptureNoRecord;
+			offset += record.m_size;
+
+			if (kCaptureNoOwner != record.m_owner)
+			{
+				FrameCapture::LastRecordMap::iterator it = _capture->m_lastRecord.find(record.m_owner);
+				if (it != _capture->m_lastRecord.end() )
+				{
+					record.m_prev = it->second;
+					it->second    = num;
+				}
+				else
+				{
+					_capture->m_lastRecord.insert(stl::make_pair(record.m_owner, num) );
+				}
+			}
+
+			_capture->m_record[num++] = record;
+		}
+
+		_capture->m_record.resize(num);
+		_capture->m_deadSize = 0;
+		bx::seek(&_capture->m_logWriter, offset, bx::Whence::Begin);
+	}
+
+	// Drops logged commands of destroyed resource, returns true when nothing
+	// about resource was written to capture file yet.
+	static bool destroyOwner(FrameCapture* _capture, uint8_t _command, uint16_t _idx)
+	{
+		uint8_t create = CommandBuffer::End;
+		uint8_t type   = Handle::Count;
+
+		switch (_command)
+		{
+		case CommandBuffer::DestroyVertexLayout:        create = CommandBuffer::CreateVertexLayout;                                 break;
+		case CommandBuffer::DestroyIndexBuffer:         create = CommandBuffer::CreateIndexBuffer;  type = Handle::IndexBuffer;  break;
+		case CommandBuffer::DestroyVertexBuffer:        create = CommandBuffer::CreateVertexBuffer; type = Handle::VertexBuffer; break;
+		case CommandBuffer::DestroyDynamicIndexBuffer:  create = CommandBuffer::CreateDynamicIndexBuffer;                           break;
+		case CommandBuffer::DestroyDynamicVertexBuffer: create = CommandBuffer::CreateDynamicVertexBuffer;                          break;
+		case CommandBuffer::DestroyShader:              create = CommandBuffer::CreateShader;       type = Handle::Shader;       break;
+		case CommandBuffer::DestroyProgram:             create = CommandBuffer::CreateProgram;                                      break;
+		case CommandBuffer::DestroyTexture:             create = CommandBuffer::CreateTexture;      type = Handle::Texture;      break;
+		case CommandBuffer::DestroyFrameBuffer:         create = CommandBuffer::CreateFrameBuffer;                                  break;
+		case CommandBuffer::DestroyUniform:             create = CommandBuffer::CreateUniform;                                      break;
+		default:                                                                                                                    break;
+		}
+
+		if (Handle::Count != type)
+		{
+			dropOwner(_capture, getCaptureOwner(CommandBuffer::SetName, _idx, type) );
+		}
+
+		return dropOwner(_capture, getCaptureOwner(create, _idx) );
+	}
+
+	static void resetLog(FrameCapture* _capture)
+	{
+		_capture->m_record.clear();
+		_capture->m_lastRecord.clear();
+		_capture->m_deadSize = 0;
+		bx::seek(&_capture->m_logWriter, 0, bx::Whence::Begin);
+	}
+
+	FrameCapture* frameCaptureCreate(const char* _filePath)
+	{
+		return BX_NEW(g_allocator, FrameCapture)(_filePath);
+	}
+
+	void frameCaptureDestroy(FrameCapture* _capture)
+	{
+		if (NULL != _capture)
+		{
+			if (_capture->m_open)
+			{
+				bx::close(&_capture->m_writer);
+			}
+
+			BX_DELETE(g_allocator, _capture);
+		}
+	}
+
+	static void writeMemory(bx::WriterI* _writer, const Memory* _mem)
+	{
+		bx::write(_writer, _mem->size);
+		bx::write(_writer, _mem->data, int32_t(_mem->size) );
+	}
+
+	static void writeString(bx::WriterI* _writer, CommandBuffer& _cmdbuf, uint32_t _len)
+	{
+		bx::write(_writer, _cmdbuf.skip(_len), int32_t(_len) );
+	}
+
+	void frameCaptureCommands(FrameCapture* _capture, CommandBuffer& _cmdbuf)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Capture commands", 0xff2040ff);
+
+		if (_capture->m_failed)
+		{
+			return;
+		}
+
+		bx::WriterI* writer = &_capture->m_logWriter;
+
+		// Walks command buffer the same way rendererExecCommands does, and
+		// writes commands without pointers into resource log.
+		_cmdbuf.reset();
+
+		bool end = false;
+
+		do
+		{
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			const uint32_t logOffset = uint32_t(bx::seek(&_capture->m_logWriter) );
+
+			switch (command)
+			{
+			case CommandBuffer::RendererInit:
+				_cmdbuf.skip<Init>();
+				break;
+
+			case CommandBuffer::RendererShutdownBegin:
+				break;
+
+			case CommandBuffer::RendererShutdownEnd:
+			case CommandBuffer::End:
+				end = true;
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					writeMemory(writer, mem);
+					bx::write(writer, flags);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateIndexBuffer, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateVertexLayout:
+				{
+					VertexLayoutHandle handle;
+					_cmdbuf.read(handle);
+
+					VertexLayout layout;
+					_cmdbuf.read(layout);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, layout);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateVertexLayout, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					VertexLayoutHandle layoutHandle;
+					_cmdbuf.read(layoutHandle);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					writeMemory(writer, mem);
+					bx::write(writer, layoutHandle);
+					bx::write(writer, flags);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateVertexBuffer, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					_cmdbuf.read(idx);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					bx::write(writer, command);
+					bx::write(writer, idx);
+					bx::write(writer, size);
+					bx::write(writer, flags);
+					addRecord(_capture, logOffset, getCaptureOwner(command, idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					_cmdbuf.read(idx);
+
+					uint32_t offset;
+					_cmdbuf.read(offset);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					bx::write(writer, command);
+					bx::write(writer, idx);
+					bx::write(writer, offset);
+					bx::write(writer, size);
+					writeMemory(writer, mem);
+
+					CaptureRegion region;
+					bx::memSet(&region, 0, sizeof(CaptureRegion) );
+					region.m_min[0] = offset;
+					region.m_max[0] = offset + size;
+					region.m_max[1] = 1;
+					region.m_max[2] = 1;
+
+					const uint8_t create = CommandBuffer::UpdateDynamicIndexBuffer == command
+						? CommandBuffer::CreateDynamicIndexBuffer
+						: CommandBuffer::CreateDynamicVertexBuffer
+						;
+					addRecord(_capture, logOffset, getCaptureOwner(create, idx), false, &region);
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					ShaderHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					writeMemory(writer, mem);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateShader, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				{
+					ProgramHandle handle;
+					_cmdbuf.read(handle);
+
+					ShaderHandle vsh;
+					_cmdbuf.read(vsh);
+
+					ShaderHandle fsh;
+					_cmdbuf.read(fsh);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, vsh);
+					bx::write(writer, fsh);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateProgram, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint64_t flags;
+					_cmdbuf.read(flags);
+
+					uint8_t skip;
+					_cmdbuf.read(skip);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					writeMemory(writer, mem);
+					bx::write(writer, flags);
+					bx::write(writer, skip);
+
+					// Texture chunk references content by pointer, content is
+					// written after it.
+					bx::MemoryReader reader(mem->data, mem->size);
+
+					uint32_t magic;
+					bx::read(&reader, magic);
+
+					const Memory* content = NULL;
+					if (BGFX_CHUNK_MAGIC_TEX == magic)
+					{
+						TextureCreate tc;
+						bx::read(&reader, tc);
+						content = tc.m_mem;
+					}
+
+					bx::write(writer, NULL != content);
+					if (NULL != content)
+					{
+						writeMemory(writer, content);
+					}
+
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateTexture, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t side;
+					_cmdbuf.read(side);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+
+					Rect rect;
+					_cmdbuf.read(rect);
+
+					uint16_t zz;
+					_cmdbuf.read(zz);
+
+					uint16_t depth;
+					_cmdbuf.read(depth);
+
+					uint16_t pitch;
+					_cmdbuf.read(pitch);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, side);
+					bx::write(writer, mip);
+					bx::write(writer, rect);
+					bx::write(writer, zz);
+					bx::write(writer, depth);
+					bx::write(writer, pitch);
+					writeMemory(writer, mem);
+
+					CaptureRegion region;
+					region.m_sub    = uint32_t(side)<<8 | mip;
+					region.m_min[0] = rect.m_x;
+					region.m_min[1] = rect.m_y;
+					region.m_min[2] = zz;
+					region.m_max[0] = rect.m_x + rect.m_width;
+					region.m_max[1] = rect.m_y + rect.m_height;
+					region.m_max[2] = zz + depth;
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateTexture, handle.idx), false, &region);
+				}
+				break;
+
+			case CommandBuffer::ReadTexture:
+				{
+					// Read back destination is application memory, not captured.
+					_cmdbuf.skip<TextureHandle>();
+					_cmdbuf.skip<void*>();
+					_cmdbuf.skip<uint8_t>();
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t width;
+					_cmdbuf.read(width);
+
+					uint16_t height;
+					_cmdbuf.read(height);
+
+					uint8_t numMips;
+					_cmdbuf.read(numMips);
+
+					uint16_t numLayers;
+					_cmdbuf.read(numLayers);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, width);
+					bx::write(writer, height);
+					bx::write(writer, numMips);
+					bx::write(writer, numLayers);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateTexture, handle.idx), false, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					bool window;
+					_cmdbuf.read(window);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, window);
+
+					if (window)
+					{
+						_cmdbuf.skip<void*>();
+
+						uint16_t width;
+						_cmdbuf.read(width);
+
+						uint16_t height;
+						_cmdbuf.read(height);
+
+						TextureFormat::Enum format;
+						_cmdbuf.read(format);
+
+						TextureFormat::Enum depthFormat;
+						_cmdbuf.read(depthFormat);
+
+						bx::write(writer, width);
+						bx::write(writer, height);
+						bx::write(writer, format);
+						bx::write(writer, depthFormat);
+					}
+					else
+					{
+						uint8_t num;
+						_cmdbuf.read(num);
+
+						Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+						_cmdbuf.read(attachment, sizeof(Attachment) * num);
+
+						bx::write(writer, num);
+						bx::write(writer, attachment, int32_t(sizeof(Attachment) * num) );
+					}
+
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateFrameBuffer, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					UniformHandle handle;
+					_cmdbuf.read(handle);
+
+					UniformType::Enum type;
+					_cmdbuf.read(type);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					uint8_t len;
+					_cmdbuf.read(len);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, type);
+					bx::write(writer, num);
+					bx::write(writer, len);
+					writeString(writer, _cmdbuf, len);
+					addRecord(_capture, logOffset, getCaptureOwner(CommandBuffer::CreateUniform, handle.idx), true, NULL);
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					ViewId id;
+					_cmdbuf.read(id);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					// Only the last name of view is needed.
+					const uint32_t owner = getCaptureOwner(CommandBuffer::UpdateViewName, id);
+					dropOwner(_capture, owner);
+
+					bx::write(writer, command);
+					bx::write(writer, id);
+					bx::write(writer, len);
+					writeString(writer, _cmdbuf, len);
+					addRecord(_capture, logOffset, owner, false, NULL);
+				}
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+				{
+					// Occlusion queries are not replayed.
+					_cmdbuf.skip<OcclusionQueryHandle>();
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					Handle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					const uint32_t owner = getCaptureOwner(CommandBuffer::SetName, handle.idx, uint8_t(handle.type) );
+					dropOwner(_capture, owner);
+
+					bx::write(writer, command);
+					bx::write(writer, handle);
+					bx::write(writer, len);
+					writeString(writer, _cmdbuf, len);
+					addRecord(_capture, logOffset, owner, false, NULL);
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexLayout:
+			case CommandBuffer::DestroyIndexBuffer:
+			case CommandBuffer::DestroyVertexBuffer:
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+			case CommandBuffer::DestroyShader:
+			case CommandBuffer::DestroyProgram:
+			case CommandBuffer::DestroyTexture:
+			case CommandBuffer::DestroyFrameBuffer:
+			case CommandBuffer::DestroyUniform:
+				{
+					uint16_t idx;
+					_cmdbuf.read(idx);
+
+					if (!destroyOwner(_capture, command, idx) )
+					{
+						// Resource was already written with previous captured
+						// frame, replay has to destroy it.
+						bx::write(writer, command);
+						bx::write(writer, idx);
+						addRecord(_capture, logOffset, kCaptureNoOwner, false, NULL);
+					}
+				}
+				break;
+
+			default:
+				BX_ASSERT(false, "Invalid command: %d", command);
+				break;
+			}
+		} while (!end);
+
+		_cmdbuf.reset();
+
+		compactLog(_capture, false);
+
+		if (bx::seek(&_capture->m_logWriter) > BGFX_CONFIG_FRAME_CAPTURE_MAX_LOG_SIZE)
+		{
+			BX_TRACE("Frame capture: Resource log is larger than %d bytes, capturing is disabled."
+				, BGFX_CONFIG_FRAME_CAPTURE_MAX_LOG_SIZE
+				);
+			resetLog(_capture);
+			_capture->m_failed = true;
+		}
+	}
+
+	static uint32_t getUniformEnd(const Frame* _frame, uint64_t _key, RenderItemCount _value, uint8_t& _uniformIdx)
+	{
+		const RenderItem& item = _frame->m_renderItem[_value];
+
+		if (0 != (_key & kSortKeyDrawBit) )
+		{
+			_uniformIdx = item.draw.m_uniformIdx;
+			return item.draw.m_uniformEnd;
+		}
+
+		_uniformIdx = item.compute.m_uniformIdx;
+		return item.compute.m_uniformEnd;
+	}
+
+	// Writes handle, number of used bytes and data of every transient buffer
+	// page frame used.
+	template<typename Ty>
+	static void writeTransientPages(bx::WriterI* _writer, Ty* const* _page, uint32_t _offset, uint32_t _pageSize)
+	{
+		const uint32_t numPages = bx::min(
+			  Frame::getTransientNumPages(_offset, _pageSize)
+			, Frame::getTransientMaxPages(_pageSize)
+			);
+		bx::write(_writer, numPages);
+
+		for (uint32_t ii = 0; ii < numPages; ++ii)
+		{
+			const Ty* page = _page[ii];
+			const uint16_t handle = NULL != page ? page->handle.idx : kInvalidHandle;
+			const uint32_t used   = NULL != page ? Frame::getTransientPageUsed(_offset, _pageSize, ii) : 0;
+
+			bx::write(_writer, handle);
+			bx::write(_writer, used);
+
+			if (0 != used)
+			{
+				bx::write(_writer, page->data, int32_t(used) );
+			}
+		}
+	}
+
+	void frameCaptureFrame(FrameCapture* _capture, Frame* _frame)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Capture frame", 0xff2040ff);
+
+		if (_capture->m_failed)
+		{
+			return;
+		}
+
+		bx::WriterI* writer = &_capture->m_writer;
+
+		if (!_capture->m_open)
+		{
+			bx::Error err;
+			_capture->m_open = bx::open(&_capture->m_writer, _capture->m_filePath, false, &err);
+
+			if (!_capture->m_open)
+			{
+				BX_TRACE("Failed to open frame capture file %s.", _capture->m_filePath.getCPtr() );
+				_capture->m_failed = true;
+				return;
+			}
+
+			CaptureHeader header;
+			initHeader(header);
+			bx::write(writer, header);
+		}
+
+		// Resource commands recorded since last captured frame, without
+		// commands of resources destroyed in the meantime.
+		compactLog(_capture, true);
+
+		const uint8_t end = CommandBuffer::End;
+		bx::write(&_capture->m_logWriter, end);
+
+		const uint32_t logSize = uint32_t(bx::seek(&_capture->m_logWriter) );
+		bx::write(writer, kCaptureFrameMagic);
+		bx::write(writer, logSize);
+		bx::write(writer, _capture->m_log.more(), int32_t(logSize) );
+		resetLog(_capture);
+
+		// Transient buffers.
+		writeTransientPages(writer, _frame->m_transientVb, _frame->m_vboffset, g_caps.limits.transientVbSize);
+		writeTransientPages(writer, _frame->m_transientIb, _frame->m_iboffset, g_caps.limits.transientIbSize);
+
+		// Views.
+		bx::write(writer, _frame->m_view,         int32_t(sizeof(_frame->m_view) ) );
+		bx::write(writer, _frame->m_viewRemap,    int32_t(sizeof(_frame->m_viewRemap) ) );
+		bx::write(writer, _frame->m_colorPalette, int32_t(sizeof(_frame->m_colorPalette) ) );
+
+		// Frame cache.
+		const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		const uint32_t numMatrices = bx::min(matrixCache.m_num, matrixCache.m_max);
+		bx::write(writer, numMatrices);
+		bx::write(writer, matrixCache.m_cache, int32_t(sizeof(Matrix4) * numMatrices) );
+
+		const RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		const uint32_t numRects = bx::min<uint32_t>(rectCache.m_num, BGFX_CONFIG_MAX_RECT_CACHE);
+		bx::write(writer, numRects);
+		bx::write(writer, rectCache.m_cache, int32_t(sizeof(Rect) * numRects) );
+
+		// Render items. While submitting, number of render items is number of
+		// reserved items, items not referenced by any key are never read.
+		const uint32_t numRenderItems = bx::min(_frame->m_numRenderItems, g_caps.limits.maxDrawCalls);
+		bx::write(writer, numRenderItems);
+		bx::write(writer, _frame->m_renderItem,     int32_t(sizeof(RenderItem) * numRenderItems) );
+		bx::write(writer, _frame->m_renderItemBind, int32_t(sizeof(RenderBind) * numRenderItems) );
+
+		const uint32_t numEncoders = g_caps.limits.maxEncoders;
+
+		uint32_t numKeys = 0;
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			numKeys += _frame->m_sortKeyBuffer[ii].m_num;
+		}
+
+		bx::write(writer, numKeys);
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			const SortKeyBuffer& buffer = _frame->m_sortKeyBuffer[ii];
+			bx::write(writer, buffer.m_keys, int32_t(sizeof(uint64_t) * buffer.m_num) );
+		}
+
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			const SortKeyBuffer& buffer = _frame->m_sortKeyBuffer[ii];
+			bx::write(writer, buffer.m_values, int32_t(sizeof(RenderItemCount) * buffer.m_num) );
+		}
+
+		// Uniform buffers, only part referenced by render items.
+		uint32_t uniformSize[kMaxEncoders];
+		bx::memSet(uniformSize, 0, sizeof(uniformSize) );
+
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			const SortKeyBuffer& buffer = _frame->m_sortKeyBuffer[ii];
+
+			for (uint32_t jj = 0, num = buffer.m_num; jj < num; ++jj)
+			{
+				uint8_t uniformIdx;
+				const uint32_t uniformEnd = getUniformEnd(_frame, buffer.m_keys[jj], buffer.m_values[jj], uniformIdx);
+
+				if (uniformIdx < numEncoders)
+				{
+					uniformSize[uniformIdx] = bx::max(uniformSize[uniformIdx], uniformEnd);
+				}
+			}
+		}
+
+		bx::write(writer, numEncoders);
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			UniformBuffer* uniformBuffer = _frame->m_uniformBuffer[ii];
+			uniformBuffer->reset();
+
+			bx::write(writer, uniformSize[ii]);
+			bx::write(writer, uniformBuffer->read(uniformSize[ii]), int32_t(uniformSize[ii]) );
+
+			uniformBuffer->reset();
+		}
+
+		// Blits.
+		bx::write(writer, _frame->m_numBlitItems);
+		bx::write(writer, _frame->m_blitKeys, int32_t(sizeof(uint32_t) * _frame->m_numBlitItems) );
+		bx::write(writer, _frame->m_blitItem, int32_t(sizeof(BlitItem) * _frame->m_numBlitItems) );
+	}
+
+	template<typename HandleT, uint16_t MaxHandlesT>
+	struct HandleRemapT
+	{
+		HandleRemapT()
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			bx::memSet(m_idx,     0xff, sizeof(m_idx) );
+			bx::memSet(m_dynamic, 0,    sizeof(m_dynamic) );
+		}
+
+		HandleT find(HandleT _handle) const
+		{
+			HandleT handle = { kInvalidHandle };
+
+			if (_handle.idx < MaxHandlesT)
+			{
+				handle.idx = m_idx[_handle.idx];
+			}
+
+			return handle;
+		}
+
+		HandleT create(HandleT _handle, bx::HandleAllocT<MaxHandlesT>& _handleAlloc, bool _dynamic = false)
+		{
+			HandleT handle = { kInvalidHandle };
+
+			if (_handle.idx < MaxHandlesT)
+			{
+				handle.idx = _handleAlloc.alloc();
+				BX_WARN(isValid(handle), "Frame replay: Failed to allocate handle.");
+
+				m_idx[_handle.idx]     = handle.idx;
+				m_dynamic[_handle.idx] = _dynamic;
+			}
+
+			return handle;
+		}
+
+		HandleT destroy(HandleT _handle)
+		{
+			HandleT handle = find(_handle);
+
+			if (_handle.idx < MaxHandlesT)
+			{
+				m_idx[_handle.idx] = kInvalidHandle;
+			}
+
+			return handle;
+		}
+
+		uint16_t m_idx[MaxHandlesT];
+		bool     m_dynamic[MaxHandlesT];
+	};
+
+	struct FrameReplay
+	{
+		FrameReplay()
+			: m_numTransientVb(0)
+			, m_numTransientIb(0)
+		{
+		}
+
+		HandleRemapT<IndexBufferHandle,  BGFX_CONFIG_MAX_INDEX_BUFFERS>  m_indexBuffer;
+		HandleRemapT<VertexLayoutHandle, BGFX_CONFIG_MAX_VERTEX_LAYOUTS> m_vertexLayout;
+		HandleRemapT<VertexBufferHandle, BGFX_CONFIG_MAX_VERTEX_BUFFERS> m_vertexBuffer;
+		HandleRemapT<ShaderHandle,       BGFX_CONFIG_MAX_SHADERS>        m_shader;
+		HandleRemapT<ProgramHandle,      BGFX_CONFIG_MAX_PROGRAMS>       m_program;
+		HandleRemapT<TextureHandle,      BGFX_CONFIG_MAX_TEXTURES>       m_texture;
+		HandleRemapT<FrameBufferHandle,  BGFX_CONFIG_MAX_FRAME_BUFFERS>  m_frameBuffer;
+		HandleRemapT<UniformHandle,      BGFX_CONFIG_MAX_UNIFORMS>       m_uniform;
+
+		// Captured handles of transient buffer pages, page ii is replayed
+		// into page ii of frame.
+		VertexBufferHandle m_transientVb[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		IndexBufferHandle  m_transientIb[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		uint32_t           m_numTransientVb;
+		uint32_t           m_numTransientIb;
+	};
+
+	FrameReplay* frameReplayCreate()
+	{
+		return BX_NEW(g_allocator, FrameReplay);
+	}
+
+	template<typename HandleT>
+	static void destroyHandle(Context* _ctx, CommandBuffer::Enum _cmd, HandleT _handle)
+	{
+		if (isValid(_handle) )
+		{
+			CommandBuffer& cmdbuf = _ctx->getCommandBuffer(_cmd);
+			cmdbuf.write(_handle);
+			_ctx->m_submit->free(_handle);
+		}
+	}
+
+	template<typename HandleT, uint16_t MaxHandlesT>
+	static void destroyAll(Context* _ctx, CommandBuffer::Enum _cmd, CommandBuffer::Enum _dynamicCmd, HandleRemapT<HandleT, MaxHandlesT>& _remap)
+	{
+		for (uint16_t ii = 0; ii < MaxHandlesT; ++ii)
+		{
+			HandleT handle = { _remap.m_idx[ii] };
+			destroyHandle(_ctx, _remap.m_dynamic[ii] ? _dynamicCmd : _cmd, handle);
+		}
+
+		_remap.reset();
+	}
+
+	static void destroyAll(FrameReplay* _replay, Context* _ctx)
+	{
+		destroyAll(_ctx, CommandBuffer::DestroyFrameBuffer,  CommandBuffer::DestroyFrameBuffer,         _replay->m_frameBuffer);
+		destroyAll(_ctx, CommandBuffer::DestroyProgram,      CommandBuffer::DestroyProgram,             _replay->m_program);
+		destroyAll(_ctx, CommandBuffer::DestroyShader,       CommandBuffer::DestroyShader,              _replay->m_shader);
+		destroyAll(_ctx, CommandBuffer::DestroyTexture,      CommandBuffer::DestroyTexture,             _replay->m_texture);
+		destroyAll(_ctx, CommandBuffer::DestroyUniform,      CommandBuffer::DestroyUniform,             _replay->m_uniform);
+		destroyAll(_ctx, CommandBuffer::DestroyVertexBuffer, CommandBuffer::DestroyDynamicVertexBuffer, _replay->m_vertexBuffer);
+		destroyAll(_ctx, CommandBuffer::DestroyIndexBuffer,  CommandBuffer::DestroyDynamicIndexBuffer,  _replay->m_indexBuffer);
+		destroyAll(_ctx, CommandBuffer::DestroyVertexLayout, CommandBuffer::DestroyVertexLayout,        _replay->m_vertexLayout);
+	}
+
+	void frameReplayDestroy(FrameReplay* _replay, Context* _ctx)
+	{
+		if (NULL != _replay)
+		{
+			destroyAll(_replay, _ctx);
+			BX_DELETE(g_allocator, _replay);
+		}
+	}
+
+	static const uint8_t* readData(bx::MemoryReader* _reader, uint32_t _size)
+	{
+		if (_reader->remaining() < int64_t(_size) )
+		{
+			return NULL;
+		}
+
+		const uint8_t* data = _reader->getDataPtr();
+		bx::seek(_reader, _size, bx::Whence::Current);
+		return data;
+	}
+
+	static const Memory* readMemory(bx::MemoryReader* _reader, bx::Error* _err)
+	{
+		uint32_t size = 0;
+		bx::read(_reader, size, _err);
+
+		const uint8_t* data = readData(_reader, size);
+
+		if (!_err->isOk()
+		||  NULL == data
+		||  0    == size)
+		{
+			return NULL;
+		}
+
+		return copy(data, size);
+	}
+
+	static const char* readString(bx::MemoryReader* _reader, uint32_t _len)
+	{
+		const char* str = (const char*)readData(_reader, _len);
+
+		if (NULL == str
+		||  0    == _len
+		||  '\0' != str[_len-1])
+		{
+			return NULL;
+		}
+
+		return str;
+	}
+
+	static VertexBufferHandle remapVertexBuffer(const FrameReplay* _replay, const Frame* _frame, VertexBufferHandle _handle)
+	{
+		for (uint32_t ii = 0, num = _replay->m_numTransientVb; ii < num && isValid(_handle); ++ii)
+		{
+			if (_handle.idx == _replay->m_transientVb[ii].idx)
+			{
+				return _frame->m_transientVb[ii]->handle;
+			}
+		}
+
+		return _replay->m_vertexBuffer.find(_handle);
+	}
+
+	static IndexBufferHandle remapIndexBuffer(const FrameReplay* _replay, const Frame* _frame, IndexBufferHandle _handle)
+	{
+		for (uint32_t ii = 0, num = _replay->m_numTransientIb; ii < num && isValid(_handle); ++ii)
+		{
+			if (_handle.idx == _replay->m_transientIb[ii].idx)
+			{
+				return _frame->m_transientIb[ii]->handle;
+			}
+		}
+
+		return _replay->m_indexBuffer.find(_handle);
+	}
+
+	static void initTextureRef(Context* _ctx, TextureHandle _handle, const Memory* _mem, uint64_t _flags)
+	{
+		TextureRef& ref = _ctx->m_textureRef[_handle.idx];
+
+		bimg::ImageContainer imageContainer;
+		if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+		{
+			ref.init(
+				  BackbufferRatio::Count
+				, uint16_t(imageContainer.m_width)
+				, uint16_t(imageContainer.m_height)
+				, uint16_t(imageContainer.m_depth)
+				, TextureFormat::Enum(imageContainer.m_format)
+				, 0
+				, imageContainer.m_numMips
+				, imageContainer.m_numLayers
+				, false
+				, false
+				, imageContainer.m_cubeMap
+				, _flags
+				);
+		}
+		else
+		{
+			ref.init(BackbufferRatio::Count, 0, 0, 0, TextureFormat::Unknown, 0, 0, 0, false, false, false, _flags);
+		}
+	}
+
+	static bool replayCommands(FrameReplay* _replay, Context* _ctx, bx::MemoryReader* _reader, bx::Error* _err)
+	{
+		for (;;)
+		{
+			uint8_t command = CommandBuffer::End;
+			bx::read(_reader, command, _err);
+
+			if (!_err->isOk() )
+			{
+				return false;
+			}
+
+			switch (command)
+			{
+			case CommandBuffer::End:
+				return true;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = readMemory(_reader, _err);
+
+					uint16_t flags;
+					bx::read(_reader, flags, _err);
+
+					if (!_err->isOk()
+					||  NULL == mem)
+					{
+						return false;
+					}
+
+					handle = _replay->m_indexBuffer.create(handle, _ctx->m_indexBufferHandle);
+
+					if (isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateIndexBuffer);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+						cmdbuf.write(flags);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateVertexLayout:
+				{
+					VertexLayoutHandle handle;
+					bx::read(_reader, handle, _err);
+
+					VertexLayout layout;
+					bx::read(_reader, layout, _err);
+
+					if (!_err->isOk() )
+					{
+						return false;
+					}
+
+					handle = _replay->m_vertexLayout.create(handle, _ctx->m_layoutHandle);
+
+					if (isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateVertexLayout);
+						cmdbuf.write(handle);
+						cmdbuf.write(layout);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = readMemory(_reader, _err);
+
+					VertexLayoutHandle layoutHandle;
+					bx::read(_reader, layoutHandle, _err);
+
+					uint16_t flags;
+					bx::read(_reader, flags, _err);
+
+					if (!_err->isOk()
+					||  NULL == mem)
+					{
+						return false;
+					}
+
+					handle = _replay->m_vertexBuffer.create(handle, _ctx->m_vertexBufferHandle);
+
+					if (isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateVertexBuffer);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+						cmdbuf.write(_replay->m_vertexLayout.find(layoutHandle) );
+						cmdbuf.write(flags);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx, _err);
+
+					uint32_t size;
+					bx::read(_reader, size, _err);
+
+					uint16_t flags;
+					bx::read(_reader, flags, _err);
+
+					if (!_err->isOk() )
+					{
+						return false;
+					}
+
+					if (CommandBuffer::CreateDynamicIndexBuffer == command)
+					{
+						IndexBufferHandle handle = { idx };
+						idx = _replay->m_indexBuffer.create(handle, _ctx->m_indexBufferHandle, true).idx;
+					}
+					else
+					{
+						VertexBufferHandle handle = { idx };
+						idx = _replay->m_vertexBuffer.create(handle, _ctx->m_vertexBufferHandle, true).idx;
+					}
+
+					if (kInvalidHandle != idx)
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::Enum(command) );
+						cmdbuf.write(idx);
+						cmdbuf.write(size);
+						cmdbuf.write(flags);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx, _err);
+
+					uint32_t offset;
+					bx::read(_reader, offset, _err);
+
+					uint32_t size;
+					bx::read(_reader, size, _err);
+
+					const Memory* mem = readMemory(_reader, _err);
+
+					if (!_err->isOk()
+					||  NULL == mem)
+					{
+						return false;
+					}
+
+					if (CommandBuffer::UpdateDynamicIndexBuffer == command)
+					{
+						IndexBufferHandle handle = { idx };
+						idx = _replay->m_indexBuffer.find(handle).idx;
+					}
+					else
+					{
+						VertexBufferHandle handle = { idx };
+						idx = _replay->m_vertexBuffer.find(handle).idx;
+					}
+
+					if (kInvalidHandle != idx)
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::Enum(command) );
+						cmdbuf.write(idx);
+						cmdbuf.write(offset);
+						cmdbuf.write(size);
+						cmdbuf.write(mem);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					ShaderHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = readMemory(_reader, _err);
+
+					if (!_err->isOk()
+					||  NULL == mem)
+					{
+						return false;
+					}
+
+					handle = _replay->m_shader.create(handle, _ctx->m_shaderHandle);
+
+					if (isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateShader);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				{
+					ProgramHandle handle;
+					bx::read(_reader, handle, _err);
+
+					ShaderHandle vsh;
+					bx::read(_reader, vsh, _err);
+
+					ShaderHandle fsh;
+					bx::read(_reader, fsh, _err);
+
+					if (!_err->isOk() )
+					{
+						return false;
+					}
+
+					vsh = _replay->m_shader.find(vsh);
+					fsh = _replay->m_shader.find(fsh);
+
+					if (isValid(vsh) )
+					{
+						handle = _replay->m_program.create(handle, _ctx->m_programHandle);
+
+						if (isValid(handle) )
+						{
+							CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateProgram);
+							cmdbuf.write(handle);
+							cmdbuf.write(vsh);
+							cmdbuf.write(fsh);
+						}
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = readMemory(_reader, _err);
+
+					uint64_t flags;
+					bx::read(_reader, flags, _err);
+
+					uint8_t skip;
+					bx::read(_reader, skip, _err);
+
+					bool hasContent;
+					bx::read(_reader, hasContent, _err);
+
+					const Memory* content = hasContent ? readMemory(_reader, _err) : NULL;
+
+					if (!_err->isOk()
+					||  NULL == mem
+					||  hasContent != (NULL != content) )
+					{
+						if (NULL != mem)
+						{
+							release(mem);
+						}
+
+						return false;
+					}
+
+					// Patch content pointer of texture chunk.
+					bx::MemoryReader reader(mem->data, mem->size);
+
+					uint32_t magic = 0;
+					bx::read(&reader, magic);
+
+					if (BGFX_CHUNK_MAGIC_TEX == magic)
+					{
+						TextureCreate tc;
+						bx::read(&reader, tc);
+						tc.m_mem = content;
+
+						bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+						bx::write(&writer, magic);
+						bx::write(&writer, tc);
+					}
+					else if (NULL != content)
+					{
+						release(content);
+						content = NULL;
+					}
+
+					handle = _replay->m_texture.create(handle, _ctx->m_textureHandle);
+
+					if (isValid(handle) )
+					{
+						initTextureRef(_ctx, handle, mem, flags);
+
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateTexture);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+						cmdbuf.write(flags);
+						cmdbuf.write(skip);
+					}
+					else
+					{
+						if (NULL != content)
+						{
+							release(content);
+						}
+
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle, _err);
+
+					uint8_t side;
+					bx::read(_reader, side, _err);
+
+					uint8_t mip;
+					bx::read(_reader, mip, _err);
+
+					Rect rect;
+					bx::read(_reader, rect, _err);
+
+					uint16_t zz;
+					bx::read(_reader, zz, _err);
+
+					uint16_t depth;
+					bx::read(_reader, depth, _err);
+
+					uint16_t pitch;
+					bx::read(_reader, pitch, _err);
+
+					const Memory* mem = readMemory(_reader, _err);
+
+					if (!_err->isOk()
+					||  NULL == mem)
+					{
+						return false;
+					}
+
+					handle = _replay->m_texture.find(handle);
+
+					if (isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::UpdateTexture);
+						cmdbuf.write(handle);
+						cmdbuf.write(side);
+						cmdbuf.write(mip);
+						cmdbuf.write(rect);
+						cmdbuf.write(zz);
+						cmdbuf.write(depth);
+						cmdbuf.write(pitch);
+						cmdbuf.write(mem);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle, _err);
+
+					uint16_t width;
+					bx::read(_reader, width, _err);
+
+					uint16_t height;
+					bx::read(_reader, height, _err);
+
+					uint8_t numMips;
+					bx::read(_reader, numMips, _err);
+
+					uint16_t numLayers;
+					bx::read(_reader, numLayers, _err);
+
+					if (!_err->isOk() )
+					{
+						return false;
+					}
+
+					handle = _replay->m_texture.find(handle);
+
+					if (isValid(handle) )
+					{
+						TextureRef& ref = _ctx->m_textureRef[handle.idx];
+						ref.m_width     = width;
+						ref.m_height    = height;
+						ref.m_numMips   = numMips;
+						ref.m_numLayers = numLayers;
+
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::ResizeTexture);
+						cmdbuf.write(handle);
+						cmdbuf.write(width);
+						cmdbuf.write(height);
+						cmdbuf.write(numMips);
+						cmdbuf.write(numLayers);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					bx::read(_reader, handle, _err);
+
+					bool window;
+					bx::read(_reader, window, _err);
+
+					if (window)
+					{
+						// Native window is not available while replaying, views
+						// rendering into window frame buffer render into back buffer.
+						uint16_t width;
+						bx::read(_reader, width, _err);
+
+						uint16_t height;
+						bx::read(_reader, height, _err);
+
+						TextureFormat::Enum format;
+						bx::read(_reader, format, _err);
+
+						TextureFormat::Enum depthFormat;
+						bx::read(_reader, depthFormat, _err);
+
+						if (!_err->isOk() )
+						{
+							return false;
+						}
+
+						break;
+					}
+
+					uint8_t num = 0;
+					bx::read(_reader, num, _err);
+
+					if (!_err->isOk()
+					||  0 == num
+					||  BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS < num)
+					{
+						return false;
+					}
+
+					Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+					bx::read(_reader, attachment, int32_t(sizeof(Attachment) * num), _err);
+
+					if (!_err->isOk() )
+					{
+						return false;
+					}
+
+					bool valid = true;
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						attachment[ii].handle = _replay->m_texture.find(attachment[ii].handle);
+						valid &= isValid(attachment[ii].handle);
+					}
+
+					if (!valid)
+					{
+						break;
+					}
+
+					handle = _replay->m_frameBuffer.create(handle, _ctx->m_frameBufferHandle);
+
+					if (isValid(handle) )
+					{
+						const TextureRef& firstTexture = _ctx->m_textureRef[attachment[0].handle.idx];
+
+						FrameBufferRef& fbr = _ctx->m_frameBufferRef[handle.idx];
+						fbr.m_width  = bx::max<uint16_t>(firstTexture.m_width  >> attachment[0].mip, 1);
+						fbr.m_height = bx::max<uint16_t>(firstTexture.m_height >> attachment[0].mip, 1);
+						fbr.m_window = false;
+						bx::memSet(fbr.un.m_th, 0xff, sizeof(fbr.un.m_th) );
+
+						for (uint32_t ii = 0; ii < num; ++ii)
+						{
+							fbr.un.m_th[ii] = attachment[ii].handle;
+						}
+
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateFrameBuffer);
+						cmdbuf.write(handle);
+						cmdbuf.write(false);
+						cmdbuf.write(num);
+						cmdbuf.write(attachment, sizeof(Attachment) * num);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					UniformHandle handle;
+					bx::read(_reader, handle, _err);
+
+					UniformType::Enum type;
+					bx::read(_reader, type, _err);
+
+					uint16_t num;
+					bx::read(_reader, num, _err);
+
+					uint8_t len = 0;
+					bx::read(_reader, len, _err);
+
+					const char* name = readString(_reader, len);
+
+					if (!_err->isOk()
+					||  NULL == name)
+					{
+						return false;
+					}
+
+					handle = _replay->m_uniform.create(handle, _ctx->m_uniformHandle);
+
+					if (isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::CreateUniform);
+						cmdbuf.write(handle);
+						cmdbuf.write(type);
+						cmdbuf.write(num);
+						cmdbuf.write(len);
+						cmdbuf.write(name, len);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					ViewId id;
+					bx::read(_reader, id, _err);
+
+					uint16_t len = 0;
+					bx::read(_reader, len, _err);
+
+					const char* name = readString(_reader, len);
+
+					if (!_err->isOk()
+					||  NULL == name
+					||  BGFX_CONFIG_MAX_VIEWS <= id)
+					{
+						return false;
+					}
+
+					CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::UpdateViewName);
+					cmdbuf.write(id);
+					cmdbuf.write(len);
+					cmdbuf.write(name, len);
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					Handle handle;
+					bx::read(_reader, handle, _err);
+
+					uint16_t len = 0;
+					bx::read(_reader, len, _err);
+
+					const char* name = readString(_reader, len);
+
+					if (!_err->isOk()
+					||  NULL == name)
+					{
+						return false;
+					}
+
+					switch (handle.type)
+					{
+					case Handle::IndexBuffer:  handle.idx = _replay->m_indexBuffer.find( { handle.idx } ).idx; break;
+					case Handle::Shader:       handle.idx = _replay->m_shader.find(      { handle.idx } ).idx; break;
+					case Handle::Texture:      handle.idx = _replay->m_texture.find(     { handle.idx } ).idx; break;
+					case Handle::VertexBuffer: handle.idx = _replay->m_vertexBuffer.find({ handle.idx } ).idx; break;
+					default:                   handle.idx = kInvalidHandle;                                  break;
+					}
+
+					if (kInvalidHandle != handle.idx)
+					{
+						CommandBuffer& cmdbuf = _ctx->getCommandBuffer(CommandBuffer::SetName);
+						cmdbuf.write(handle);
+						cmdbuf.write(len);
+						cmdbuf.write(name, len);
+					}
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexLayout:
+			case CommandBuffer::DestroyIndexBuffer:
+			case CommandBuffer::DestroyVertexBuffer:
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+			case CommandBuffer::DestroyShader:
+			case CommandBuffer::DestroyProgram:
+			case CommandBuffer::DestroyTexture:
+			case CommandBuffer::DestroyFrameBuffer:
+			case CommandBuffer::DestroyUniform:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx, _err);
+
+					if (!_err->isOk() )
+					{
+						return false;
+					}
+
+					const CommandBuffer::Enum cmd = CommandBuffer::Enum(command);
+
+					switch (cmd)
+					{
+					case CommandBuffer::DestroyVertexLayout:        destroyHandle(_ctx, cmd, _replay->m_vertexLayout.destroy({ idx } ) ); break;
+					case CommandBuffer::DestroyIndexBuffer:
+					case CommandBuffer::DestroyDynamicIndexBuffer:  destroyHandle(_ctx, cmd, _replay->m_indexBuffer.destroy( { idx } ) ); break;
+					case CommandBuffer::DestroyVertexBuffer:
+					case CommandBuffer::DestroyDynamicVertexBuffer: destroyHandle(_ctx, cmd, _replay->m_vertexBuffer.destroy({ idx } ) ); break;
+					case CommandBuffer::DestroyShader:              destroyHandle(_ctx, cmd, _replay->m_shader.destroy(      { idx } ) ); break;
+					case CommandBuffer::DestroyProgram:             destroyHandle(_ctx, cmd, _replay->m_program.destroy(     { idx } ) ); break;
+					case CommandBuffer::DestroyTexture:             destroyHandle(_ctx, cmd, _replay->m_texture.destroy(     { idx } ) ); break;
+					case CommandBuffer::DestroyFrameBuffer:         destroyHandle(_ctx, cmd, _replay->m_frameBuffer.destroy( { idx } ) ); break;
+					default:                                        destroyHandle(_ctx, cmd, _replay->m_uniform.destroy(     { idx } ) ); break;
+					}
+				}
+				break;
+
+			default:
+				BX_TRACE("Frame replay: Invalid command %d.", command);
+				return false;
+			}
+		}
+	}
+
+	static uint64_t remapSortKeyProgram(const FrameReplay* _replay, uint64_t _key)
+	{
+		uint64_t mask;
+		uint8_t  shift;
+
+		if (0 == (_key & kSortKeyDrawBit) )
+		{
+			mask  = kSortKeyComputeProgramMask;
+			shift = kSortKeyComputeProgramShift;
+		}
+		else
+		{
+			switch (_key & kSortKeyDrawTypeMask)
+			{
+			case kSortKeyDrawTypeProgram: mask = kSortKeyDraw0ProgramMask; shift = kSortKeyDraw0ProgramShift; break;
+			case kSortKeyDrawTypeDepth:   mask = kSortKeyDraw1ProgramMask; shift = kSortKeyDraw1ProgramShift; break;
+			default:                      mask = kSortKeyDraw2ProgramMask; shift = kSortKeyDraw2ProgramShift; break;
+			}
+		}
+
+		ProgramHandle program = { uint16_t( (_key & mask) >> shift) };
+		program = _replay->m_program.find(program);
+
+		if (!isValid(program) )
+		{
+			return _key;
+		}
+
+		return (_key & ~mask) | ( (uint64_t(program.idx) << shift) & mask);
+	}
+
+	static void remapBind(const FrameReplay* _replay, const Frame* _frame, RenderBind& _bind)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		{
+			Binding& bind = _bind.m_bind[ii];
+
+			if (kInvalidHandle == bind.m_idx)
+			{
+				continue;
+			}
+
+			switch (bind.m_type)
+			{
+			case Binding::Image:
+			case Binding::Texture:
+				bind.m_idx = _replay->m_texture.find( { bind.m_idx } ).idx;
+				break;
+
+			case Binding::IndexBuffer:
+				bind.m_idx = remapIndexBuffer(_replay, _frame, { bind.m_idx } ).idx;
+				break;
+
+			case Binding::VertexBuffer:
+				bind.m_idx = remapVertexBuffer(_replay, _frame, { bind.m_idx } ).idx;
+				break;
+
+			default:
+				bind.m_idx = kInvalidHandle;
+				break;
+			}
+		}
+	}
+
+	// Captured uniform buffer is appended at _base, references to values
+	// written earlier in the same buffer are rebased.
+	static bool replayUniforms(FrameReplay* _replay, Frame* _frame, const uint8_t* _data, uint32_t _size, uint32_t _base)
+	{
+		UniformBuffer* uniformBuffer = _frame->m_uniformBuffer[0];
+
+		for (uint32_t pos = 0; pos + sizeof(uint32_t) <= _size;)
+		{
+			uint32_t opcode;
+			bx::memCopy(&opcode, &_data[pos], sizeof(uint32_t) );
+			pos += sizeof(uint32_t);
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			if (UniformType::Count < type)
+			{
+				return false;
+			}
+
+			const bool isRef = UniformType::Count != type && !copy;
+			const uint32_t size = isRef ? sizeof(uint32_t) : g_uniformTypeSize[type]*num;
+			if (pos + size > _size)
+			{
+				return false;
+			}
+
+			if (UniformType::Count != type)
+			{
+				loc = _replay->m_uniform.find( { loc } ).idx;
+
+				if (kInvalidHandle == loc)
+				{
+					BX_TRACE("Frame replay: Uniform is not created.");
+					return false;
+				}
+
+				opcode = UniformBuffer::encodeOpcode(type, loc, num, copy);
+			}
+
+			uniformBuffer->write(opcode);
+
+			if (isRef)
+			{
+				uint32_t ref;
+				bx::memCopy(&ref, &_data[pos], sizeof(uint32_t) );
+
+				if (ref + g_uniformTypeSize[type]*num > pos - sizeof(uint32_t) )
+				{
+					return false;
+				}
+
+				uniformBuffer->write(_base + ref);
+			}
+			else
+			{
+				uniformBuffer->write(&_data[pos], size);
+			}
+
+			pos += size;
+		}
+
+		return true;
+	}
+
+	struct TransientPageData
+	{
+		uint16_t       handle;
+		uint32_t       used;
+		const uint8_t* data;
+	};
+
+	// Reads pages written by writeTransientPages, returns UINT32_MAX when
+	// data is invalid or captured pages don't fit into pages of _pageSize.
+	static uint32_t readTransientPages(bx::MemoryReader* _reader, TransientPageData* _outPage, uint32_t _pageSize, bx::Error* _err)
+	{
+		uint32_t numPages = 0;
+		bx::read(_reader, numPages, _err);
+
+		if (!_err->isOk()
+		||  numPages > Frame::getTransientMaxPages(_pageSize) )
+		{
+			return UINT32_MAX;
+		}
+
+		for (uint32_t ii = 0; ii < numPages; ++ii)
+		{
+			TransientPageData& page = _outPage[ii];
+			bx::read(_reader, page.handle, _err);
+			bx::read(_reader, page.used, _err);
+			page.data = readData(_reader, page.used);
+
+			if (!_err->isOk()
+			||  NULL == page.data
+			||  page.used > _pageSize)
+			{
+				return UINT32_MAX;
+			}
+		}
+
+		return numPages;
+	}
+
+	static bool replayFrameData(FrameReplay* _replay, Context* _ctx, bx::MemoryReader* _reader, bx::Error* _err)
+	{
+		Frame* frame = _ctx->m_submit;
+
+		// Transient buffers.
+		const uint32_t vbPageSize = g_caps.limits.transientVbSize;
+		const uint32_t ibPageSize = g_caps.limits.transientIbSize;
+
+		TransientPageData vbPage[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		TransientPageData ibPage[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		const uint32_t numVbPages = readTransientPages(_reader, vbPage, vbPageSize, _err);
+		const uint32_t numIbPages = UINT32_MAX != numVbPages ? readTransientPages(_reader, ibPage, ibPageSize, _err) : UINT32_MAX;
+
+		if (UINT32_MAX == numVbPages
+		||  UINT32_MAX == numIbPages)
+		{
+			BX_TRACE("Frame replay: Invalid transient buffer data, or transient buffer pages are too small.");
+			return false;
+		}
+
+		if (0 != frame->m_vboffset
+		||  0 != frame->m_iboffset)
+		{
+			BX_TRACE("Frame replay: Transient buffers are already used.");
+			return false;
+		}
+
+		_replay->m_numTransientVb = numVbPages;
+		for (uint32_t ii = 0; ii < numVbPages; ++ii)
+		{
+			_replay->m_transientVb[ii].idx = kInvalidHandle;
+
+			if (0 != vbPage[ii].used)
+			{
+				TransientVertexBuffer* tvb = _ctx->getTransientVertexBufferPage(frame, ii);
+				if (NULL == tvb)
+				{
+					BX_TRACE("Frame replay: Failed to create transient vertex buffer page %d.", ii);
+					return false;
+				}
+
+				bx::memCopy(tvb->data, vbPage[ii].data, vbPage[ii].used);
+				_replay->m_transientVb[ii].idx = vbPage[ii].handle;
+				frame->m_vboffset = ii*vbPageSize + vbPage[ii].used;
+			}
+		}
+
+		_replay->m_numTransientIb = numIbPages;
+		for (uint32_t ii = 0; ii < numIbPages; ++ii)
+		{
+			_replay->m_transientIb[ii].idx = kInvalidHandle;
+
+			if (0 != ibPage[ii].used)
+			{
+				TransientIndexBuffer* tib = _ctx->getTransientIndexBufferPage(frame, ii);
+				if (NULL == tib)
+				{
+					BX_TRACE("Frame replay: Failed to create transient index buffer page %d.", ii);
+					return false;
+				}
+
+				bx::memCopy(tib->data, ibPage[ii].data, ibPage[ii].used);
+				_replay->m_transientIb[ii].idx = ibPage[ii].handle;
+				frame->m_iboffset = ii*ibPageSize + ibPage[ii].used;
+			}
+		}
+
+		// Views, are copied into frame on swap.
+		const uint8_t* view      = readData(_reader, sizeof(_ctx->m_view) );
+		const uint8_t* viewRemap = readData(_reader, sizeof(_ctx->m_viewRemap) );
+		const uint8_t* palette   = readData(_reader, sizeof(_ctx->m_clearColor) );
+
+		if (NULL == view
+		||  NULL == viewRemap
+		||  NULL == palette)
+		{
+			return false;
+		}
+
+		bx::memCopy(_ctx->m_view, view, sizeof(_ctx->m_view) );
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			_ctx->m_view[ii].m_fbh = _replay->m_frameBuffer.find(_ctx->m_view[ii].m_fbh);
+		}
+
+		bx::memCopy(_ctx->m_viewRemap,  viewRemap, sizeof(_ctx->m_viewRemap) );
+		bx::memCopy(_ctx->m_clearColor, palette,   sizeof(_ctx->m_clearColor) );
+		_ctx->m_colorPaletteDirty = 2;
+
+		// Frame cache. First matrix is always identity, and it's not copied.
+		uint32_t numMatrices = 0;
+		bx::read(_reader, numMatrices, _err);
+		const uint8_t* matrices = readData(_reader, sizeof(Matrix4)*numMatrices);
+
+		uint32_t numRects = 0;
+		bx::read(_reader, numRects, _err);
+		const uint8_t* rects = readData(_reader, sizeof(Rect)*numRects);
+
+		if (!_err->isOk()
+		||  NULL == matrices
+		||  NULL == rects
+		||  0    == numMatrices)
+		{
+			return false;
+		}
+
+		MatrixCache& matrixCache = frame->m_frameCache.m_matrixCache;
+		uint16_t numReserved = uint16_t(bx::min<uint32_t>(numMatrices-1, UINT16_MAX) );
+		const uint32_t firstMatrix = matrixCache.reserve(&numReserved);
+
+		RectCache& rectCache = frame->m_frameCache.m_rectCache;
+		const uint32_t firstRect = bx::atomicFetchAndAddsat<uint32_t>(&rectCache.m_num, numRects, BGFX_CONFIG_MAX_RECT_CACHE);
+
+		if (uint32_t(numReserved) != numMatrices-1
+		||  firstRect + numRects > BGFX_CONFIG_MAX_RECT_CACHE)
+		{
+			BX_TRACE("Frame replay: Frame cache overflow.");
+			return false;
+		}
+
+		bx::memCopy(&matrixCache.m_cache[firstMatrix], &matrices[sizeof(Matrix4)], sizeof(Matrix4)*numReserved);
+		bx::memCopy(&rectCache.m_cache[firstRect], rects, sizeof(Rect)*numRects);
+
+		// Render items.
+		uint32_t numRenderItems = 0;
+		bx::read(_reader, numRenderItems, _err);
+		const uint8_t* renderItems = readData(_reader, sizeof(RenderItem)*numRenderItems);
+		const uint8_t* renderBinds = readData(_reader, sizeof(RenderBind)*numRenderItems);
+
+		uint32_t numKeys = 0;
+		bx::read(_reader, numKeys, _err);
+		const uint8_t* keys   = readData(_reader, sizeof(uint64_t)*numKeys);
+		const uint8_t* values = readData(_reader, sizeof(RenderItemCount)*numKeys);
+
+		if (!_err->isOk()
+		||  NULL == renderItems
+		||  NULL == renderBinds
+		||  NULL == keys
+		||  NULL == values)
+		{
+			return false;
+		}
+
+		const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+		const uint32_t firstItem = bx::atomicFetchAndAddsat<uint32_t>(&frame->m_numRenderItems, numRenderItems, maxDrawCalls);
+
+		if (firstItem + numRenderItems > maxDrawCalls)
+		{
+			BX_TRACE("Frame replay: Too many draw calls %d (max: %d).", firstItem + numRenderItems, maxDrawCalls);
+			return false;
+		}
+
+		bx::memCopy(&frame->m_renderItem[firstItem],     renderItems, sizeof(RenderItem)*numRenderItems);
+		bx::memCopy(&frame->m_renderItemBind[firstItem], renderBinds, sizeof(RenderBind)*numRenderItems);
+
+		// Uniform buffers of all encoders are appended into first one.
+		uint32_t numUniformBuffers = 0;
+		bx::read(_reader, numUniformBuffers, _err);
+
+		if (!_err->isOk()
+		||  kMaxEncoders < numUniformBuffers)
+		{
+			return false;
+		}
+
+		uint32_t uniformBase[kMaxEncoders];
+
+		for (uint32_t ii = 0; ii < numUniformBuffers; ++ii)
+		{
+			uint32_t size = 0;
+			bx::read(_reader, size, _err);
+			const uint8_t* data = readData(_reader, size);
+
+			if (!_err->isOk()
+			||  NULL == data)
+			{
+				return false;
+			}
+
+			UniformBuffer::update(&frame->m_uniformBuffer[0], size + sizeof(uint32_t), size + sizeof(uint32_t) );
+			uniformBase[ii] = frame->m_uniformBuffer[0]->getPos();
+
+			if (!replayUniforms(_replay, frame, data, size, uniformBase[ii]) )
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t ii = 0; ii < numKeys; ++ii)
+		{
+			uint64_t key;
+			bx::memCopy(&key, &keys[ii*sizeof(uint64_t)], sizeof(uint64_t) );
+
+			RenderItemCount value;
+			bx::memCopy(&value, &values[ii*sizeof(RenderItemCount)], sizeof(RenderItemCount) );
+
+			if (value >= numRenderItems)
+			{
+				return false;
+			}
+
+			value += firstItem;
+
+			RenderItem& item = frame->m_renderItem[value];
+
+			// Key goes back to sort key buffer of encoder that submitted it,
+			// so that replay merges the same number of encoder key lists.
+			uint8_t encoder = 0;
+
+			if (0 != (key & kSortKeyDrawBit) )
+			{
+				RenderDraw& draw = item.draw;
+
+				for (uint32_t stream = 0; stream < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++stream)
+				{
+					if (0 != (draw.m_streamMask & (1<<stream) ) )
+					{
+						Stream& st = draw.m_stream[stream];
+						st.m_handle       = remapVertexBuffer(_replay, frame, st.m_handle);
+						st.m_layoutHandle = _replay->m_vertexLayout.find(st.m_layoutHandle);
+					}
+				}
+
+				draw.m_indexBuffer        = remapIndexBuffer(_replay, frame, draw.m_indexBuffer);
+				draw.m_instanceDataBuffer = remapVertexBuffer(_replay, frame, draw.m_instanceDataBuffer);
+				draw.m_indirectBuffer.idx = remapVertexBuffer(_replay, frame, { draw.m_indirectBuffer.idx } ).idx;
+				draw.m_occlusionQuery.idx = kInvalidHandle;
+
+				if (0 != draw.m_startMatrix)
+				{
+					draw.m_startMatrix += firstMatrix - 1;
+				}
+
+				if (UINT16_MAX != draw.m_scissor)
+				{
+					draw.m_scissor = uint16_t(draw.m_scissor + firstRect);
+				}
+
+				if (draw.m_uniformIdx < numUniformBuffers)
+				{
+					encoder = draw.m_uniformIdx;
+					draw.m_uniformBegin += uniformBase[draw.m_uniformIdx];
+					draw.m_uniformEnd   += uniformBase[draw.m_uniformIdx];
+					draw.m_uniformIdx    = 0;
+				}
+			}
+			else
+			{
+				RenderCompute& compute = item.compute;
+
+				compute.m_indirectBuffer.idx = remapVertexBuffer(_replay, frame, { compute.m_indirectBuffer.idx } ).idx;
+
+				if (0 != compute.m_startMatrix)
+				{
+					compute.m_startMatrix += firstMatrix - 1;
+				}
+
+				if (compute.m_uniformIdx < numUniformBuffers)
+				{
+					encoder = compute.m_uniformIdx;
+					compute.m_uniformBegin += uniformBase[compute.m_uniformIdx];
+					compute.m_uniformEnd   += uniformBase[compute.m_uniformIdx];
+					compute.m_uniformIdx    = 0;
+				}
+			}
+
+			remapBind(_replay, frame, frame->m_renderItemBind[value]);
+
+			if (encoder >= g_caps.limits.maxEncoders)
+			{
+				encoder = 0;
+			}
+
+			frame->m_sortKeyBuffer[encoder].add(remapSortKeyProgram(_replay, key), value);
+		}
+
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+		{
+			frame->m_sortKeyBuffer[ii].sort();
+		}
+
+		// Blits.
+		uint16_t numBlitItems = 0;
+		bx::read(_reader, numBlitItems, _err);
+		const uint8_t* blitKeys  = readData(_reader, sizeof(uint32_t)*numBlitItems);
+		const uint8_t* blitItems = readData(_reader, sizeof(BlitItem)*numBlitItems);
+
+		if (!_err->isOk()
+		||  NULL == blitKeys
+		||  NULL == blitItems
+		||  frame->m_numBlitItems + numBlitItems > BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			return false;
+		}
+
+		for (uint32_t ii = 0; ii < numBlitItems; ++ii)
+		{
+			const uint16_t item = frame->m_numBlitItems++;
+
+			uint32_t key;
+			bx::memCopy(&key, &blitKeys[ii*sizeof(uint32_t)], sizeof(uint32_t) );
+
+			BlitKey bk;
+			bk.decode(key);
+			bk.m_item = item;
+			frame->m_blitKeys[item] = bk.encode();
+
+			BlitItem& bi = frame->m_blitItem[item];
+			bx::memCopy(&bi, &blitItems[ii*sizeof(BlitItem)], sizeof(BlitItem) );
+			bi.m_src = _replay->m_texture.find(bi.m_src);
+			bi.m_dst = _replay->m_texture.find(bi.m_dst);
+		}
+
+		return true;
+	}
+
+	uint32_t frameReplay(FrameReplay* _replay, Context* _ctx, const void* _data, uint32_t _size, uint32_t _offset)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Replay frame", 0xff2040ff);
+
+		bx::Error err;
+		bx::MemoryReader reader(_data, _size);
+
+		if (0 == _offset)
+		{
+			destroyAll(_replay, _ctx);
+
+			CaptureHeader expected;
+			initHeader(expected);
+
+			CaptureHeader header;
+			bx::read(&reader, header, &err);
+
+			if (!err.isOk()
+			||  0 != bx::memCmp(&header, &expected, sizeof(CaptureHeader) ) )
+			{
+				BX_TRACE("Frame replay: Capture was written by different version or configuration of library.");
+				return UINT32_MAX;
+			}
+		}
+		else
+		{
+			bx::seek(&reader, _offset, bx::Whence::Begin);
+		}
+
+		if (0 == reader.remaining() )
+		{
+			return _size;
+		}
+
+		uint32_t magic = 0;
+		bx::read(&reader, magic, &err);
+
+		uint32_t commandsSize = 0;
+		bx::read(&reader, commandsSize, &err);
+
+		const int64_t commandsEnd = bx::seek(&reader) + commandsSize;
+
+		if (!err.isOk()
+		||  kCaptureFrameMagic != magic
+		||  !replayCommands(_replay, _ctx, &reader, &err)
+		||  commandsEnd != bx::seek(&reader)
+		||  !replayFrameData(_replay, _ctx, &reader, &err) )
+		{
+			BX_TRACE("Frame replay: Invalid frame capture data at offset %d.", _offset);
+			return UINT32_MAX;
+		}
+
+		return uint32_t(bx::seek(&reader) );
+	}
+
+} // namespace bgfx
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_DEBUG_CAPTURE_H_HEADER_GUARD
+#define BGFX_DEBUG_CAPTURE_H_HEADER_GUARD
+
+namespace bgfx
+{
+	struct Context;
+	struct Frame;
+	class  CommandBuffer;
+
+	struct FrameCapture;
+	struct FrameReplay;
+
+	/// Render thread side. Records resource commands from every frame, and
+	/// writes them together with frame data for frames marked for capture.
+	FrameCapture* frameCaptureCreate(const char* _filePath);
+	void frameCaptureDestroy(FrameCapture* _capture);
+	void frameCaptureCommands(FrameCapture* _capture, CommandBuffer& _cmdbuf);
+	void frameCaptureFrame(FrameCapture* _capture, Frame* _frame);
+
+	/// API thread side. Reads one captured frame and submits it into context.
+	FrameReplay* frameReplayCreate();
+	void frameReplayDestroy(FrameReplay* _replay, Context* _ctx);
+	uint32_t frameReplay(FrameReplay* _replay, Context* _ctx, const void* _data, uint32_t _size, uint32_t _offset);
+
+} // namespace bgfx
+
+#endif // BGFX_DEBUG_CAPTURE_H_HEADER_GUARD
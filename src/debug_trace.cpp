@@ -0,0 +1,304 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+
+#include <bx/file.h>
+
+namespace bgfx
+{
+	TraceRecorder* g_traceRecorder = NULL;
+
+	// Chrome trace process ids, CPU threads and GPU timeline are shown as
+	// separate processes.
+	constexpr uint32_t kTracePidCpu = 1;
+	constexpr uint32_t kTracePidGpu = 2;
+
+	struct TraceEvent
+	{
+		int64_t  m_begin;
+		int64_t  m_end;
+		uint32_t m_tid;
+		uint32_t m_pid;
+		uint32_t m_seq;      // Write position + 1 once event is written, 0 while it's being written.
+		char     m_name[36]; // Last byte is always 0, reading while writing can't run past the end.
+	};
+
+	struct TraceThread
+	{
+		uint32_t m_tid;
+		char     m_name[32];
+	};
+
+	struct TraceRecorder
+	{
+		TraceRecorder(uint32_t _maxEvents)
+			: m_maxEvents(bx::max<uint32_t>(_maxEvents, 1) )
+			, m_write(0)
+			, m_numThreads(0)
+			, m_base(bx::getHPCounter() )
+		{
+			m_event = (TraceEvent*)BX_ALLOC(g_allocator, m_maxEvents*sizeof(TraceEvent) );
+			bx::memSet(m_event, 0, m_maxEvents*sizeof(TraceEvent) );
+		}
+
+		~TraceRecorder()
+		{
+			BX_FREE(g_allocator, m_event);
+		}
+
+		TraceEvent* m_event;
+		uint32_t m_maxEvents;
+		uint32_t m_write; // Only grows, modulo m_maxEvents is position in ring.
+
+		bx::Mutex   m_threadLock;
+		TraceThread m_thread[16];
+		uint32_t    m_numThreads;
+
+		int64_t m_base;
+	};
+
+	TraceRecorder* traceRecorderCreate(uint32_t _maxEvents)
+	{
+		return BX_NEW(g_allocator, TraceRecorder)(_maxEvents);
+	}
+
+	void traceRecorderDestroy(TraceRecorder* _recorder)
+	{
+		if (NULL != _recorder)
+		{
+			BX_DELETE(g_allocator, _recorder);
+		}
+	}
+
+	void traceSetThreadName(TraceRecorder* _recorder, uint32_t _tid, const char* _name)
+	{
+		if (NULL == _recorder)
+		{
+			return;
+		}
+
+		bx::MutexScope lock(_recorder->m_threadLock);
+
+		uint32_t idx = 0;
+		for (; idx < _recorder->m_numThreads; ++idx)
+		{
+			if (_tid == _recorder->m_thread[idx].m_tid)
+			{
+				break;
+			}
+		}
+
+		if (idx == _recorder->m_numThreads)
+		{
+			if (idx == BX_COUNTOF(_recorder->m_thread) )
+			{
+				return;
+			}
+
+			++_recorder->m_numThreads;
+		}
+
+		TraceThread& thread = _recorder->m_thread[idx];
+		thread.m_tid = _tid;
+		bx::strCopy(thread.m_name, BX_COUNTOF(thread.m_name), _name);
+	}
+
+	static void record(TraceRecorder* _recorder, const char* _name, uint32_t _pid, uint32_t _tid, int64_t _begin, int64_t _end)
+	{
+		const uint32_t pos = bx::atomicFetchAndAdd<uint32_t>(&_recorder->m_write, 1);
+
+		TraceEvent& event = _recorder->m_event[pos % _recorder->m_maxEvents];
+		event.m_seq = 0;
+		bx::memoryBarrier();
+
+		event.m_begin = _begin;
+		event.m_end   = _end;
+		event.m_tid   = _tid;
+		event.m_pid   = _pid;
+		bx::strCopy(event.m_name, BX_COUNTOF(event.m_name)-1, _name);
+
+		bx::memoryBarrier();
+		event.m_seq = pos + 1;
+	}
+
+	// Copies event written at position _pos. Returns false when slot is still
+	// being written, or it was overwritten by newer event while copying.
+	static bool readEvent(const TraceRecorder* _recorder, uint32_t _pos, TraceEvent& _outEvent)
+	{
+		const TraceEvent& event = _recorder->m_event[_pos % _recorder->m_maxEvents];
+
+		const uint32_t seq = event.m_seq;
+		bx::memoryBarrier();
+
+		bx::memCopy(&_outEvent, &event, sizeof(TraceEvent) );
+
+		bx::memoryBarrier();
+		return _pos + 1 == seq
+			&& seq == event.m_seq
+			;
+	}
+
+	void traceRecord(TraceRecorder* _recorder, const char* _name, uint32_t _tid, int64_t _begin, int64_t _end)
+	{
+		if (NULL != _recorder)
+		{
+			record(_recorder, _name, kTracePidCpu, _tid, _begin, _end);
+		}
+	}
+
+	void traceRecordViews(TraceRecorder* _recorder, const Stats& _stats, uint32_t _renderTid, int64_t _gpuBegin)
+	{
+		if (NULL == _recorder)
+		{
+			return;
+		}
+
+		int64_t gpuFirst = INT64_MAX;
+
+		for (uint16_t ii = 0; ii < _stats.numViews; ++ii)
+		{
+			const ViewStats& viewStats = _stats.viewStats[ii];
+			record(_recorder, viewStats.name, kTracePidCpu, _renderTid, viewStats.cpuTimeBegin, viewStats.cpuTimeEnd);
+
+			if (viewStats.gpuTimeEnd > viewStats.gpuTimeBegin)
+			{
+				gpuFirst = bx::min(gpuFirst, viewStats.gpuTimeBegin);
+			}
+		}
+
+		if (INT64_MAX == gpuFirst
+		||  0 == _stats.gpuTimerFreq)
+		{
+			return;
+		}
+
+		// GPU timestamps are not in CPU clock domain, first view on GPU in this
+		// frame is aligned to start of render submit.
+		const double toCpu = double(_stats.cpuTimerFreq)/double(_stats.gpuTimerFreq);
+
+		for (uint16_t ii = 0; ii < _stats.numViews; ++ii)
+		{
+			const ViewStats& viewStats = _stats.viewStats[ii];
+
+			if (viewStats.gpuTimeEnd > viewStats.gpuTimeBegin)
+			{
+				const int64_t begin = _gpuBegin + int64_t(double(viewStats.gpuTimeBegin - gpuFirst)*toCpu);
+				const int64_t end   = _gpuBegin + int64_t(double(viewStats.gpuTimeEnd   - gpuFirst)*toCpu);
+				record(_recorder, viewStats.name, kTracePidGpu, 0, begin, end);
+			}
+		}
+	}
+
+	static void writeName(bx::WriterI* _writer, const char* _name, bx::Error* _err)
+	{
+		for (const char* ptr = _name; '\0' != *ptr; ++ptr)
+		{
+			const char ch = *ptr;
+
+			if ('"' == ch
+			||  '\\' == ch)
+			{
+				bx::write(_writer, '\\', _err);
+				bx::write(_writer, ch, _err);
+			}
+			else if (uint8_t(ch) >= ' ')
+			{
+				bx::write(_writer, ch, _err);
+			}
+		}
+	}
+
+	bool traceSave(TraceRecorder* _recorder, const char* _filePath)
+	{
+		if (NULL == _recorder)
+		{
+			BX_TRACE("Trace recorder is not enabled, compile library with BGFX_CONFIG_TRACE_RECORDER.");
+			return false;
+		}
+
+		BGFX_PROFILER_SCOPE("bgfx/Save trace", 0xff2040ff);
+
+		bx::FileWriter writer;
+		bx::Error err;
+
+		if (!bx::open(&writer, _filePath, false, &err) )
+		{
+			BX_TRACE("Failed to open trace file %s.", _filePath);
+			return false;
+		}
+
+		const double toUs = 1000000.0/double(bx::getHPFrequency() );
+
+		bx::writePrintf(&writer, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+		bx::writePrintf(&writer
+			, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"bgfx CPU\"}},\n"
+			  "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"bgfx GPU (%s)\"}}"
+			, kTracePidCpu
+			, kTracePidGpu
+			, getRendererName(g_caps.rendererType)
+			);
+
+		{
+			bx::MutexScope lock(_recorder->m_threadLock);
+
+			for (uint32_t ii = 0; ii < _recorder->m_numThreads; ++ii)
+			{
+				const TraceThread& thread = _recorder->m_thread[ii];
+				bx::writePrintf(&writer
+					, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\""
+					, kTracePidCpu
+					, thread.m_tid
+					);
+				writeName(&writer, thread.m_name, &err);
+				bx::writePrintf(&writer, "\"}}");
+			}
+		}
+
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+		{
+			bx::writePrintf(&writer
+				, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"Encoder %d\"}}"
+				, kTracePidCpu
+				, kTraceEncoderTid + ii
+				, ii
+				);
+		}
+
+		// Oldest event in ring is at write position, or at 0 when ring is not
+		// full yet. Events recorded while saving are not written.
+		const uint32_t write = bx::atomicFetchAndAdd<uint32_t>(&_recorder->m_write, 0);
+		const uint32_t num   = bx::min(write, _recorder->m_maxEvents);
+		const uint32_t first = write - num;
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			TraceEvent event;
+
+			if (!readEvent(_recorder, first + ii, event)
+			||  event.m_end < event.m_begin)
+			{
+				continue;
+			}
+
+			bx::writePrintf(&writer, ",\n{\"ph\":\"X\",\"name\":\"");
+			writeName(&writer, event.m_name, &err);
+			bx::writePrintf(&writer
+				, "\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}"
+				, event.m_pid
+				, event.m_tid
+				, double(event.m_begin - _recorder->m_base)*toUs
+				, double(event.m_end - event.m_begin)*toUs
+				);
+		}
+
+		bx::writePrintf(&writer, "\n]}\n");
+		bx::close(&writer);
+
+		return err.isOk();
+	}
+
+} // namespace bgfx
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_DEBUG_TRACE_H_HEADER_GUARD
+#define BGFX_DEBUG_TRACE_H_HEADER_GUARD
+
+#include <stdint.h>
+
+namespace bgfx
+{
+	struct Stats;
+
+	struct TraceRecorder;
+
+	/// Encoders are not bound to threads, each encoder gets its own track.
+	constexpr uint32_t kTraceEncoderTid = UINT32_C(0x80000000);
+
+	/// Recorder used by profiler scopes, NULL when trace recording is disabled.
+	extern TraceRecorder* g_traceRecorder;
+
+	/// Ring buffered recorder of CPU and GPU spans. Spans can be recorded from
+	/// any thread, oldest spans are overwritten once ring is full.
+	TraceRecorder* traceRecorderCreate(uint32_t _maxEvents);
+	void traceRecorderDestroy(TraceRecorder* _recorder);
+
+	/// Name thread that appears in trace, thread id is `bx::getTid()`.
+	void traceSetThreadName(TraceRecorder* _recorder, uint32_t _tid, const char* _name);
+
+	/// Record CPU span on thread `_tid`, time is in `bx::getHPCounter()` ticks.
+	void traceRecord(TraceRecorder* _recorder, const char* _name, uint32_t _tid, int64_t _begin, int64_t _end);
+
+	/// Record per view CPU/GPU spans from frame stats. GPU times are aligned so
+	/// that first view on GPU starts at `_gpuBegin` CPU time.
+	void traceRecordViews(TraceRecorder* _recorder, const Stats& _stats, uint32_t _renderTid, int64_t _gpuBegin);
+
+	/// Write recorded spans as Chrome trace event JSON.
+	bool traceSave(TraceRecorder* _recorder, const char* _filePath);
+
+} // namespace bgfx
+
+#endif // BGFX_DEBUG_TRACE_H_HEADER_GUARD
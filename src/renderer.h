@@ -374,6 +374,27 @@ namespace bgfx
 			}
 		}
 
+		template<typename PredT>
+		void invalidateIf(PredT _pred)
+		{
+			for (uint16_t ii = 0; ii < m_alloc.getNumHandles();)
+			{
+				uint16_t handle = m_alloc.getHandleAt(ii);
+				Data& data = m_data[handle];
+
+				if (_pred(data.m_value) )
+				{
+					m_alloc.free(handle);
+					m_hashMap.erase(m_hashMap.find(data.m_hash) );
+					release(data.m_value);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
 		void invalidate()
 		{
 			for (uint16_t ii = 0, num = m_alloc.getNumHandles(); ii < num; ++ii)
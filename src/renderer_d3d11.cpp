@@ -2267,6 +2267,11 @@ namespace bgfx { namespace d3d11
 			return m_lost;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void flip() override
 		{
 			if (!m_lost)
@@ -5546,15 +5551,21 @@ namespace bgfx { namespace d3d11
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
+
+			_render->updateTransientIndexBuffers([&](const TransientIndexBuffer& _page, uint32_t _size)
+			{
+				m_indexBuffers[_page.handle.idx].update(0, _size, _page.data, true);
+			});
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
+
+			_render->updateTransientVertexBuffers([&](const TransientVertexBuffer& _page, uint32_t _size)
+			{
+				m_vertexBuffers[_page.handle.idx].update(0, _size, _page.data, true);
+			});
 		}
 
 		_render->sort();
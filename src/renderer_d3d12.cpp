@@ -1084,10 +1084,20 @@ namespace bgfx { namespace d3d12
 					, (void**)&m_dsvDescriptorHeap
 					) );
 
+				// Scratch buffer has descriptors and 1KB of constants for each draw
+				// call, it's not grown during frame. Limit is already lowered by
+				// init, unless this renderer is fallback for another one.
+				BX_WARN(g_caps.limits.maxDrawCalls <= BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+					, "Init::Limits::maxDrawCalls %d is lowered to %d (BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS)."
+					, g_caps.limits.maxDrawCalls
+					, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+					);
+				g_caps.limits.maxDrawCalls = bx::min<uint32_t>(g_caps.limits.maxDrawCalls, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS);
+
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 				{
-					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
-						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+					m_scratchBuffer[ii].create(g_caps.limits.maxDrawCalls*1024
+						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + g_caps.limits.maxDrawCalls
 						);
 				}
 				m_samplerAllocator.create(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
@@ -1498,6 +1508,11 @@ namespace bgfx { namespace d3d12
 			return m_lost;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void flip() override
 		{
 			if (!m_lost)
@@ -5953,15 +5968,21 @@ namespace bgfx { namespace d3d12
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->m_iboffset, ib->data);
+
+			_render->updateTransientIndexBuffers([&](const TransientIndexBuffer& _page, uint32_t _size)
+			{
+				m_indexBuffers[_page.handle.idx].update(m_commandList, 0, _size, _page.data);
+			});
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->m_vboffset, vb->data);
+
+			_render->updateTransientVertexBuffers([&](const TransientVertexBuffer& _page, uint32_t _size)
+			{
+				m_vertexBuffers[_page.handle.idx].update(m_commandList, 0, _size, _page.data);
+			});
 		}
 
 		_render->sort();
@@ -498,6 +498,7 @@ namespace bgfx { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
@@ -507,6 +508,7 @@ namespace bgfx { namespace gl
 			ARB_depth_buffer_float,
 			ARB_depth_clamp,
 			ARB_draw_buffers_blend,
+			ARB_draw_elements_base_vertex,
 			ARB_draw_indirect,
 			ARB_draw_instanced,
 			ARB_ES3_compatibility,
@@ -533,6 +535,7 @@ namespace bgfx { namespace gl
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
 			ARB_shader_viewport_layer_array,
+			ARB_sync,
 			ARB_texture_compression_bptc,
 			ARB_texture_compression_rgtc,
 			ARB_texture_cube_map_array,
@@ -561,6 +564,7 @@ namespace bgfx { namespace gl
 			EXT_blend_color,
 			EXT_blend_minmax,
 			EXT_blend_subtract,
+			EXT_buffer_storage,
 			EXT_color_buffer_half_float,
 			EXT_color_buffer_float,
 			EXT_copy_image,
@@ -571,6 +575,7 @@ namespace bgfx { namespace gl
 			EXT_discard_framebuffer,
 			EXT_disjoint_timer_query,
 			EXT_draw_buffers,
+			EXT_draw_elements_base_vertex,
 			EXT_draw_instanced,
 			EXT_instanced_arrays,
 			EXT_frag_depth,
@@ -637,6 +642,7 @@ namespace bgfx { namespace gl
 			OES_depth24,
 			OES_depth32,
 			OES_depth_texture,
+			OES_draw_elements_base_vertex,
 			OES_element_index_uint,
 			OES_fragment_precision_high,
 			OES_fbo_render_mipmap,
@@ -715,6 +721,7 @@ namespace bgfx { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_buffer_storage",                       BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
@@ -724,6 +731,7 @@ namespace bgfx { namespace gl
 		{ "ARB_depth_buffer_float",                   BGFX_CONFIG_RENDERER_OPENGL >= 33, true  },
 		{ "ARB_depth_clamp",                          BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_draw_buffers_blend",                   BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
+		{ "ARB_draw_elements_base_vertex",            BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_draw_indirect",                        BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
 		{ "ARB_draw_instanced",                       BGFX_CONFIG_RENDERER_OPENGL >= 33, true  },
 		{ "ARB_ES3_compatibility",                    BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
@@ -750,6 +758,7 @@ namespace bgfx { namespace gl
 		{ "ARB_shader_storage_buffer_object",         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_shader_viewport_layer_array",          false,                             true  },
+		{ "ARB_sync",                                 BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_texture_compression_bptc",             BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_texture_compression_rgtc",             BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_texture_cube_map_array",               BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
@@ -778,6 +787,7 @@ namespace bgfx { namespace gl
 		{ "EXT_blend_color",                          BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "EXT_blend_minmax",                         BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
 		{ "EXT_blend_subtract",                       BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
+		{ "EXT_buffer_storage",                       false,                             true  }, // GLES3 extension.
 		{ "EXT_color_buffer_half_float",              false,                             true  }, // GLES2 extension.
 		{ "EXT_color_buffer_float",                   false,                             true  }, // GLES2 extension.
 		{ "EXT_copy_image",                           false,                             true  }, // GLES2 extension.
@@ -788,6 +798,7 @@ namespace bgfx { namespace gl
 		{ "EXT_discard_framebuffer",                  false,                             true  }, // GLES2 extension.
 		{ "EXT_disjoint_timer_query",                 false,                             true  }, // GLES2 extension.
 		{ "EXT_draw_buffers",                         false,                             true  }, // GLES2 extension.
+		{ "EXT_draw_elements_base_vertex",            false,                             true  },
 		{ "EXT_draw_instanced",                       false,                             true  }, // GLES2 extension.
 		{ "EXT_instanced_arrays",                     false,                             true  }, // GLES2 extension.
 		{ "EXT_frag_depth",                           false,                             true  }, // GLES2 extension.
@@ -854,6 +865,7 @@ namespace bgfx { namespace gl
 		{ "OES_depth24",                              false,                             true  },
 		{ "OES_depth32",                              false,                             true  },
 		{ "OES_depth_texture",                        false,                             true  },
+		{ "OES_draw_elements_base_vertex",            false,                             true  },
 		{ "OES_element_index_uint",                   false,                             true  },
 		{ "OES_fragment_precision_high",              false,                             true  },
 		{ "OES_fbo_render_mipmap",                    false,                             true  },
@@ -2145,6 +2157,31 @@ namespace bgfx { namespace gl
 		{ "ATI Technologies Inc.",        BGFX_PCI_ID_AMD    },
 	};
 
+	// Uniforms in uniform block don't have location. They are marked with bit
+	// 31, bit 29 selects vertex or fragment block, and low bits are offset in
+	// block. Bit 30 stays 0, so that location -1 is never block uniform.
+	constexpr uint32_t kUniformBlockLoc        = UINT32_C(0x80000000);
+	constexpr uint32_t kUniformBlockLocMask    = UINT32_C(0xc0000000);
+	constexpr uint32_t kUniformBlockStageBit   = UINT32_C(0x20000000);
+	constexpr uint32_t kUniformBlockOffsetMask = UINT32_C(0x1fffffff);
+
+	static const char* s_uniformBlockName[] =
+	{
+		"bgfx_VsUniforms",
+		"bgfx_FsUniforms",
+	};
+
+	static const char* s_uniformBlockPrefix[] =
+	{
+		"bgfx_vs_",
+		"bgfx_fs_",
+	};
+
+	inline bool isUniformBlockLoc(uint32_t _loc)
+	{
+		return kUniformBlockLoc == (_loc & kUniformBlockLocMask);
+	}
+
 	struct Workaround
 	{
 		void reset()
@@ -2159,6 +2196,8 @@ namespace bgfx { namespace gl
 	{
 		RendererContextGL()
 			: m_numWindows(1)
+			, m_uniformBlockProgram(NULL)
+			, m_uniformBlockBound(NULL)
 			, m_rtMsaa(false)
 			, m_fbDiscard(BGFX_CLEAR_NONE)
 			, m_capture(NULL)
@@ -2169,7 +2208,11 @@ namespace bgfx { namespace gl
 			, m_vao(0)
 			, m_blitSupported(false)
 			, m_readBackSupported(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
+			, m_asyncReadBackSupported(false)
+			, m_bufferStorageSupported(false)
+			, m_uniformBlockSupport(false)
 			, m_vaoSupport(false)
+			, m_baseVertexSupported(false)
 			, m_samplerObjectSupport(false)
 			, m_shadowSamplersSupport(false)
 			, m_srgbWriteControlSupport(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
@@ -2868,6 +2911,13 @@ namespace bgfx { namespace gl
 					GL_CHECK(glGenVertexArrays(1, &m_vao) );
 				}
 
+				m_baseVertexSupported = NULL != glDrawElementsInstancedBaseVertex
+					&& (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 32)
+						|| s_extension[Extension::ARB_draw_elements_base_vertex].m_supported
+						|| s_extension[Extension::EXT_draw_elements_base_vertex].m_supported
+						|| s_extension[Extension::OES_draw_elements_base_vertex].m_supported
+						);
+
 				m_samplerObjectSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
 					&& (m_gles3
 						|| s_extension[Extension::ARB_sampler_objects].m_supported
@@ -3099,6 +3149,55 @@ namespace bgfx { namespace gl
 					m_occlusionQuery.create();
 				}
 
+				// Read back goes through pixel pack buffer and fence, and is copied to
+				// user memory few frames later, glGetTexImage doesn't stall on GPU.
+				m_asyncReadBackSupported = true
+					&& m_readBackSupported
+					&& s_extension[Extension::ARB_sync].m_supported
+					&& s_extension[Extension::ARB_map_buffer_range].m_supported
+					&& NULL != glFenceSync
+					&& NULL != glMapBufferRange
+					;
+
+				if (m_asyncReadBackSupported)
+				{
+					m_readBackQueue.create();
+				}
+
+				// Transient buffers use persistently mapped copies and fences, instead
+				// of uploading whole buffer with glBufferSubData every frame.
+				m_bufferStorageSupported = true
+					&& (s_extension[Extension::ARB_buffer_storage].m_supported
+					||  s_extension[Extension::EXT_buffer_storage].m_supported
+					   )
+					&& NULL != glBufferStorage
+					&& NULL != glMapBufferRange
+					&& NULL != glFenceSync
+					;
+
+				// vec4/mat3/mat4 uniforms are moved into std140 uniform block, and
+				// bound with one glBindBufferRange per draw instead of glUniform*
+				// per uniform. Disabled on WebGL 2 where glBufferSubData is slow.
+				m_uniformBlockSupport = true
+					&& BX_ENABLED(BGFX_GL_CONFIG_UNIFORM_BLOCK)
+					&& !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& (m_gles3
+					||  s_extension[Extension::ARB_uniform_buffer_object].m_supported
+					   )
+					&& NULL != glGetUniformBlockIndex
+					&& NULL != glGetActiveUniformBlockiv
+					&& NULL != glGetActiveUniformsiv
+					&& NULL != glUniformBlockBinding
+					&& NULL != glBindBufferRange
+					;
+
+				if (m_uniformBlockSupport)
+				{
+					GLint align = 0;
+					GL_CHECK(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align) );
+					m_uniformRing.create(BGFX_GL_CONFIG_UNIFORM_RING_SIZE, uint32_t(align), m_bufferStorageSupported);
+				}
+
 				// Init reserved part of view name.
 				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 				{
@@ -3127,6 +3226,7 @@ namespace bgfx { namespace gl
 		{
 			if (m_vaoSupport)
 			{
+				m_vaoCache.invalidate();
 				GL_CHECK(glBindVertexArray(0) );
 				GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
 				m_vao = 0;
@@ -3146,6 +3246,18 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.destroy();
 			}
 
+			if (m_asyncReadBackSupported)
+			{
+				m_readBackQueue.destroy();
+			}
+
+			if (m_uniformBlockSupport)
+			{
+				m_uniformRing.destroy();
+				m_uniformBlockProgram = NULL;
+				m_uniformBlockBound   = NULL;
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -3174,6 +3286,14 @@ namespace bgfx { namespace gl
 			return false;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return m_asyncReadBackSupported
+				? BGFX_GL_CONFIG_TEXTURE_READ_BACK_LATENCY
+				: 0
+				;
+		}
+
 		void flip() override
 		{
 			if (m_flip)
@@ -3279,6 +3399,7 @@ namespace bgfx { namespace gl
 
 		void destroyProgram(ProgramHandle _handle) override
 		{
+			m_vaoCache.invalidateWithParent(_handle.idx);
 			m_program[_handle.idx].destroy();
 		}
 
@@ -3303,7 +3424,11 @@ namespace bgfx { namespace gl
 
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
-			if (m_readBackSupported)
+			if (m_asyncReadBackSupported)
+			{
+				m_readBackQueue.read(m_textures[_handle.idx], _data, _mip);
+			}
+			else if (m_readBackSupported)
 			{
 				const TextureGL& texture = m_textures[_handle.idx];
 				const bool compressed    = bimg::isCompressed(bimg::TextureFormat::Enum(texture.m_textureFormat) );
@@ -3600,7 +3725,7 @@ namespace bgfx { namespace gl
 			GL_CHECK(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE) );
 
 			ProgramGL& program = m_program[_blitter.m_program.idx];
-			setProgram(program.m_id);
+			setProgram(program.m_id, &program);
 			setUniform1i(program.m_sampler[0], 0);
 
 			float proj[16];
@@ -3647,6 +3772,8 @@ namespace bgfx { namespace gl
 				program.bindAttributes(_blitter.m_layout, 0);
 				program.bindAttributesEnd();
 
+				commitUniformBlocks(program);
+
 				GL_CHECK(glDrawElements(GL_TRIANGLES
 					, _numIndices
 					, GL_UNSIGNED_SHORT
@@ -4334,7 +4461,7 @@ namespace bgfx { namespace gl
 				GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
 
 				ProgramGL& program = m_program[_clearQuad.m_program[numMrt-1].idx];
-				setProgram(program.m_id);
+				setProgram(program.m_id, &program);
 				program.bindAttributesBegin();
 				program.bindAttributes(layout, 0);
 				program.bindAttributesEnd();
@@ -4385,6 +4512,7 @@ namespace bgfx { namespace gl
 				updateUniform(m_clearQuadColor.idx, mrtClearColor[0], numMrt * sizeof(float) * 4);
 
 				commit(*program.m_constantBuffer);
+				commitUniformBlocks(program);
 
 				GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP
 					, 0
@@ -4393,12 +4521,234 @@ namespace bgfx { namespace gl
 			}
 		}
 
-		void setProgram(GLuint program)
+		void setProgram(GLuint program, ProgramGL* _blockProgram = NULL)
 		{
 			m_uniformStateCache.saveCurrentProgram(program);
+			m_uniformBlockProgram = _blockProgram;
 			GL_CHECK(glUseProgram(program) );
 		}
 
+		// Writes blocks of both stages into uniform ring. Nothing is rebound
+		// when program is the same and block data didn't change.
+		void commitUniformBlocks(ProgramGL& _program)
+		{
+			if (!m_uniformBlockSupport
+			||  (0 == _program.m_uniformBlockSize[0] && 0 == _program.m_uniformBlockSize[1])
+			||  (&_program == m_uniformBlockBound && !_program.m_uniformBlockDirty) )
+			{
+				return;
+			}
+
+			const uint32_t fsOffset = bx::strideAlign(_program.m_uniformBlockSize[0], m_uniformRing.m_align);
+			const uint32_t size     = fsOffset + _program.m_uniformBlockSize[1];
+
+			// Ranges bound before ring switched storage are not valid anymore,
+			// blocks are always rebound right after alloc.
+			const uint32_t offset = m_uniformRing.alloc(size);
+
+			const uint32_t stageOffset[] = { offset, offset + fsOffset };
+
+			for (uint32_t stage = 0; stage < BX_COUNTOF(stageOffset); ++stage)
+			{
+				const uint32_t blockSize = _program.m_uniformBlockSize[stage];
+
+				if (0 != blockSize)
+				{
+					m_uniformRing.write(stageOffset[stage], _program.m_uniformBlock[stage], blockSize);
+					GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER
+						, stage
+						, m_uniformRing.getId()
+						, stageOffset[stage]
+						, blockSize
+						) );
+				}
+			}
+
+			m_uniformBlockBound = &_program;
+			_program.m_uniformBlockDirty = false;
+		}
+
+		// Writes into CPU copy of current program uniform block, block is
+		// marked dirty only when data changed.
+		void writeUniformBlock(uint32_t _loc, const void* _data, uint32_t _size)
+		{
+			ProgramGL* program = m_uniformBlockProgram;
+			const uint32_t stage  = 0 != (_loc & kUniformBlockStageBit) ? 1 : 0;
+			const uint32_t offset = _loc & kUniformBlockOffsetMask;
+
+			if (NULL == program
+			||  offset >= program->m_uniformBlockSize[stage])
+			{
+				return;
+			}
+
+			const uint32_t size = bx::min(_size, program->m_uniformBlockSize[stage] - offset);
+			uint8_t* dst = &program->m_uniformBlock[stage][offset];
+
+			if (0 != bx::memCmp(dst, _data, size) )
+			{
+				bx::memCopy(dst, _data, size);
+				program->m_uniformBlockDirty = true;
+			}
+		}
+
+		// Start vertex is applied by draw call when all streams share it, see
+		// getDrawBaseVertex, so it's not part of VAO key. Otherwise start
+		// vertex and instance data offset are respecified on cached VAO when
+		// they differ from what VAO was last set to.
+		void bindVertexArray(ProgramGL& _program, ProgramHandle _programHandle, const RenderDraw& _draw, bool _drawBaseVertex)
+		{
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(_draw.m_streamMask);
+
+			if (UINT8_MAX != _draw.m_streamMask)
+			{
+				for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+
+					const VertexBufferGL& vb = m_vertexBuffers[_draw.m_stream[idx].m_handle.idx];
+					const uint16_t decl = isValid(_draw.m_stream[idx].m_layoutHandle)
+						? _draw.m_stream[idx].m_layoutHandle.idx
+						: vb.m_layoutHandle.idx;
+					murmur.add(idx);
+					murmur.add(vb.m_id);
+					murmur.add(m_vertexLayouts[decl].m_hash);
+				}
+			}
+
+			const GLuint instanceId = isValid(_draw.m_instanceDataBuffer)
+				? m_vertexBuffers[_draw.m_instanceDataBuffer.idx].m_id
+				: 0
+				;
+			murmur.add(instanceId);
+			murmur.add(_draw.m_instanceDataStride);
+
+			const GLuint indexId = isValid(_draw.m_indexBuffer)
+				? m_indexBuffers[_draw.m_indexBuffer.idx].m_id
+				: 0
+				;
+			murmur.add(indexId);
+
+			const uint64_t key = (uint64_t(_programHandle.idx)<<32) | murmur.end();
+
+			VertexArrayGL* vao = m_vaoCache.find(key);
+			const bool create = NULL == vao;
+
+			if (create)
+			{
+				VertexArrayGL newVao;
+				bx::memSet(&newVao, 0, sizeof(newVao) );
+				GL_CHECK(glGenVertexArrays(1, &newVao.m_id) );
+				newVao.m_buffer[newVao.m_numBuffers++] = indexId;
+				newVao.m_buffer[newVao.m_numBuffers++] = instanceId;
+
+				vao = m_vaoCache.add(key, newVao, _programHandle.idx);
+			}
+
+			GL_CHECK(glBindVertexArray(vao->m_id) );
+
+			if (create)
+			{
+				// Attributes of new VAO are all disabled, there is nothing to
+				// unbind from previous program.
+				GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexId) );
+				_program.bindAttributesBegin();
+			}
+
+			if (UINT8_MAX != _draw.m_streamMask)
+			{
+				for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+
+					const uint32_t startVertex = _drawBaseVertex ? 0 : _draw.m_stream[idx].m_startVertex;
+
+					if (create
+					||  vao->m_startVertex[idx] != startVertex)
+					{
+						const VertexBufferGL& vb = m_vertexBuffers[_draw.m_stream[idx].m_handle.idx];
+						const uint16_t decl = isValid(_draw.m_stream[idx].m_layoutHandle)
+							? _draw.m_stream[idx].m_layoutHandle.idx
+							: vb.m_layoutHandle.idx;
+						GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
+						_program.bindAttributes(m_vertexLayouts[decl], startVertex);
+
+						vao->m_startVertex[idx] = startVertex;
+
+						if (create)
+						{
+							vao->m_buffer[vao->m_numBuffers++] = vb.m_id;
+						}
+					}
+				}
+			}
+
+			if (0 != instanceId
+			&& (create || vao->m_instanceDataOffset != _draw.m_instanceDataOffset) )
+			{
+				GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, instanceId) );
+				_program.bindInstanceData(_draw.m_instanceDataStride, _draw.m_instanceDataOffset);
+				vao->m_instanceDataOffset = _draw.m_instanceDataOffset;
+			}
+
+			if (create)
+			{
+				_program.bindAttributesEnd();
+			}
+		}
+
+		// Start vertex can be passed to draw call instead of being baked into
+		// attribute pointers when all streams start at the same vertex.
+		bool getDrawBaseVertex(const RenderDraw& _draw, uint32_t& _baseVertex) const
+		{
+			if (isValid(_draw.m_indirectBuffer)
+			||  0 == _draw.m_streamMask
+			||  UINT8_MAX == _draw.m_streamMask
+			|| (isValid(_draw.m_indexBuffer) && !m_baseVertexSupported) )
+			{
+				return false;
+			}
+
+			const uint32_t first = bx::uint32_cnttz(_draw.m_streamMask);
+			_baseVertex = _draw.m_stream[first].m_startVertex;
+
+			for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+				; 0 != streamMask
+				; streamMask >>= 1, idx += 1
+				)
+			{
+				const uint32_t ntz = bx::uint32_cnttz(streamMask);
+				streamMask >>= ntz;
+				idx         += ntz;
+
+				if (_draw.m_stream[idx].m_startVertex != _baseVertex)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// GL can hand out name of deleted buffer again, VAOs that reference
+		// it must not be found anymore.
+		void invalidateVertexArrays(GLuint _id)
+		{
+			m_vaoCache.invalidateIf([_id](const VertexArrayGL& _vao) { return _vao.references(_id); });
+		}
+
 		// Cache uniform uploads to avoid redundant uploading of state that is
 		// already set to a shader program
 		void setUniform1i(uint32_t loc, int value)
@@ -4428,6 +4778,12 @@ namespace bgfx { namespace gl
 		void setUniform4f(uint32_t loc, float x, float y, float z, float w)
 		{
 			UniformStateCache::f4 f; f.val[0] = x; f.val[1] = y; f.val[2] = z; f.val[3] = w;
+			if (isUniformBlockLoc(loc) )
+			{
+				writeUniformBlock(loc, f.val, sizeof(f.val) );
+				return;
+			}
+
 			if (m_uniformStateCache.updateUniformCache(loc, f) )
 			{
 				GL_CHECK(glUniform4f(loc, x, y, z, w) );
@@ -4436,6 +4792,12 @@ namespace bgfx { namespace gl
 
 		void setUniform4fv(uint32_t loc, int num, const float *data)
 		{
+			if (isUniformBlockLoc(loc) )
+			{
+				writeUniformBlock(loc, data, num*16);
+				return;
+			}
+
 			bool changed = false;
 			for(int i = 0; i < num; ++i)
 			{
@@ -4452,6 +4814,24 @@ namespace bgfx { namespace gl
 
 		void setUniformMatrix3fv(uint32_t loc, int num, GLboolean transpose, const float *data)
 		{
+			if (isUniformBlockLoc(loc) )
+			{
+				// In std140 each mat3 column is aligned to vec4.
+				for (int i = 0; i < num; ++i)
+				{
+					const float* src = &data[9*i];
+					float column[12] =
+					{
+						src[0], src[1], src[2], 0.0f,
+						src[3], src[4], src[5], 0.0f,
+						src[6], src[7], src[8], 0.0f,
+					};
+					writeUniformBlock(loc + 48*i, column, sizeof(column) );
+				}
+				BX_UNUSED(transpose);
+				return;
+			}
+
 			bool changed = false;
 			for(int i = 0; i < num; ++i)
 			{
@@ -4468,6 +4848,13 @@ namespace bgfx { namespace gl
 
 		void setUniformMatrix4fv(uint32_t loc, int num, GLboolean transpose, const float *data)
 		{
+			if (isUniformBlockLoc(loc) )
+			{
+				writeUniformBlock(loc, data, num*64);
+				BX_UNUSED(transpose);
+				return;
+			}
+
 			bool changed = false;
 			for(int i = 0; i < num; ++i)
 			{
@@ -4499,8 +4886,13 @@ namespace bgfx { namespace gl
 
 		TimerQueryGL m_gpuTimer;
 		OcclusionQueryGL m_occlusionQuery;
+		ReadBackQueueGL m_readBackQueue;
+		UniformRingGL m_uniformRing;
+		ProgramGL* m_uniformBlockProgram; // Current program, setUniform* writes into its block copy.
+		ProgramGL* m_uniformBlockBound;   // Program whose block data is bound from uniform ring.
 
 		SamplerStateCache m_samplerStateCache;
+		StateCacheLru<VertexArrayGL, 1024> m_vaoCache;
 		UniformStateCache m_uniformStateCache;
 
 		TextVideoMem m_textVideoMem;
@@ -4519,7 +4911,11 @@ namespace bgfx { namespace gl
 		uint16_t m_maxLabelLen;
 		bool m_blitSupported;
 		bool m_readBackSupported;
+		bool m_asyncReadBackSupported;
+		bool m_bufferStorageSupported;
+		bool m_uniformBlockSupport;
 		bool m_vaoSupport;
+		bool m_baseVertexSupported;
 		bool m_samplerObjectSupport;
 		bool m_shadowSamplersSupport;
 		bool m_srgbWriteControlSupport;
@@ -4823,6 +5219,17 @@ namespace bgfx { namespace gl
 		}
 		m_numPredefined = 0;
 
+		for (uint32_t stage = 0; stage < BX_COUNTOF(m_uniformBlock); ++stage)
+		{
+			if (NULL != m_uniformBlock[stage])
+			{
+				BX_FREE(g_allocator, m_uniformBlock[stage]);
+				m_uniformBlock[stage] = NULL;
+				m_uniformBlockSize[stage] = 0;
+			}
+		}
+		m_uniformBlockDirty = false;
+
 		if (0 != m_id)
 		{
 			s_renderGL->setProgram(0);
@@ -4904,6 +5311,30 @@ namespace bgfx { namespace gl
 		m_numPredefined = 0;
 		m_numSamplers = 0;
 
+		GLuint blockIndex[2] = { GL_INVALID_INDEX, GL_INVALID_INDEX };
+
+		if (s_renderGL->m_uniformBlockSupport)
+		{
+			for (uint32_t stage = 0; stage < BX_COUNTOF(blockIndex); ++stage)
+			{
+				blockIndex[stage] = glGetUniformBlockIndex(m_id, s_uniformBlockName[stage]);
+
+				if (GL_INVALID_INDEX != blockIndex[stage])
+				{
+					GLint size = 0;
+					GL_CHECK(glGetActiveUniformBlockiv(m_id, blockIndex[stage], GL_UNIFORM_BLOCK_DATA_SIZE, &size) );
+					GL_CHECK(glUniformBlockBinding(m_id, blockIndex[stage], stage) );
+
+					m_uniformBlockSize[stage] = uint32_t(size);
+					m_uniformBlock[stage] = (uint8_t*)BX_ALLOC(g_allocator, size);
+					bx::memSet(m_uniformBlock[stage], 0, size);
+					m_uniformBlockDirty = true;
+
+					BX_TRACE("Uniform block %s, binding %d, size %d.", s_uniformBlockName[stage], stage, size);
+				}
+			}
+		}
+
 		BX_TRACE("Uniforms (%d):", activeUniforms);
 		for (int32_t ii = 0; ii < activeUniforms; ++ii)
 		{
@@ -4962,6 +5393,36 @@ namespace bgfx { namespace gl
 				bx::fromString(&offset, bx::StringView(array.getPtr()+1, end.getPtr() ) );
 			}
 
+			if (s_renderGL->m_uniformBlockSupport)
+			{
+				const GLuint index = GLuint(ii);
+				GLint block = -1;
+				GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &block) );
+
+				for (uint32_t stage = 0; stage < BX_COUNTOF(blockIndex) && -1 != block; ++stage)
+				{
+					if (GLuint(block) == blockIndex[stage])
+					{
+						GLint blockOffset = 0;
+						GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_OFFSET, &blockOffset) );
+
+						loc = GLint(0
+							| kUniformBlockLoc
+							| (0 != stage ? kUniformBlockStageBit : 0)
+							| (uint32_t(blockOffset) & kUniformBlockOffsetMask)
+							);
+
+						// Strip stage prefix added by writeUniformBlockCode, and find
+						// uniform by its original name.
+						const uint32_t prefixLen = bx::strLen(s_uniformBlockPrefix[stage]);
+						if (0 == bx::strCmp(name, s_uniformBlockPrefix[stage], prefixLen) )
+						{
+							bx::memMove(name, name + prefixLen, bx::strLen(name) - prefixLen + 1);
+						}
+					}
+				}
+			}
+
 			switch (gltype)
 			{
 			case GL_SAMPLER_2D:
@@ -5239,89 +5700,385 @@ namespace bgfx { namespace gl
 		}
 	}
 
-	void IndexBufferGL::destroy()
+	bool StreamBufferGL::create(GLenum _target, uint32_t _size)
 	{
-		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-		GL_CHECK(glDeleteBuffers(1, &m_id) );
-	}
+		const GLbitfield flags = 0
+			| GL_MAP_WRITE_BIT
+			| GL_MAP_PERSISTENT_BIT
+			| GL_MAP_COHERENT_BIT
+			;
 
-	void VertexBufferGL::destroy()
-	{
-		GL_CHECK(glBindBuffer(m_target, 0) );
-		GL_CHECK(glDeleteBuffers(1, &m_id) );
-	}
+		m_current = 0;
 
-	bool TextureGL::init(GLenum _target, uint32_t _width, uint32_t _height, uint32_t _depth, uint8_t _numMips, uint64_t _flags)
-	{
-		m_target  = _target;
-		m_numMips = _numMips;
-		m_flags   = _flags;
-		m_width   = _width;
-		m_height  = _height;
-		m_depth   = _depth;
-		m_currentSamplerHash = UINT32_MAX;
+		GL_CHECK(glGenBuffers(BX_COUNTOF(m_id), m_id) );
 
-		const bool writeOnly    = 0 != (m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
-		const bool computeWrite = 0 != (m_flags&BGFX_TEXTURE_COMPUTE_WRITE );
-		const bool srgb         = 0 != (m_flags&BGFX_TEXTURE_SRGB);  // 是否适用sRGB
-		const bool renderTarget = 0 != (m_flags&BGFX_TEXTURE_RT_MASK);
-		const bool textureArray = false
-			|| _target == GL_TEXTURE_2D_ARRAY
-			|| _target == GL_TEXTURE_CUBE_MAP_ARRAY
-			;
+		bool ok = true;
 
-		if (!writeOnly // writeONly = true 只能GPU可写
-		|| (renderTarget && textureArray) )
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_id); ++ii)
 		{
-			GL_CHECK(glGenTextures(1, &m_id) );
-			BX_ASSERT(0 != m_id, "Failed to generate texture id.");
-			GL_CHECK(glBindTexture(_target, m_id) );
-			GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+			m_sync[ii] = NULL;
+			m_data[ii] = NULL;
 
-			const TextureFormatInfo& tfi = s_textureFormat[m_textureFormat];
+			if (ok)
+			{
+				// GL_DYNAMIC_STORAGE_BIT is kept for partial non-discard updates with
+				// glBufferSubData.
+				GL_CHECK(glBindBuffer(_target, m_id[ii]) );
+				GL_CHECK(glBufferStorage(_target, _size, NULL, flags|GL_DYNAMIC_STORAGE_BIT) );
+				m_data[ii] = (uint8_t*)glMapBufferRange(_target, 0, _size, flags);
+				ok = NULL != m_data[ii];
+			}
+		}
 
-			const GLenum fmt = srgb
-				? s_textureFormat[m_textureFormat].m_fmtSrgb
-				: s_textureFormat[m_textureFormat].m_fmt
-				;
+		GL_CHECK(glBindBuffer(_target, 0) );
 
-			m_fmt  = fmt;
-			m_type = tfi.m_type;
+		if (!ok)
+		{
+			BX_TRACE("Failed to map persistent stream buffer, falling back to orphaning.");
+			destroy(_target);
+		}
 
-			const bool swizzle = true
-				&& TextureFormat::BGRA8 == m_requestedFormat
-				&& !s_textureFormat[m_requestedFormat].m_supported
-				&& !s_renderGL->m_textureSwizzleSupport
-				;
-			const bool convert = false
-				|| m_textureFormat != m_requestedFormat
-				|| swizzle
-				;
+		return ok;
+	}
 
-			if (convert)
+	void StreamBufferGL::destroy(GLenum _target)
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_id); ++ii)
+		{
+			s_renderGL->invalidateVertexArrays(m_id[ii]);
+
+			if (NULL != m_sync[ii])
 			{
-				m_textureFormat = (uint8_t)TextureFormat::RGBA8;
-				const TextureFormatInfo& tfiRgba8 = s_textureFormat[TextureFormat::RGBA8];
-				m_fmt  = tfiRgba8.m_fmt;
-				m_type = tfiRgba8.m_type;
+				GL_CHECK(glDeleteSync(m_sync[ii]) );
+				m_sync[ii] = NULL;
 			}
 
-			const GLenum internalFmt = srgb
-				? s_textureFormat[m_textureFormat].m_internalFmtSrgb
-				: s_textureFormat[m_textureFormat].m_internalFmt
-				; // SRGB 和 RGB 的转换
-
-			if (textureArray)
+			if (NULL != m_data[ii])
 			{
-				GL_CHECK(glTexStorage3D(_target
-					, _numMips
-					, internalFmt
-					, m_width
-					, m_height
-					, _depth
-					) );
+				GL_CHECK(glBindBuffer(_target, m_id[ii]) );
+				GL_CHECK(glUnmapBuffer(_target) );
+				m_data[ii] = NULL;
 			}
-			else if (computeWrite)
+		}
+
+		GL_CHECK(glBindBuffer(_target, 0) );
+		GL_CHECK(glDeleteBuffers(BX_COUNTOF(m_id), m_id) );
+	}
+
+	void StreamBufferGL::next()
+	{
+		// Fence is signaled once draws submitted so far are done with current copy.
+		if (NULL == m_sync[m_current])
+		{
+			m_sync[m_current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		m_current = (m_current + 1) % BX_COUNTOF(m_id);
+
+		GLsync sync = m_sync[m_current];
+		if (NULL != sync)
+		{
+			// GPU is normally long done with data from
+			// BGFX_GL_CONFIG_STREAM_BUFFER_COPIES-1 frames ago, this doesn't really wait.
+			const GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+			BX_WARN(GL_WAIT_FAILED != result, "Stream buffer fence wait failed.");
+			BX_UNUSED(result);
+
+			GL_CHECK(glDeleteSync(sync) );
+			m_sync[m_current] = NULL;
+		}
+	}
+
+	GLuint StreamBufferGL::update(uint32_t _offset, uint32_t _size, const void* _data)
+	{
+		next();
+
+		// Mapping is coherent, writes are visible to commands submitted after
+		// them without flush.
+		bx::memCopy(&m_data[m_current][_offset], _data, _size);
+
+		return m_id[m_current];
+	}
+
+	void UniformRingGL::create(uint32_t _size, uint32_t _align, bool _persistent)
+	{
+		m_size   = _size;
+		m_align  = bx::max<uint32_t>(_align, 16);
+		m_offset = 0;
+		m_id     = 0;
+		m_stream = NULL;
+
+		if (_persistent)
+		{
+			m_stream = BX_NEW(g_allocator, StreamBufferGL);
+			if (m_stream->create(GL_UNIFORM_BUFFER, m_size) )
+			{
+				return;
+			}
+
+			BX_DELETE(g_allocator, m_stream);
+			m_stream = NULL;
+		}
+
+		GL_CHECK(glGenBuffers(1, &m_id) );
+		GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_id) );
+		GL_CHECK(glBufferData(GL_UNIFORM_BUFFER, m_size, NULL, GL_STREAM_DRAW) );
+		GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+	}
+
+	void UniformRingGL::destroy()
+	{
+		if (NULL != m_stream)
+		{
+			m_stream->destroy(GL_UNIFORM_BUFFER);
+			BX_DELETE(g_allocator, m_stream);
+			m_stream = NULL;
+		}
+
+		if (0 != m_id)
+		{
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+		}
+	}
+
+	uint32_t UniformRingGL::alloc(uint32_t _size)
+	{
+		BX_ASSERT(_size <= m_size, "Uniform block data %d doesn't fit into uniform ring %d.", _size, m_size);
+
+		const uint32_t offset = bx::strideAlign(m_offset, m_align);
+
+		if (offset + _size <= m_size)
+		{
+			m_offset = offset + _size;
+			return offset;
+		}
+
+		if (NULL != m_stream)
+		{
+			m_stream->next();
+		}
+		else
+		{
+			// orphan buffer...
+			GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_id) );
+			GL_CHECK(glBufferData(GL_UNIFORM_BUFFER, m_size, NULL, GL_STREAM_DRAW) );
+		}
+
+		m_offset = _size;
+		return 0;
+	}
+
+	void UniformRingGL::write(uint32_t _offset, const void* _data, uint32_t _size)
+	{
+		if (NULL != m_stream)
+		{
+			bx::memCopy(&m_stream->m_data[m_stream->m_current][_offset], _data, _size);
+			return;
+		}
+
+		GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_id) );
+		GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, _offset, _size, _data) );
+	}
+
+	void IndexBufferGL::update(uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_ASSERT(0 != m_id, "Updating invalid index buffer.");
+
+		if (_discard)
+		{
+			if (NULL == m_stream
+			&&  s_renderGL->m_bufferStorageSupported)
+			{
+				m_stream = BX_NEW(g_allocator, StreamBufferGL);
+				if (m_stream->create(GL_ELEMENT_ARRAY_BUFFER, m_size) )
+				{
+					s_renderGL->invalidateVertexArrays(m_id);
+					GL_CHECK(glDeleteBuffers(1, &m_id) );
+				}
+				else
+				{
+					BX_DELETE(g_allocator, m_stream);
+					m_stream = NULL;
+				}
+			}
+
+			if (NULL != m_stream)
+			{
+				m_id = m_stream->update(_offset, _size, _data);
+				return;
+			}
+
+			// orphan buffer...
+			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+			GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_size, NULL, GL_DYNAMIC_DRAW) );
+		}
+		else
+		{
+			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+		}
+
+		GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
+			, _offset
+			, _size
+			, _data
+			) );
+		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+	}
+
+	void release(VertexArrayGL& _vao)
+	{
+		GL_CHECK(glDeleteVertexArrays(1, &_vao.m_id) );
+	}
+
+	void IndexBufferGL::destroy()
+	{
+		if (NULL != m_stream)
+		{
+			m_stream->destroy(GL_ELEMENT_ARRAY_BUFFER);
+			BX_DELETE(g_allocator, m_stream);
+			m_stream = NULL;
+			return;
+		}
+
+		s_renderGL->invalidateVertexArrays(m_id);
+
+		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+		GL_CHECK(glDeleteBuffers(1, &m_id) );
+	}
+
+	void VertexBufferGL::update(uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_ASSERT(0 != m_id, "Updating invalid vertex buffer.");
+
+		if (_discard)
+		{
+			if (NULL == m_stream
+			&&  s_renderGL->m_bufferStorageSupported)
+			{
+				m_stream = BX_NEW(g_allocator, StreamBufferGL);
+				if (m_stream->create(m_target, m_size) )
+				{
+					s_renderGL->invalidateVertexArrays(m_id);
+					GL_CHECK(glDeleteBuffers(1, &m_id) );
+				}
+				else
+				{
+					BX_DELETE(g_allocator, m_stream);
+					m_stream = NULL;
+				}
+			}
+
+			if (NULL != m_stream)
+			{
+				m_id = m_stream->update(_offset, _size, _data);
+				return;
+			}
+
+			// orphan buffer...
+			GL_CHECK(glBindBuffer(m_target, m_id) );
+			GL_CHECK(glBufferData(m_target, m_size, NULL, GL_DYNAMIC_DRAW) );
+		}
+		else
+		{
+			GL_CHECK(glBindBuffer(m_target, m_id) );
+		}
+
+		GL_CHECK(glBufferSubData(m_target
+			, _offset
+			, _size
+			, _data
+			) );
+		GL_CHECK(glBindBuffer(m_target, 0) );
+	}
+
+	void VertexBufferGL::destroy()
+	{
+		if (NULL != m_stream)
+		{
+			m_stream->destroy(m_target);
+			BX_DELETE(g_allocator, m_stream);
+			m_stream = NULL;
+			return;
+		}
+
+		s_renderGL->invalidateVertexArrays(m_id);
+
+		GL_CHECK(glBindBuffer(m_target, 0) );
+		GL_CHECK(glDeleteBuffers(1, &m_id) );
+	}
+
+	bool TextureGL::init(GLenum _target, uint32_t _width, uint32_t _height, uint32_t _depth, uint8_t _numMips, uint64_t _flags)
+	{
+		m_target  = _target;
+		m_numMips = _numMips;
+		m_flags   = _flags;
+		m_width   = _width;
+		m_height  = _height;
+		m_depth   = _depth;
+		m_currentSamplerHash = UINT32_MAX;
+
+		const bool writeOnly    = 0 != (m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
+		const bool computeWrite = 0 != (m_flags&BGFX_TEXTURE_COMPUTE_WRITE );
+		const bool srgb         = 0 != (m_flags&BGFX_TEXTURE_SRGB);  // 是否适用sRGB
+		const bool renderTarget = 0 != (m_flags&BGFX_TEXTURE_RT_MASK);
+		const bool textureArray = false
+			|| _target == GL_TEXTURE_2D_ARRAY
+			|| _target == GL_TEXTURE_CUBE_MAP_ARRAY
+			;
+
+		if (!writeOnly // writeONly = true 只能GPU可写
+		|| (renderTarget && textureArray) )
+		{
+			GL_CHECK(glGenTextures(1, &m_id) );
+			BX_ASSERT(0 != m_id, "Failed to generate texture id.");
+			GL_CHECK(glBindTexture(_target, m_id) );
+			GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+
+			const TextureFormatInfo& tfi = s_textureFormat[m_textureFormat];
+
+			const GLenum fmt = srgb
+				? s_textureFormat[m_textureFormat].m_fmtSrgb
+				: s_textureFormat[m_textureFormat].m_fmt
+				;
+
+			m_fmt  = fmt;
+			m_type = tfi.m_type;
+
+			const bool swizzle = true
+				&& TextureFormat::BGRA8 == m_requestedFormat
+				&& !s_textureFormat[m_requestedFormat].m_supported
+				&& !s_renderGL->m_textureSwizzleSupport
+				;
+			const bool convert = false
+				|| m_textureFormat != m_requestedFormat
+				|| swizzle
+				;
+
+			if (convert)
+			{
+				m_textureFormat = (uint8_t)TextureFormat::RGBA8;
+				const TextureFormatInfo& tfiRgba8 = s_textureFormat[TextureFormat::RGBA8];
+				m_fmt  = tfiRgba8.m_fmt;
+				m_type = tfiRgba8.m_type;
+			}
+
+			const GLenum internalFmt = srgb
+				? s_textureFormat[m_textureFormat].m_internalFmtSrgb
+				: s_textureFormat[m_textureFormat].m_internalFmt
+				; // SRGB 和 RGB 的转换
+
+			if (textureArray)
+			{
+				GL_CHECK(glTexStorage3D(_target
+					, _numMips
+					, internalFmt
+					, m_width
+					, m_height
+					, _depth
+					) );
+			}
+			else if (computeWrite)
 			{
 				if (_target == GL_TEXTURE_3D)
 				{
@@ -5524,14 +6281,27 @@ namespace bgfx { namespace gl
 				, getName( (TextureFormat::Enum)m_textureFormat)
 				);
 
-			uint8_t* temp = NULL;
-			if (convert)
-			{
-				temp = (uint8_t*)BX_ALLOC(g_allocator, ti.width*ti.height*4);
-			}
-
 			const uint16_t numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
 
+			// Software decode of all sides and mips is spread across job pool,
+			// upload below stays on render thread.
+			ImageDecodeMip* decoded = NULL;
+			uint8_t* decodedData = NULL;
+			if (convert
+			&&  NULL != imageContainer.m_data)
+			{
+				decoded = (ImageDecodeMip*)BX_ALLOC(g_allocator, sizeof(ImageDecodeMip)*numSides*ti.numMips);
+				decodedData = imageDecodeParallel(
+					  decoded
+					, imageContainer
+					, _mem
+					, numSides
+					, startLod
+					, ti.numMips
+					, bimg::TextureFormat::RGBA8
+					);
+			}
+
 			for (uint16_t side = 0; side < numSides; ++side)
 			{
 				uint32_t width  = ti.width;
@@ -5574,16 +6344,7 @@ namespace bgfx { namespace gl
 
 							if (convert)
 							{
-								imageDecodeToRgba8(
-									  g_allocator
-									, temp
-									, mip.m_data
-									, mip.m_width
-									, mip.m_height
-									, mip.m_width*4
-									, mip.m_format
-									);
-								data = temp;
+								data = decoded[side*ti.numMips + lod].data;
 							}
 
 							GL_CHECK(texImage(imageTarget
@@ -5644,9 +6405,10 @@ namespace bgfx { namespace gl
 				}
 			}
 
-			if (NULL != temp)
+			if (NULL != decoded)
 			{
-				BX_FREE(g_allocator, temp);
+				BX_FREE(g_allocator, decodedData);
+				BX_FREE(g_allocator, decoded);
 			}
 		}
 
@@ -5944,6 +6706,135 @@ namespace bgfx { namespace gl
 		bx::memCopy(_str, _insert, len);
 	}
 
+	static bx::StringView nextWord(bx::StringView& _parse)
+	{
+		bx::StringView word = bx::strWord(bx::strLTrimSpace(_parse) );
+		_parse = bx::strLTrimSpace(bx::StringView(word.getTerm(), _parse.getTerm() ) );
+		return word;
+	}
+
+	struct UniformDeclGL
+	{
+		bx::StringView precision;
+		bx::StringView type;
+		bx::StringView name;
+		bx::StringView array; // Including [], empty when uniform is not array.
+	};
+
+	// Parses only single line `uniform [precision] vec4|mat3|mat4 name[N];` as
+	// written by shaderc. Samplers, images and others are left as they are.
+	static bool parseBlockUniform(const bx::StringView& _line, UniformDeclGL& _decl)
+	{
+		bx::StringView parse = _line;
+
+		if (0 != bx::strCmp(nextWord(parse), "uniform") )
+		{
+			return false;
+		}
+
+		_decl.precision.clear();
+		_decl.type = nextWord(parse);
+
+		if (0 == bx::strCmp(_decl.type, "lowp")
+		||  0 == bx::strCmp(_decl.type, "mediump")
+		||  0 == bx::strCmp(_decl.type, "highp") )
+		{
+			_decl.precision = _decl.type;
+			_decl.type = nextWord(parse);
+		}
+
+		if (0 != bx::strCmp(_decl.type, "vec4")
+		&&  0 != bx::strCmp(_decl.type, "mat3")
+		&&  0 != bx::strCmp(_decl.type, "mat4") )
+		{
+			return false;
+		}
+
+		_decl.name = nextWord(parse);
+
+		const bx::StringView eol = bx::strFind(parse, ';');
+		if (_decl.name.isEmpty()
+		||  eol.isEmpty()
+		||  !bx::strTrimSpace(bx::StringView(eol.getTerm(), parse.getTerm() ) ).isEmpty() )
+		{
+			return false;
+		}
+
+		_decl.array = bx::strTrimSpace(bx::StringView(parse.getPtr(), eol.getPtr() ) );
+
+		return _decl.array.isEmpty()
+			|| (  '[' == _decl.array.getPtr()[0]
+			   && ']' == _decl.array.getTerm()[-1]
+			   && bx::strFind(_decl.array, ',').isEmpty()
+			   )
+			;
+	}
+
+	// Moves vec4/mat3/mat4 uniforms into std140 uniform block. Members get stage
+	// prefix, so that vertex and fragment members with the same name don't
+	// collide when linking, and #define maps original name to member. Rest of
+	// code is written as is.
+	static void writeUniformBlockCode(bx::WriterI* _writer, const bx::StringView& _code, GLenum _type)
+	{
+		const uint32_t stage = GL_FRAGMENT_SHADER == _type ? 1 : 0;
+		const char* prefix = s_uniformBlockPrefix[stage];
+
+		bx::Error err;
+		UniformDeclGL decl;
+		bool blockWritten = false;
+
+		for (bx::LineReader reader(_code); !reader.isDone();)
+		{
+			const bx::StringView line = reader.next();
+
+			if (!parseBlockUniform(line, decl) )
+			{
+				bx::write(_writer, line);
+				bx::write(_writer, '\n');
+				continue;
+			}
+
+			if (blockWritten)
+			{
+				continue;
+			}
+
+			// Block is written in place of first uniform declaration, other
+			// declarations are removed.
+			blockWritten = true;
+
+			bx::write(_writer, &err, "layout(std140) uniform %s\n{\n", s_uniformBlockName[stage]);
+
+			for (bx::LineReader block(_code); !block.isDone();)
+			{
+				if (parseBlockUniform(block.next(), decl) )
+				{
+					bx::write(_writer, &err, "\t%.*s %.*s %s%.*s%.*s;\n"
+						, decl.precision.getLength(), decl.precision.getPtr()
+						, decl.type.getLength(),      decl.type.getPtr()
+						, prefix
+						, decl.name.getLength(),      decl.name.getPtr()
+						, decl.array.getLength(),     decl.array.getPtr()
+						);
+				}
+			}
+
+			bx::write(_writer, "};\n");
+
+			for (bx::LineReader block(_code); !block.isDone();)
+			{
+				if (parseBlockUniform(block.next(), decl) )
+				{
+					bx::write(_writer, &err, "#define %.*s %s%.*s\n"
+						, decl.name.getLength(), decl.name.getPtr()
+						, prefix
+						, decl.name.getLength(), decl.name.getPtr()
+						);
+				}
+			}
+		}
+	}
+
 	void ShaderGL::create(const Memory* _mem)
 	{
 		bx::MemoryReader reader(_mem->data, _mem->size);
@@ -6035,6 +6926,16 @@ namespace bgfx { namespace gl
 			&&  0 != bx::strCmp(code, "#version", 8) ) // #2000
 			{
 				int32_t tempLen = code.getLength() + (4<<10);
+
+				if (s_renderGL->m_uniformBlockSupport)
+				{
+					// Each uniform declaration moved into block becomes block
+					// member and #define, size of rewritten code is measured.
+					bx::SizerWriter sizer;
+					writeUniformBlockCode(&sizer, code, m_type);
+					tempLen = int32_t(bx::seek(&sizer) ) + (4<<10);
+				}
+
 				char* temp = (char*)alloca(tempLen);
 				bx::StaticMemoryBlockWriter writer(temp, tempLen);
 
@@ -6277,6 +7178,12 @@ namespace bgfx { namespace gl
 
 					bx::write(&writer, &err, "#version %d\n", version);
 
+					if (140 > version
+					&&  s_renderGL->m_uniformBlockSupport)
+					{
+						bx::write(&writer, "#extension GL_ARB_uniform_buffer_object : enable\n");
+					}
+
 					if (430 > version && usesTextureLod)
 					{
 						if (m_type == GL_FRAGMENT_SHADER)
@@ -6420,14 +7327,21 @@ namespace bgfx { namespace gl
 							);
 					}
 
+					bx::StringView source = code;
+
 					if (version == 430)
 					{
 						int32_t verLen = bx::strLen("#version 430\n");
-						bx::write(&writer, code.getPtr()+verLen, code.getLength()-verLen);
+						source.set(code.getPtr()+verLen, code.getTerm() );
+					}
+
+					if (s_renderGL->m_uniformBlockSupport)
+					{
+						writeUniformBlockCode(&writer, source, m_type);
 					}
 					else
 					{
-						bx::write(&writer, code);
+						bx::write(&writer, source);
 					}
 
 					bx::write(&writer, '\0');
@@ -6540,7 +7454,15 @@ namespace bgfx { namespace gl
 							);
 					}
 
-					bx::write(&writer, code.getPtr(), code.getLength() );
+					if (s_renderGL->m_uniformBlockSupport)
+					{
+						writeUniformBlockCode(&writer, code, m_type);
+					}
+					else
+					{
+						bx::write(&writer, code.getPtr(), code.getLength() );
+					}
+
 					bx::write(&writer, '\0');
 				}
 
@@ -7072,6 +7994,159 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	void ReadBackQueueGL::create()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_readBack); ++ii)
+		{
+			ReadBack& readBack = m_readBack[ii];
+			readBack.m_pbo      = 0;
+			readBack.m_sync     = NULL;
+			readBack.m_capacity = 0;
+		}
+	}
+
+	void ReadBackQueueGL::destroy()
+	{
+		// Read backs not delivered yet are completed before shutdown, user
+		// memory must stay valid until promised frame.
+		while (0 != m_control.available() )
+		{
+			complete(m_readBack[m_control.m_read], true);
+			m_control.consume(1);
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_readBack); ++ii)
+		{
+			ReadBack& readBack = m_readBack[ii];
+			if (0 != readBack.m_pbo)
+			{
+				GL_CHECK(glDeleteBuffers(1, &readBack.m_pbo) );
+				readBack.m_pbo      = 0;
+				readBack.m_capacity = 0;
+			}
+		}
+	}
+
+	void ReadBackQueueGL::read(const TextureGL& _texture, void* _data, uint8_t _mip)
+	{
+		while (0 == m_control.reserve(1) )
+		{
+			// Queue is full, wait only on oldest fence, not on whole GPU queue.
+			complete(m_readBack[m_control.m_read], true);
+			m_control.consume(1);
+		}
+
+		ReadBack& readBack = m_readBack[m_control.m_current];
+
+		const bimg::TextureFormat::Enum format = bimg::TextureFormat::Enum(_texture.m_textureFormat);
+		const bool compressed = bimg::isCompressed(format);
+
+		readBack.m_size = bimg::imageGetSize(
+			  NULL
+			, uint16_t(bx::max<uint32_t>(_texture.m_width >>_mip, 1) )
+			, uint16_t(bx::max<uint32_t>(_texture.m_height>>_mip, 1) )
+			, uint16_t(bx::max<uint32_t>(_texture.m_depth >>_mip, 1) )
+			, false
+			, false
+			, uint16_t(bx::max<uint32_t>(_texture.m_numLayers, 1) )
+			, format
+			);
+
+		if (0 == readBack.m_pbo)
+		{
+			GL_CHECK(glGenBuffers(1, &readBack.m_pbo) );
+		}
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, readBack.m_pbo) );
+
+		// PBO only grows, next read back of the same size reuses it.
+		if (readBack.m_capacity < readBack.m_size)
+		{
+			GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, readBack.m_size, NULL, GL_STREAM_READ) );
+			readBack.m_capacity = readBack.m_size;
+		}
+
+		GL_CHECK(glBindTexture(_texture.m_target, _texture.m_id) );
+
+		// With GL_PIXEL_PACK_BUFFER bound, last argument is offset in buffer.
+		if (compressed)
+		{
+			GL_CHECK(glGetCompressedTexImage(_texture.m_target
+				, _mip
+				, NULL
+				) );
+		}
+		else
+		{
+			GL_CHECK(glGetTexImage(_texture.m_target
+				, _mip
+				, _texture.m_fmt
+				, _texture.m_type
+				, NULL
+				) );
+		}
+
+		GL_CHECK(glBindTexture(_texture.m_target, 0) );
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+		readBack.m_sync  = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		readBack.m_frame = m_frame;
+		readBack.m_data  = _data;
+
+		m_control.commit(1);
+	}
+
+	void ReadBackQueueGL::resolve()
+	{
+		++m_frame;
+
+		while (0 != m_control.available() )
+		{
+			ReadBack& readBack = m_readBack[m_control.m_read];
+
+			// Block on this fence only when promised frame is reached.
+			const bool wait = m_frame - readBack.m_frame >= BGFX_GL_CONFIG_TEXTURE_READ_BACK_LATENCY;
+
+			if (!complete(readBack, wait) )
+			{
+				break;
+			}
+
+			m_control.consume(1);
+		}
+	}
+
+	bool ReadBackQueueGL::complete(ReadBack& _readBack, bool _wait)
+	{
+		const GLenum result = glClientWaitSync(_readBack.m_sync
+			, _wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0
+			, _wait ? UINT64_MAX : 0
+			);
+
+		if (GL_TIMEOUT_EXPIRED == result)
+		{
+			return false;
+		}
+
+		BX_WARN(GL_WAIT_FAILED != result, "Texture read back fence wait failed.");
+
+		GL_CHECK(glDeleteSync(_readBack.m_sync) );
+		_readBack.m_sync = NULL;
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, _readBack.m_pbo) );
+
+		const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, _readBack.m_size, GL_MAP_READ_BIT);
+		if (NULL != data)
+		{
+			bx::memCopy(_readBack.m_data, data, _readBack.m_size);
+			GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER) );
+		}
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+		return true;
+	}
+
 	void RendererContextGL::submitBlit(BlitState& _bs, uint16_t _view)
 	{
 		if (m_blitSupported)
@@ -7163,6 +8238,8 @@ namespace bgfx { namespace gl
 		if (1 < m_numWindows
 		&&  m_vaoSupport)
 		{
+			// VAOs can't be shared between contexts.
+			m_vaoCache.invalidate();
 			m_vaoSupport = false;
 			GL_CHECK(glBindVertexArray(0) );
 			GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
@@ -7194,15 +8271,21 @@ namespace bgfx { namespace gl
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
+
+			_render->updateTransientIndexBuffers([&](const TransientIndexBuffer& _page, uint32_t _size)
+			{
+				m_indexBuffers[_page.handle.idx].update(0, _size, _page.data, true);
+			});
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
+
+			_render->updateTransientVertexBuffers([&](const TransientVertexBuffer& _page, uint32_t _size)
+			{
+				m_vertexBuffers[_page.handle.idx].update(0, _size, _page.data, true);
+			});
 		}
 
 		_render->sort();
@@ -7220,6 +8303,7 @@ namespace bgfx { namespace gl
 
 		ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
 		ProgramHandle boundProgram   = BGFX_INVALID_HANDLE;
+		bool currentDrawBaseVertex   = false;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
@@ -7273,6 +8357,11 @@ namespace bgfx { namespace gl
 			m_occlusionQuery.resolve(_render);
 		}
 
+		if (m_asyncReadBackSupported)
+		{
+			m_readBackQueue.resolve();
+		}
+
 		if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
 		{
 			GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_msaaBackBufferFbo) );
@@ -7854,6 +8943,9 @@ namespace bgfx { namespace gl
 				bool programChanged = false;
 				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
 				bool bindAttribs = false;
+
+				uint32_t baseVertex = 0;
+				const bool drawBaseVertex = m_vaoSupport && getDrawBaseVertex(draw, baseVertex);
 				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
@@ -7864,7 +8956,7 @@ namespace bgfx { namespace gl
 					// Skip rendering if program index is valid, but program is invalid.
 					currentProgram = 0 == id ? ProgramHandle{kInvalidHandle} : currentProgram;
 
-					setProgram(id);
+					setProgram(id, 0 == id ? NULL : &m_program[currentProgram.idx]);
 					programChanged =
 						constantsChanged =
 						bindAttribs = true;
@@ -7881,6 +8973,7 @@ namespace bgfx { namespace gl
 					}
 
 					viewState.setPredefined<1>(this, view, program, _render, draw);
+					commitUniformBlocks(program);
 
 					{
 						GLbitfield barrier = 0;
@@ -7964,10 +9057,16 @@ namespace bgfx { namespace gl
 							if (currentState.m_stream[idx].m_startVertex != draw.m_stream[idx].m_startVertex)
 							{
 								currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
-								bindAttribs = true;
+								bindAttribs |= !drawBaseVertex;
 							}
 						}
 
+						if (currentDrawBaseVertex != drawBaseVertex)
+						{
+							currentDrawBaseVertex = drawBaseVertex;
+							bindAttribs = true;
+						}
+
 						if (programChanged
 						||  currentState.m_streamMask             != draw.m_streamMask
 						||  currentState.m_instanceDataBuffer.idx != draw.m_instanceDataBuffer.idx
@@ -7986,7 +9085,13 @@ namespace bgfx { namespace gl
 						{
 							currentState.m_indexBuffer = draw.m_indexBuffer;
 
-							if (isValid(draw.m_indexBuffer) )
+							if (m_vaoSupport)
+							{
+								// Index buffer binding is VAO state, VAO is switched together with
+								// vertex streams.
+								bindAttribs = true;
+							}
+							else if (isValid(draw.m_indexBuffer) )
 							{
 								IndexBufferGL& ib = m_indexBuffers[draw.m_indexBuffer.idx];
 								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib.m_id) );
@@ -8002,7 +9107,14 @@ namespace bgfx { namespace gl
 							currentState.m_startIndex = draw.m_startIndex;
 						}
 
-						if (0 != currentState.m_streamMask)
+						if (m_vaoSupport)
+						{
+							if (bindAttribs)
+							{
+								bindVertexArray(program, currentProgram, draw, drawBaseVertex);
+							}
+						}
+						else if (0 != currentState.m_streamMask)
 						{
 							if (bindAttribs)
 							{
@@ -8150,12 +9262,25 @@ namespace bgfx { namespace gl
 									numInstances      = draw.m_numInstances;
 									numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
 
-									GL_CHECK(glDrawElementsInstanced(prim.m_type
-										, numIndices
-										, indexFormat
-										, (void*)0
-										, draw.m_numInstances
-										) );
+									if (0 != baseVertex)
+									{
+										GL_CHECK(glDrawElementsInstancedBaseVertex(prim.m_type
+											, numIndices
+											, indexFormat
+											, (void*)0
+											, draw.m_numInstances
+											, baseVertex
+											) );
+									}
+									else
+									{
+										GL_CHECK(glDrawElementsInstanced(prim.m_type
+											, numIndices
+											, indexFormat
+											, (void*)0
+											, draw.m_numInstances
+											) );
+									}
 								}
 								else if (prim.m_min <= draw.m_numIndices)
 								{
@@ -8164,12 +9289,25 @@ namespace bgfx { namespace gl
 									numInstances      = draw.m_numInstances;
 									numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
 
-									GL_CHECK(glDrawElementsInstanced(prim.m_type
-										, numIndices
-										, indexFormat
-										, (void*)(uintptr_t)(draw.m_startIndex*indexSize)
-										, draw.m_numInstances
-										) );
+									if (0 != baseVertex)
+									{
+										GL_CHECK(glDrawElementsInstancedBaseVertex(prim.m_type
+											, numIndices
+											, indexFormat
+											, (void*)(uintptr_t)(draw.m_startIndex*indexSize)
+											, draw.m_numInstances
+											, baseVertex
+											) );
+									}
+									else
+									{
+										GL_CHECK(glDrawElementsInstanced(prim.m_type
+											, numIndices
+											, indexFormat
+											, (void*)(uintptr_t)(draw.m_startIndex*indexSize)
+											, draw.m_numInstances
+											) );
+									}
 								}
 							}
 							else
@@ -8179,7 +9317,7 @@ namespace bgfx { namespace gl
 								numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
 
 								GL_CHECK(glDrawArraysInstanced(prim.m_type
-									, 0
+									, baseVertex
 									, numVertices
 									, draw.m_numInstances
 									) );
@@ -47,6 +47,29 @@
 #	define BGFX_GL_CONFIG_TEXTURE_READ_BACK_EMULATION 0
 #endif // BGFX_GL_CONFIG_TEXTURE_READ_BACK_EMULATION
 
+// Number of frames texture read back result stays in pixel pack buffer before
+// renderer blocks on its fence.
+#ifndef BGFX_GL_CONFIG_TEXTURE_READ_BACK_LATENCY
+#	define BGFX_GL_CONFIG_TEXTURE_READ_BACK_LATENCY 2
+#endif // BGFX_GL_CONFIG_TEXTURE_READ_BACK_LATENCY
+
+// Number of persistently mapped copies of transient buffer, copy is reused
+// only after GPU is done with draws that used it.
+#ifndef BGFX_GL_CONFIG_STREAM_BUFFER_COPIES
+#	define BGFX_GL_CONFIG_STREAM_BUFFER_COPIES 3
+#endif // BGFX_GL_CONFIG_STREAM_BUFFER_COPIES
+
+// Move vec4/mat3/mat4 uniforms into per stage std140 uniform blocks, block
+// data is uploaded once per draw through uniform buffer ring.
+#ifndef BGFX_GL_CONFIG_UNIFORM_BLOCK
+#	define BGFX_GL_CONFIG_UNIFORM_BLOCK 1
+#endif // BGFX_GL_CONFIG_UNIFORM_BLOCK
+
+// Size of one copy of uniform buffer ring.
+#ifndef BGFX_GL_CONFIG_UNIFORM_RING_SIZE
+#	define BGFX_GL_CONFIG_UNIFORM_RING_SIZE (2<<20)
+#endif // BGFX_GL_CONFIG_UNIFORM_RING_SIZE
+
 #define BGFX_GL_PROFILER_BEGIN(_view, _abgr)                                               \
 	BX_MACRO_BLOCK_BEGIN                                                                   \
 		GL_CHECK(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, s_viewName[view]) ); \
@@ -113,6 +136,7 @@ typedef double GLdouble;
 #		endif // BX_PLATFORM_
 typedef int64_t  GLint64;
 typedef uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
 #		define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
 #		define GL_HALF_FLOAT GL_HALF_FLOAT_OES
 #		define GL_RGBA8 GL_RGBA8_OES
@@ -1084,6 +1108,82 @@ typedef uint64_t GLuint64;
 #	define GL_TEXTURE_LOD_BIAS 0x8501
 #endif // GL_TEXTURE_LOD_BIAS
 
+#ifndef GL_PIXEL_PACK_BUFFER
+#	define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif // GL_PIXEL_PACK_BUFFER
+
+#ifndef GL_STREAM_READ
+#	define GL_STREAM_READ 0x88E1
+#endif // GL_STREAM_READ
+
+#ifndef GL_MAP_READ_BIT
+#	define GL_MAP_READ_BIT 0x0001
+#endif // GL_MAP_READ_BIT
+
+#ifndef GL_MAP_WRITE_BIT
+#	define GL_MAP_WRITE_BIT 0x0002
+#endif // GL_MAP_WRITE_BIT
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#	define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+
+#ifndef GL_MAP_COHERENT_BIT
+#	define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
+#ifndef GL_DYNAMIC_STORAGE_BIT
+#	define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif // GL_DYNAMIC_STORAGE_BIT
+
+#ifndef GL_UNIFORM_BUFFER
+#	define GL_UNIFORM_BUFFER 0x8A11
+#endif // GL_UNIFORM_BUFFER
+
+#ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+#	define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#endif // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+#ifndef GL_UNIFORM_BLOCK_INDEX
+#	define GL_UNIFORM_BLOCK_INDEX 0x8A3A
+#endif // GL_UNIFORM_BLOCK_INDEX
+
+#ifndef GL_UNIFORM_OFFSET
+#	define GL_UNIFORM_OFFSET 0x8A3B
+#endif // GL_UNIFORM_OFFSET
+
+#ifndef GL_UNIFORM_BLOCK_DATA_SIZE
+#	define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+#endif // GL_UNIFORM_BLOCK_DATA_SIZE
+
+#ifndef GL_INVALID_INDEX
+#	define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif // GL_INVALID_INDEX
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#	define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#	define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif // GL_SYNC_FLUSH_COMMANDS_BIT
+
+#ifndef GL_ALREADY_SIGNALED
+#	define GL_ALREADY_SIGNALED 0x911A
+#endif // GL_ALREADY_SIGNALED
+
+#ifndef GL_CONDITION_SATISFIED
+#	define GL_CONDITION_SATISFIED 0x911C
+#endif // GL_CONDITION_SATISFIED
+
+#ifndef GL_TIMEOUT_EXPIRED
+#	define GL_TIMEOUT_EXPIRED 0x911B
+#endif // GL_TIMEOUT_EXPIRED
+
+#ifndef GL_WAIT_FAILED
+#	define GL_WAIT_FAILED 0x911D
+#endif // GL_WAIT_FAILED
+
 #if BX_PLATFORM_WINDOWS
 #	include <windows.h>
 #elif BX_PLATFORM_LINUX || BX_PLATFORM_BSD
@@ -1284,12 +1384,53 @@ namespace bgfx { namespace gl
 		HashMap m_hashMap;
 	};
 
+	struct StreamBufferGL
+	{
+		bool create(GLenum _target, uint32_t _size);
+		void destroy(GLenum _target);
+
+		// Fences current copy, switches to next one and waits until GPU is done
+		// with it.
+		void next();
+
+		// Switches to next copy for writing, returns buffer id of that copy.
+		GLuint update(uint32_t _offset, uint32_t _size, const void* _data);
+
+		GLuint   m_id[BGFX_GL_CONFIG_STREAM_BUFFER_COPIES];
+		GLsync   m_sync[BGFX_GL_CONFIG_STREAM_BUFFER_COPIES];
+		uint8_t* m_data[BGFX_GL_CONFIG_STREAM_BUFFER_COPIES];
+		uint32_t m_current;
+	};
+
+	struct UniformRingGL
+	{
+		void create(uint32_t _size, uint32_t _align, bool _persistent);
+		void destroy();
+
+		// Allocates _size bytes and returns offset. When ring is full it
+		// switches to new storage, and previously bound ranges are not valid.
+		uint32_t alloc(uint32_t _size);
+		void write(uint32_t _offset, const void* _data, uint32_t _size);
+
+		GLuint getId() const
+		{
+			return NULL != m_stream ? m_stream->m_id[m_stream->m_current] : m_id;
+		}
+
+		StreamBufferGL* m_stream; // NULL without persistent mapping, m_id is orphaned when full.
+		GLuint   m_id;
+		uint32_t m_size;
+		uint32_t m_align;
+		uint32_t m_offset;
+	};
+
 	struct IndexBufferGL
 	{
 		void create(uint32_t _size, void* _data, uint16_t _flags)
 		{
-			m_size  = _size;
-			m_flags = _flags;
+			m_size   = _size;
+			m_flags  = _flags;
+			m_stream = NULL;
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BX_ASSERT(0 != m_id, "Failed to generate buffer id.");
@@ -1302,31 +1443,13 @@ namespace bgfx { namespace gl
 			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
 		}
 
-		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
-		{
-			BX_ASSERT(0 != m_id, "Updating invalid index buffer.");
-
-			if (_discard)
-			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_flags);
-			}
-
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
-			GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
-				, _offset
-				, _size
-				, _data
-				) );
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-		}
-
+		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
 		GLuint m_id;
 		uint32_t m_size;
 		uint16_t m_flags;
+		StreamBufferGL* m_stream; // Created on first discard update, m_id rotates with it after that.
 	};
 
 	struct VertexBufferGL
@@ -1335,6 +1458,7 @@ namespace bgfx { namespace gl
 		{
 			m_size = _size;
 			m_layoutHandle = _layoutHandle;
+			m_stream = NULL;
 			const bool drawIndirect = 0 != (_flags & BGFX_BUFFER_DRAW_INDIRECT);
 
 			m_target = drawIndirect ? GL_DRAW_INDIRECT_BUFFER : GL_ARRAY_BUFFER;
@@ -1350,34 +1474,40 @@ namespace bgfx { namespace gl
 			GL_CHECK(glBindBuffer(m_target, 0) );
 		}
 
-		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
-		{
-			BX_ASSERT(0 != m_id, "Updating invalid vertex buffer.");
-
-			if (_discard)
-			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_layoutHandle, 0);
-			}
-
-			GL_CHECK(glBindBuffer(m_target, m_id) );
-			GL_CHECK(glBufferSubData(m_target
-				, _offset
-				, _size
-				, _data
-				) );
-			GL_CHECK(glBindBuffer(m_target, 0) );
-		}
-
+		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
 		GLuint m_id;
 		GLenum m_target;
 		uint32_t m_size;
 		VertexLayoutHandle m_layoutHandle;
+		StreamBufferGL* m_stream;
 	};
 
+	struct VertexArrayGL
+	{
+		bool references(GLuint _id) const
+		{
+			for (uint32_t ii = 0; ii < m_numBuffers; ++ii)
+			{
+				if (_id == m_buffer[ii])
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		GLuint   m_id;
+		GLuint   m_buffer[BGFX_CONFIG_MAX_VERTEX_STREAMS+2]; // Index, instance data and vertex buffers.
+		uint32_t m_startVertex[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint32_t m_instanceDataOffset;
+		uint8_t  m_numBuffers;
+	};
+
+	void release(VertexArrayGL& _vao);
+
 	struct TextureGL
 	{
 		TextureGL()
@@ -1477,8 +1607,13 @@ namespace bgfx { namespace gl
 			: m_id(0)
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
+			, m_uniformBlockDirty(false)
 		{
 			m_instanceData[0] = -1;
+			m_uniformBlock[0] = NULL;
+			m_uniformBlock[1] = NULL;
+			m_uniformBlockSize[0] = 0;
+			m_uniformBlockSize[1] = 0;
 		}
 
 		void create(const ShaderGL& _vsh, const ShaderGL& _fsh);
@@ -1504,8 +1639,12 @@ namespace bgfx { namespace gl
 		uint8_t m_numSamplers;
 
 		UniformBuffer* m_constantBuffer;
-		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		PredefinedUniform m_predefined[PredefinedUniform::Count*2]; // Uniform block has vertex and fragment copy.
 		uint8_t m_numPredefined;
+
+		uint8_t* m_uniformBlock[2]; // CPU copy of vertex/fragment uniform block, std140 layout.
+		uint32_t m_uniformBlockSize[2];
+		bool m_uniformBlockDirty;
 	};
 
 	struct TimerQueryGL
@@ -1673,6 +1812,36 @@ namespace bgfx { namespace gl
 		bx::RingBufferControl m_control;
 	};
 
+	struct ReadBackQueueGL
+	{
+		ReadBackQueueGL()
+			: m_control(BX_COUNTOF(m_readBack) )
+			, m_frame(0)
+		{
+		}
+
+		void create();
+		void destroy();
+		void read(const TextureGL& _texture, void* _data, uint8_t _mip);
+		void resolve();
+
+		struct ReadBack
+		{
+			GLuint m_pbo;
+			GLsync m_sync;
+			uint32_t m_size;
+			uint32_t m_capacity;
+			uint32_t m_frame;
+			void* m_data;
+		};
+
+		bool complete(ReadBack& _readBack, bool _wait);
+
+		ReadBack m_readBack[BGFX_CONFIG_MAX_TEXTURE_READ_BACKS];
+		bx::RingBufferControl m_control;
+		uint32_t m_frame;
+	};
+
 } /* namespace gl */ } // namespace bgfx
 
 #endif // BGFX_RENDERER_GL_H_HEADER_GUARD
@@ -1221,6 +1221,11 @@ namespace bgfx { namespace mtl
 			return false;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void flip() override
 		{
 			if (NULL == m_commandBuffer)
@@ -3876,15 +3881,21 @@ namespace bgfx { namespace mtl
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, bx::strideAlign(_render->m_iboffset,4), ib->data, true);
+
+			_render->updateTransientIndexBuffers([&](const TransientIndexBuffer& _page, uint32_t _size)
+			{
+				m_indexBuffers[_page.handle.idx].update(0, bx::strideAlign(_size,4), _page.data, true);
+			});
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, bx::strideAlign(_render->m_vboffset,4), vb->data, true);
+
+			_render->updateTransientVertexBuffers([&](const TransientVertexBuffer& _page, uint32_t _size)
+			{
+				m_vertexBuffers[_page.handle.idx].update(0, bx::strideAlign(_size,4), _page.data, true);
+			});
 		}
 
 		_render->sort();
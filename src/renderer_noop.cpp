@@ -4,9 +4,89 @@
  */
 
 #include "bgfx_p.h"
+#include "renderer.h"
 
 namespace bgfx { namespace noop
 {
+	struct PrimInfo
+	{
+		uint32_t m_min;
+		uint32_t m_div;
+		uint32_t m_sub;
+	};
+
+	static const PrimInfo s_primInfo[] =
+	{
+		{ 3, 3, 0 },
+		{ 3, 1, 2 },
+		{ 2, 2, 0 },
+		{ 2, 1, 1 },
+		{ 1, 1, 0 },
+		{ 0, 0, 0 },
+	};
+	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_primInfo)-1);
+
+	// Only what's needed to walk render items the same way GPU backends do, so
+	// that CPU cost of frame submission can be measured without GPU.
+	struct BufferNOOP
+	{
+		uint32_t m_size;
+		uint16_t m_flags;
+		VertexLayoutHandle m_layoutHandle;
+	};
+
+	// State transitions seen by render item when its view batch is walked on
+	// its own, starting from cleared state.
+	struct ViewBatchItem
+	{
+		uint16_t m_view;
+		bool     m_viewChanged;
+		bool     m_programChanged;
+	};
+
+	struct ViewBatchRecord
+	{
+		const Frame*     frame;
+		const ViewBatch* batch;
+		ViewBatchItem*   items;
+	};
+
+	static void recordViewBatch(void* _userData, uint32_t _idx)
+	{
+		const ViewBatchRecord& record = *static_cast<const ViewBatchRecord*>(_userData);
+		const Frame*     frame = record.frame;
+		const ViewBatch& batch = record.batch[_idx];
+
+		SortKey key;
+		uint16_t view = UINT16_MAX;
+		ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
+
+		for (uint32_t item = batch.m_begin; item < batch.m_end; ++item)
+		{
+			key.decode(frame->m_sortKeys[item], frame->m_viewRemap);
+			BX_ASSERT(batch.m_viewBegin <= key.m_view && key.m_view < batch.m_viewEnd
+				, "View %d is outside of batch %d views [%d, %d)."
+				, key.m_view
+				, _idx
+				, batch.m_viewBegin
+				, batch.m_viewEnd
+				);
+
+			ViewBatchItem& batchItem = record.items[item];
+			batchItem.m_viewChanged = key.m_view != view;
+
+			if (batchItem.m_viewChanged)
+			{
+				view = key.m_view;
+				currentProgram = BGFX_INVALID_HANDLE;
+			}
+
+			batchItem.m_view           = view;
+			batchItem.m_programChanged = key.m_program.idx != currentProgram.idx;
+			currentProgram = key.m_program;
+		}
+	}
+
 	struct RendererContextNOOP : public RendererContextI
 	{
 		RendererContextNOOP()
@@ -68,10 +148,29 @@ namespace bgfx { namespace noop
 			g_caps.limits.maxComputeBindings = g_caps.limits.maxTextureSamplers;
 			g_caps.limits.maxFBAttachments   = BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS;
 			g_caps.limits.maxVertexStreams   = BGFX_CONFIG_MAX_VERTEX_STREAMS;
+
+			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+
+			m_batchItems = BX_ENABLED(BGFX_CONFIG_DEBUG)
+				? (ViewBatchItem*)BX_ALLOC(g_allocator, sizeof(ViewBatchItem)*g_caps.limits.maxDrawCalls)
+				: NULL
+				;
 		}
 
 		~RendererContextNOOP()
 		{
+			if (NULL != m_batchItems)
+			{
+				BX_FREE(g_allocator, m_batchItems);
+			}
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniforms); ++ii)
+			{
+				if (NULL != m_uniforms[ii])
+				{
+					BX_FREE(g_allocator, m_uniforms[ii]);
+				}
+			}
 		}
 
 		RendererType::Enum getRendererType() const override
@@ -89,36 +188,52 @@ namespace bgfx { namespace noop
 			return false;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void flip() override
 		{
 		}
 
-		void createIndexBuffer(IndexBufferHandle /*_handle*/, const Memory* /*_mem*/, uint16_t /*_flags*/) override
+		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) override
 		{
+			BufferNOOP& ib = m_indexBuffers[_handle.idx];
+			ib.m_size  = _mem->size;
+			ib.m_flags = _flags;
 		}
 
 		void destroyIndexBuffer(IndexBufferHandle /*_handle*/) override
 		{
 		}
 
-		void createVertexLayout(VertexLayoutHandle /*_handle*/, const VertexLayout& /*_layout*/) override
+		void createVertexLayout(VertexLayoutHandle _handle, const VertexLayout& _layout) override
 		{
+			bx::memCopy(&m_vertexLayouts[_handle.idx], &_layout, sizeof(VertexLayout) );
 		}
 
 		void destroyVertexLayout(VertexLayoutHandle /*_handle*/) override
 		{
 		}
 
-		void createVertexBuffer(VertexBufferHandle /*_handle*/, const Memory* /*_mem*/, VertexLayoutHandle /*_layoutHandle*/, uint16_t /*_flags*/) override
+		void createVertexBuffer(VertexBufferHandle _handle, const Memory* _mem, VertexLayoutHandle _layoutHandle, uint16_t _flags) override
 		{
+			BufferNOOP& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size  = _mem->size;
+			vb.m_flags = _flags;
+			vb.m_layoutHandle = _layoutHandle;
 		}
 
 		void destroyVertexBuffer(VertexBufferHandle /*_handle*/) override
 		{
 		}
 
-		void createDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
 		{
+			BufferNOOP& ib = m_indexBuffers[_handle.idx];
+			ib.m_size  = _size;
+			ib.m_flags = _flags;
 		}
 
 		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
@@ -129,8 +244,12 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
 		{
+			BufferNOOP& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size  = _size;
+			vb.m_flags = _flags;
+			vb.m_layoutHandle.idx = kInvalidHandle;
 		}
 
 		void updateDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
@@ -207,12 +326,23 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createUniform(UniformHandle /*_handle*/, UniformType::Enum /*_type*/, uint16_t /*_num*/, const char* /*_name*/) override
+		void createUniform(UniformHandle _handle, UniformType::Enum _type, uint16_t _num, const char* /*_name*/) override
 		{
+			if (NULL != m_uniforms[_handle.idx])
+			{
+				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			}
+
+			const uint32_t size = bx::alignUp(g_uniformTypeSize[_type]*_num, 16);
+			void* data = BX_ALLOC(g_allocator, size);
+			bx::memSet(data, 0, size);
+			m_uniforms[_handle.idx] = data;
 		}
 
-		void destroyUniform(UniformHandle /*_handle*/) override
+		void destroyUniform(UniformHandle _handle) override
 		{
+			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			m_uniforms[_handle.idx] = NULL;
 		}
 
 		void requestScreenShot(FrameBufferHandle /*_handle*/, const char* /*_filePath*/) override
@@ -223,8 +353,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void updateUniform(uint16_t /*_loc*/, const void* /*_data*/, uint32_t /*_size*/) override
+		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
+			bx::memCopy(m_uniforms[_loc], _data, _size);
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle /*_handle*/) override
@@ -244,16 +375,240 @@ namespace bgfx { namespace noop
 			const int64_t timerFreq = bx::getHPFrequency();
 			const int64_t timeBegin = bx::getHPCounter();
 
+			_render->sort();
+
+			RenderDraw currentState;
+			currentState.clear();
+			currentState.m_stateFlags = BGFX_STATE_NONE;
+			currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
+
+			RenderBind currentBind;
+			currentBind.clear();
+
+			ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
+			SortKey key;
+			uint16_t view = UINT16_MAX;
+
+			BlitState bs(_render);
+
+			uint8_t primIndex = 0;
+			uint32_t currentNumVertices = 0;
+
+			uint32_t statsNumPrimsRendered[BX_COUNTOF(s_primInfo)] = {};
+			uint32_t statsKeyType[2] = {};
+
+			if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
+			{
+				const int32_t numItems = _render->m_numRenderItems;
+
+				if (NULL != m_batchItems)
+				{
+					// Test path for view batch splitter. Each batch is walked on
+					// worker thread from cleared state, the way backend would
+					// record it into secondary command buffer. Single threaded walk
+					// below must see the same view and program changes, which holds
+					// only if batches start at view boundaries. Items not visited by
+					// any batch keep invalid view.
+					JobPool& jobPool = getJobPool();
+
+					ViewBatch batch[BGFX_CONFIG_MAX_WORKER_THREADS+1];
+					const uint32_t numBatches = _render->getViewBatches(batch, jobPool.getNumThreads()+1);
+
+					bx::memSet(m_batchItems, 0xff, sizeof(ViewBatchItem)*numItems);
+
+					ViewBatchRecord record = { _render, batch, m_batchItems };
+					jobPool.parallelFor(recordViewBatch, &record, numBatches);
+				}
+
+				for (int32_t item = 0; item < numItems;)
+				{
+					const uint64_t encodedKey = _render->m_sortKeys[item];
+					const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
+					statsKeyType[isCompute]++;
+
+					const bool viewChanged = key.m_view != view;
+
+					const ViewBatchItem* batchItem = NULL != m_batchItems
+						? &m_batchItems[item]
+						: NULL
+						;
+					BX_ASSERT(NULL == batchItem
+						|| (batchItem->m_view == key.m_view && batchItem->m_viewChanged == viewChanged)
+						, "View batch walk of render item %d doesn't match single threaded walk (view %d, batch view %d)."
+						, item
+						, key.m_view
+						, batchItem->m_view
+						);
+
+					const uint32_t itemIdx       = _render->m_sortValues[item];
+					const RenderItem& renderItem = _render->m_renderItem[itemIdx];
+					const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+					++item;
+
+					if (viewChanged)
+					{
+						view = key.m_view;
+						currentProgram = BGFX_INVALID_HANDLE;
+
+						while (bs.hasItem(view) )
+						{
+							bs.advance();
+						}
+					}
+
+					if (isCompute)
+					{
+						const RenderCompute& compute = renderItem.compute;
+						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+						currentProgram = key.m_program;
+						currentState.clear();
+						currentBind.clear();
+						continue;
+					}
+
+					const RenderDraw& draw = renderItem.draw;
+
+					if (viewChanged)
+					{
+						currentState.clear();
+						currentState.m_scissor = !draw.m_scissor;
+						currentBind.clear();
+					}
+
+					const uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
+					currentState.m_stateFlags = draw.m_stateFlags;
+					currentState.m_stencil    = draw.m_stencil;
+					currentState.m_scissor    = draw.m_scissor;
+
+					if (viewChanged
+					||  BGFX_STATE_PT_MASK & changedFlags)
+					{
+						primIndex = uint8_t( (draw.m_stateFlags&BGFX_STATE_PT_MASK)>>BGFX_STATE_PT_SHIFT);
+					}
+
+					const PrimInfo& prim = s_primInfo[primIndex];
+
+					rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+
+					const bool programChanged = key.m_program.idx != currentProgram.idx;
+					currentProgram = key.m_program;
+					BX_ASSERT(NULL == batchItem || batchItem->m_programChanged == programChanged
+						, "View batch walk of render item %d sees different program change."
+						, item-1
+						);
+					BX_UNUSED(batchItem);
+
+					for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+					{
+						const Binding& bind = renderBind.m_bind[stage];
+						Binding& current = currentBind.m_bind[stage];
+						if (current.m_idx          != bind.m_idx
+						||  current.m_type         != bind.m_type
+						||  current.m_samplerFlags != bind.m_samplerFlags
+						||  programChanged)
+						{
+							current = bind;
+						}
+					}
+
+					if (programChanged
+					||  hasVertexStreamChanged(currentState, draw) )
+					{
+						currentState.m_streamMask             = draw.m_streamMask;
+						currentState.m_instanceDataBuffer.idx = draw.m_instanceDataBuffer.idx;
+						currentState.m_instanceDataOffset     = draw.m_instanceDataOffset;
+						currentState.m_instanceDataStride     = draw.m_instanceDataStride;
+
+						uint32_t numVertices = draw.m_numVertices;
+
+						if (UINT8_MAX != draw.m_streamMask)
+						{
+							for (uint32_t idx = 0, streamMask = draw.m_streamMask
+								; 0 != streamMask
+								; streamMask >>= 1, idx += 1
+								)
+							{
+								const uint32_t ntz = bx::uint32_cnttz(streamMask);
+								streamMask >>= ntz;
+								idx         += ntz;
+
+								currentState.m_stream[idx] = draw.m_stream[idx];
+
+								const BufferNOOP& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
+								const uint16_t layoutIdx = isValid(draw.m_stream[idx].m_layoutHandle)
+									? draw.m_stream[idx].m_layoutHandle.idx
+									: vb.m_layoutHandle.idx
+									;
+								const uint32_t stride = kInvalidHandle != layoutIdx
+									? m_vertexLayouts[layoutIdx].m_stride
+									: 0
+									;
+
+								numVertices = bx::uint32_min(UINT32_MAX == draw.m_numVertices && 0 != stride
+									? vb.m_size/stride
+									: draw.m_numVertices
+									, numVertices
+									);
+							}
+						}
+
+						currentNumVertices = numVertices;
+					}
+
+					currentState.m_indexBuffer = draw.m_indexBuffer;
+
+					if (0 != currentState.m_streamMask
+					&&  !isValid(draw.m_indirectBuffer)
+					&&  0 != prim.m_div)
+					{
+						uint32_t numPrimsSubmitted = 0;
+
+						if (isValid(draw.m_indexBuffer) )
+						{
+							uint32_t numIndices = draw.m_numIndices;
+
+							if (UINT32_MAX == numIndices)
+							{
+								const BufferNOOP& ib = m_indexBuffers[draw.m_indexBuffer.idx];
+								const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+								numIndices = ib.m_size/indexSize;
+							}
+
+							if (prim.m_min <= numIndices)
+							{
+								numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
+							}
+						}
+						else if (prim.m_min <= currentNumVertices)
+						{
+							numPrimsSubmitted = currentNumVertices/prim.m_div - prim.m_sub;
+						}
+
+						statsNumPrimsRendered[primIndex] += numPrimsSubmitted*draw.m_numInstances;
+					}
+				}
+
+				while (bs.hasItem(BGFX_CONFIG_MAX_VIEWS) )
+				{
+					bs.advance();
+				}
+			}
+
+			const int64_t timeEnd = bx::getHPCounter();
+
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
+			perfStats.cpuTimeEnd    = timeEnd;
 			perfStats.cpuTimerFreq  = timerFreq;
 
 			perfStats.gpuTimeBegin  = 0;
 			perfStats.gpuTimeEnd    = 0;
 			perfStats.gpuTimerFreq  = 1000000000;
 
-			bx::memSet(perfStats.numPrims, 0, sizeof(perfStats.numPrims) );
+			perfStats.numDraw       = statsKeyType[0];
+			perfStats.numCompute    = statsKeyType[1];
+			perfStats.numBlit       = _render->m_numBlitItems;
+			bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
 
 			perfStats.gpuMemoryMax  = -INT64_MAX;
 			perfStats.gpuMemoryUsed = -INT64_MAX;
@@ -266,6 +621,13 @@ namespace bgfx { namespace noop
 		void blitRender(TextVideoMemBlitter& /*_blitter*/, uint32_t /*_numIndices*/) override
 		{
 		}
+
+		BufferNOOP   m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		BufferNOOP   m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		VertexLayout m_vertexLayouts[BGFX_CONFIG_MAX_VERTEX_LAYOUTS];
+		void*        m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+
+		ViewBatchItem* m_batchItems;
 	};
 
 	static RendererContextNOOP* s_renderNOOP;
@@ -1051,10 +1051,15 @@ VK_IMPORT_DEVICE
 
 #define MAX_DESCRIPTOR_SETS (1024 * BGFX_CONFIG_MAX_FRAME_LATENCY)
 
+	constexpr uint32_t kImageViewCacheSize = 1024;
+	constexpr uint32_t kScratchEntrySize   = 128;
+
 	struct RendererContextVK : public RendererContextI
 	{
 		RendererContextVK()
 			: m_allocatorCb(NULL)
+			, m_descriptorSetHits(0)
+			, m_descriptorSetMisses(0)
 			, m_renderDocDll(NULL)
 			, m_vulkan1Dll(NULL)
 			, m_maxAnisotropy(1.0f)
@@ -1813,6 +1818,8 @@ VK_IMPORT_DEVICE
 					: _init.resolution.maxFrameLatency
 					;
 
+				m_memoryAllocator.init(BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE);
+
 				result = m_cmd.init(m_globalQueueFamily, m_globalQueue, m_numFramesInFlight);
 
 				if (VK_SUCCESS != result)
@@ -1868,29 +1875,15 @@ VK_IMPORT_DEVICE
 			errorState = ErrorState::SwapChainCreated;
 
 			{
-				VkDescriptorPoolSize dps[] =
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
-					{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_SAMPLER,                MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, MAX_DESCRIPTOR_SETS * 2                                },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-				};
+					result = m_descriptorSetCache[ii].create(MAX_DESCRIPTOR_SETS);
 
-				VkDescriptorPoolCreateInfo dpci;
-				dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-				dpci.pNext = NULL;
-				dpci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-				dpci.maxSets       = MAX_DESCRIPTOR_SETS;
-				dpci.poolSizeCount = BX_COUNTOF(dps);
-				dpci.pPoolSizes    = dps;
-
-				result = vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, &m_descriptorPool);
-
-				if (VK_SUCCESS != result)
-				{
-					BX_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
-					goto error;
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 				}
 
 				VkPipelineCacheCreateInfo pcci;
@@ -1909,12 +1902,13 @@ VK_IMPORT_DEVICE
 			}
 
 			{
-				const uint32_t size = 128;
-				const uint32_t count = BGFX_CONFIG_MAX_DRAW_CALLS;
+				// Grown in submit when frame has more render items.
+				const uint32_t count = bx::min<uint32_t>(g_caps.limits.maxDrawCalls, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS);
 				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
 					BX_TRACE("Create scratch buffer %d", ii);
-					m_scratchBuffer[ii].create(size, count);
+					m_scratchBuffer[ii].create(kScratchEntrySize, count);
+					m_scratchStagingBuffer[ii].createStaging(_init.limits.stagingBufferSize);
 				}
 			}
 
@@ -1964,6 +1958,8 @@ VK_IMPORT_DEVICE
 				goto error;
 			}
 
+			m_readBackQueue.init();
+
 			g_internalData.context = m_device;
 			return true;
 
@@ -1982,9 +1978,10 @@ VK_IMPORT_DEVICE
 				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
 					m_scratchBuffer[ii].destroy();
+					m_scratchStagingBuffer[ii].destroy();
+					m_descriptorSetCache[ii].destroy();
 				}
 				vkDestroy(m_pipelineCache);
-				vkDestroy(m_descriptorPool);
 				BX_FALLTHROUGH;
 
 			case ErrorState::SwapChainCreated:
@@ -1993,6 +1990,7 @@ VK_IMPORT_DEVICE
 
 			case ErrorState::CommandQueueCreated:
 				m_cmd.shutdown();
+				m_memoryAllocator.shutdown();
 				BX_FALLTHROUGH;
 
 			case ErrorState::DeviceCreated:
@@ -2031,6 +2029,7 @@ VK_IMPORT_DEVICE
 				m_gpuTimer.shutdown();
 			}
 			m_occlusionQuery.shutdown();
+			m_readBackQueue.shutdown();
 
 			preReset();
 
@@ -2044,6 +2043,7 @@ VK_IMPORT_DEVICE
 			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 			{
 				m_scratchBuffer[ii].destroy();
+				m_scratchStagingBuffer[ii].destroy();
 			}
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
@@ -2075,8 +2075,14 @@ VK_IMPORT_DEVICE
 
 			m_cmd.shutdown();
 
+			m_memoryAllocator.shutdown();
+
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			{
+				m_descriptorSetCache[ii].destroy();
+			}
+
 			vkDestroy(m_pipelineCache);
-			vkDestroy(m_descriptorPool);
 
 			vkDestroyDevice(m_device, m_allocatorCb);
 
@@ -2108,6 +2114,11 @@ VK_IMPORT_DEVICE
 			return false;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return m_cmd.m_numFramesInFlight;
+		}
+
 		void flip() override
 		{
 			int64_t start = bx::getHPCounter();
@@ -2229,30 +2240,7 @@ VK_IMPORT_DEVICE
 
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
-			TextureVK& texture = m_textures[_handle.idx];
-
-			uint32_t height = bx::uint32_max(1, texture.m_height >> _mip);
-			uint32_t pitch  = texture.m_readback.pitch(_mip);
-			uint32_t size = height * pitch;
-
-			VkDeviceMemory stagingMemory;
-			VkBuffer stagingBuffer;
-			VK_CHECK(createReadbackBuffer(size, &stagingBuffer, &stagingMemory) );
-
-			texture.m_readback.copyImageToBuffer(
-				  m_commandBuffer
-				, stagingBuffer
-				, texture.m_currentImageLayout
-				, texture.m_aspectMask
-				, _mip
-				);
-
-			kick(true);
-
-			texture.m_readback.readback(stagingMemory, 0, _data, _mip);
-
-			vkDestroy(stagingBuffer);
-			vkDestroy(stagingMemory);
+			m_readBackQueue.read(m_textures[_handle.idx], _data, _mip);
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
@@ -2297,6 +2285,7 @@ VK_IMPORT_DEVICE
 
 		void destroyTexture(TextureHandle _handle) override
 		{
+			invalidateDescriptorSets();
 			m_imageViewCache.invalidateWithParent(_handle.idx);
 			m_textures[_handle.idx].destroy();
 		}
@@ -2485,6 +2474,15 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		void release(DeviceMemoryAllocationVK& _alloc)
+		{
+			if (VK_NULL_HANDLE != _alloc.m_memory)
+			{
+				m_cmd.release(_alloc);
+				_alloc = DeviceMemoryAllocationVK();
+			}
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -2668,6 +2666,7 @@ VK_IMPORT_DEVICE
 				m_maxAnisotropy = maxAnisotropy;
 				m_samplerCache.invalidate();
 				m_samplerBorderColorCache.invalidate();
+				invalidateDescriptorSets();
 			}
 
 			bool depthClamp = m_deviceFeatures.depthClamp && !!(_resolution.reset & BGFX_RESET_DEPTH_CLAMP);
@@ -2839,7 +2838,7 @@ VK_IMPORT_DEVICE
 			}
 		}
 
-		void setBlendState(VkPipelineColorBlendStateCreateInfo& _desc, uint64_t _state, uint32_t _rgba = 0)
+		void setBlendState(VkPipelineColorBlendStateCreateInfo& _desc, const FrameBufferVK& _frameBuffer, uint64_t _state, uint32_t _rgba = 0)
 		{
 			VkPipelineColorBlendAttachmentState* bas = const_cast<VkPipelineColorBlendAttachmentState*>(_desc.pAttachments);
 
@@ -2874,13 +2873,8 @@ VK_IMPORT_DEVICE
 				bas->colorWriteMask = writeMask;
 			}
 
-			const FrameBufferVK& frameBuffer = isValid(m_fbh)
-				? m_frameBuffers[m_fbh.idx]
-				: m_backBuffer
-				;
-
-			const uint32_t numAttachments = NULL == frameBuffer.m_nwh
-				? frameBuffer.m_num
+			const uint32_t numAttachments = NULL == _frameBuffer.m_nwh
+				? _frameBuffer.m_num
 				: 1
 				;
 
@@ -3324,7 +3318,9 @@ VK_IMPORT_DEVICE
 				}
 				else
 				{
+					// Border color changed, old sampler is replaced.
 					m_samplerBorderColorCache.add(hashKey, newColorHashKey);
+					invalidateDescriptorSets();
 				}
 			}
 
@@ -3403,6 +3399,12 @@ VK_IMPORT_DEVICE
 				| ( _stencil ? VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT)
 				;
 
+			// When cache is full add evicts least recently used view.
+			if (kImageViewCacheSize <= m_imageViewCache.getCount() )
+			{
+				invalidateDescriptorSets();
+			}
+
 			VkImageView view;
 			VK_CHECK(texture.createView(0, texture.m_numSides, _mip, _numMips, _type, aspectMask, false, &view) );
 			m_imageViewCache.add(hashKey, view, _handle.idx);
@@ -3450,9 +3452,222 @@ VK_IMPORT_DEVICE
 			return pipeline;
 		}
 
-		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		// Pipeline missing from cache, found while walking view batch.
+		struct ViewBatchPipeline
 		{
-			ProgramVK& program = m_program[_program.idx];
+			const VertexLayout* m_layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+			uint64_t            m_state;
+			uint64_t            m_stencil;
+			uint32_t            m_hash;
+			ProgramHandle       m_program;
+			FrameBufferHandle   m_fbh;
+			uint8_t             m_numStreams;
+			uint8_t             m_numInstanceData;
+			VkPipelineCache     m_cache;
+			VkPipeline          m_pipeline;
+		};
+
+		struct ViewBatchPipelineJob
+		{
+			RendererContextVK*  m_ctx;
+			const Frame*        m_frame;
+			const ViewBatch*    m_batch;
+			ViewBatchPipeline** m_pipeline;
+		};
+
+		static void findViewBatchPipelinesJob(void* _userData, uint32_t _idx)
+		{
+			ViewBatchPipelineJob& job = *static_cast<ViewBatchPipelineJob*>(_userData);
+			job.m_ctx->findViewBatchPipelines(job.m_frame, job.m_batch[_idx], _idx);
+		}
+
+		static void createViewBatchPipelineJob(void* _userData, uint32_t _idx)
+		{
+			ViewBatchPipelineJob& job = *static_cast<ViewBatchPipelineJob*>(_userData);
+			ViewBatchPipeline& vbp = *job.m_pipeline[_idx];
+			vbp.m_pipeline = job.m_ctx->createPipeline(
+				  vbp.m_cache
+				, vbp.m_state
+				, vbp.m_stencil
+				, vbp.m_numStreams
+				, vbp.m_layouts
+				, vbp.m_program
+				, vbp.m_numInstanceData
+				, vbp.m_fbh
+				);
+		}
+
+		// Walks draws in view batch the same way submit does, and collects
+		// pipelines that are not in cache yet. Runs on worker thread, only reads
+		// pipeline state cache. Pipelines over per batch limit are left to submit.
+		void findViewBatchPipelines(const Frame* _render, const ViewBatch& _batch, uint32_t _batchIdx)
+		{
+			ViewBatchPipeline* pipeline = m_viewBatchPipeline[_batchIdx];
+			uint32_t num = 0;
+
+			SortKey key;
+			uint16_t view = UINT16_MAX;
+			FrameBufferHandle fbh = BGFX_INVALID_HANDLE;
+			bool isFrameBufferValid = false;
+
+			for (uint32_t item = _batch.m_begin
+				; item < _batch.m_end && num < BX_COUNTOF(m_viewBatchPipeline[0])
+				; ++item
+				)
+			{
+				const bool isCompute = key.decode(_render->m_sortKeys[item], _render->m_viewRemap);
+
+				if (isCompute
+				||  !isValid(key.m_program) )
+				{
+					continue;
+				}
+
+				if (key.m_view != view)
+				{
+					view = key.m_view;
+					fbh  = _render->m_view[view].m_fbh;
+
+					const FrameBufferVK& fb = isValid(fbh)
+						? m_frameBuffers[fbh.idx]
+						: m_backBuffer
+						;
+
+					isFrameBufferValid = fb.isRenderable();
+				}
+
+				const RenderDraw& draw = _render->m_renderItem[_render->m_sortValues[item] ].draw;
+
+				if (!isFrameBufferValid
+				||  0 == draw.m_streamMask)
+				{
+					continue;
+				}
+
+				ViewBatchPipeline& vbp = pipeline[num];
+				vbp.m_numStreams = 0;
+
+				if (UINT8_MAX != draw.m_streamMask)
+				{
+					for (uint32_t idx = 0, streamMask = draw.m_streamMask
+						; 0 != streamMask
+						; streamMask >>= 1, idx += 1, ++vbp.m_numStreams
+						)
+					{
+						const uint32_t ntz = bx::uint32_cnttz(streamMask);
+						streamMask >>= ntz;
+						idx         += ntz;
+
+						const VertexBufferVK& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
+						const uint16_t decl = isValid(draw.m_stream[idx].m_layoutHandle)
+							? draw.m_stream[idx].m_layoutHandle.idx
+							: vb.m_layoutHandle.idx
+							;
+						vbp.m_layouts[vbp.m_numStreams] = &m_vertexLayouts[decl];
+					}
+				}
+
+				vbp.m_state   = draw.m_stateFlags;
+				vbp.m_stencil = draw.m_stencil;
+				vbp.m_program = key.m_program;
+				vbp.m_fbh     = fbh;
+				vbp.m_numInstanceData = uint8_t(draw.m_instanceDataStride/16);
+				vbp.m_hash = getPipelineHash(
+					  vbp.m_state
+					, vbp.m_stencil
+					, vbp.m_numStreams
+					, vbp.m_layouts
+					, vbp.m_program
+					, vbp.m_numInstanceData
+					, vbp.m_fbh
+					);
+
+				if (VK_NULL_HANDLE != m_pipelineStateCache.find(vbp.m_hash) )
+				{
+					continue;
+				}
+
+				uint32_t ii = 0;
+				for (; ii < num && pipeline[ii].m_hash != vbp.m_hash; ++ii)
+				{
+				}
+
+				num += ii == num;
+			}
+
+			m_numViewBatchPipelines[_batchIdx] = num;
+		}
+
+		// Creates pipelines used by frame on worker threads before submit walks
+		// render items. Command recording itself stays on render thread, since
+		// uniform state, scratch buffer and descriptor pool are shared between
+		// all views, but pipeline creation is the most expensive part of it.
+		void createViewBatchPipelines(const Frame* _render)
+		{
+			JobPool& jobPool = getJobPool();
+
+			if (0 == BGFX_CONFIG_PARALLEL_PIPELINE_MIN_ITEMS
+			||  0 == jobPool.getNumThreads()
+			||  BGFX_CONFIG_PARALLEL_PIPELINE_MIN_ITEMS > _render->m_numRenderItems)
+			{
+				return;
+			}
+
+			BGFX_PROFILER_SCOPE("bgfx/Create view batch pipelines", kColorResource);
+
+			ViewBatch batch[BGFX_CONFIG_MAX_WORKER_THREADS+1];
+			const uint32_t numBatches = _render->getViewBatches(batch, jobPool.getNumThreads()+1);
+
+			ViewBatchPipeline* pipeline[BX_COUNTOF(m_viewBatchPipeline)*BX_COUNTOF(m_viewBatchPipeline[0])];
+
+			ViewBatchPipelineJob job;
+			job.m_ctx      = this;
+			job.m_frame    = _render;
+			job.m_batch    = batch;
+			job.m_pipeline = pipeline;
+			jobPool.parallelFor(findViewBatchPipelinesJob, &job, numBatches);
+
+			uint32_t num = 0;
+
+			for (uint32_t batchIdx = 0; batchIdx < numBatches; ++batchIdx)
+			{
+				for (uint32_t ii = 0, numPipelines = m_numViewBatchPipelines[batchIdx]; ii < numPipelines; ++ii)
+				{
+					ViewBatchPipeline* vbp = &m_viewBatchPipeline[batchIdx][ii];
+
+					uint32_t jj = 0;
+					for (; jj < num && pipeline[jj]->m_hash != vbp->m_hash; ++jj)
+					{
+					}
+
+					if (jj == num)
+					{
+						vbp->m_cache = beginPipelineCache(vbp->m_hash);
+						pipeline[num++] = vbp;
+					}
+				}
+			}
+
+			if (0 == num)
+			{
+				return;
+			}
+
+			jobPool.parallelFor(createViewBatchPipelineJob, &job, num);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				m_pipelineStateCache.add(pipeline[ii]->m_hash, pipeline[ii]->m_pipeline);
+				endPipelineCache(pipeline[ii]->m_hash, pipeline[ii]->m_cache);
+			}
+		}
+
+		// Masks state bits that don't affect pipeline, and returns pipeline hash
+		// for given frame buffer. It only reads renderer state, and it's safe to
+		// call from worker threads.
+		uint32_t getPipelineHash(uint64_t& _state, uint64_t& _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData, FrameBufferHandle _fbh)
+		{
+			const ProgramVK& program = m_program[_program.idx];
 
 			_state &= 0
 				| BGFX_STATE_WRITE_MASK
@@ -3485,8 +3700,8 @@ VK_IMPORT_DEVICE
 				}
 			}
 
-			const FrameBufferVK& frameBuffer = isValid(m_fbh)
-				? m_frameBuffers[m_fbh.idx]
+			const FrameBufferVK& frameBuffer = isValid(_fbh)
+				? m_frameBuffers[_fbh.idx]
 				: m_backBuffer
 				;
 
@@ -3510,19 +3725,25 @@ VK_IMPORT_DEVICE
 			murmur.add(layout.m_attributes, sizeof(layout.m_attributes) );
 			murmur.add(_numInstanceData);
 			murmur.add(frameBuffer.m_renderPass);
-			const uint32_t hash = murmur.end();
+			return murmur.end();
+		}
 
-			VkPipeline pipeline = m_pipelineStateCache.find(hash);
+		// Creates pipeline with state masked by getPipelineHash. Pipeline cache is
+		// owned by caller, so this can be called from worker threads as long as
+		// each thread uses its own cache.
+		VkPipeline createPipeline(VkPipelineCache _cache, uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData, FrameBufferHandle _fbh)
+		{
+			const ProgramVK& program = m_program[_program.idx];
 
-			if (VK_NULL_HANDLE != pipeline)
-			{
-				return pipeline;
-			}
+			const FrameBufferVK& frameBuffer = isValid(_fbh)
+				? m_frameBuffers[_fbh.idx]
+				: m_backBuffer
+				;
 
 			VkPipelineColorBlendAttachmentState blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
 			VkPipelineColorBlendStateCreateInfo colorBlendState;
 			colorBlendState.pAttachments = blendAttachmentState;
-			setBlendState(colorBlendState, _state);
+			setBlendState(colorBlendState, frameBuffer, _state);
 
 			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
 			inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -3639,7 +3860,24 @@ VK_IMPORT_DEVICE
 			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
 			graphicsPipeline.basePipelineIndex  = 0;
 
-			uint32_t length = g_callback->cacheReadSize(hash);
+			VkPipeline pipeline;
+			VK_CHECK(vkCreateGraphicsPipelines(
+				  m_device
+				, _cache
+				, 1
+				, &graphicsPipeline
+				, m_allocatorCb
+				, &pipeline
+				) );
+
+			return pipeline;
+		}
+
+		// Creates pipeline cache initialized with data from user cache. Callback
+		// is used, so it must be called on render thread.
+		VkPipelineCache beginPipelineCache(uint32_t _hash)
+		{
+			uint32_t length = g_callback->cacheReadSize(_hash);
 			bool cached = length > 0;
 
 			void* cachedData = NULL;
@@ -3654,7 +3892,7 @@ VK_IMPORT_DEVICE
 			if (cached)
 			{
 				cachedData = BX_ALLOC(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
+				if (g_callback->cacheRead(_hash, cachedData, length) )
 				{
 					BX_TRACE("Loading cached pipeline state (size %d).", length);
 					bx::MemoryReader reader(cachedData, length);
@@ -3667,54 +3905,54 @@ VK_IMPORT_DEVICE
 			VkPipelineCache cache;
 			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
 
-			VK_CHECK(vkCreateGraphicsPipelines(
-				  m_device
-				, cache
-				, 1
-				, &graphicsPipeline
-				, m_allocatorCb
-				, &pipeline
-				) );
-			m_pipelineStateCache.add(hash, pipeline);
+			if (NULL != cachedData)
+			{
+				BX_FREE(g_allocator, cachedData);
+			}
+
+			return cache;
+		}
 
+		// Writes pipeline cache back to user cache, merges it into renderer
+		// pipeline cache and destroys it. Must be called on render thread.
+		void endPipelineCache(uint32_t _hash, VkPipelineCache _cache)
+		{
 			size_t dataSize;
-			VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, NULL) );
+			VK_CHECK(vkGetPipelineCacheData(m_device, _cache, &dataSize, NULL) );
 
 			if (0 < dataSize)
 			{
-				if (length < dataSize)
-				{
-					cachedData = BX_REALLOC(g_allocator, cachedData, dataSize);
-				}
-
-				VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, cachedData) );
-				g_callback->cacheWrite(hash, cachedData, (uint32_t)dataSize);
+				void* cachedData = BX_ALLOC(g_allocator, dataSize);
+				VK_CHECK(vkGetPipelineCacheData(m_device, _cache, &dataSize, cachedData) );
+				g_callback->cacheWrite(_hash, cachedData, (uint32_t)dataSize);
+				BX_FREE(g_allocator, cachedData);
 			}
 
-			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &cache) );
-			vkDestroy(cache);
+			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &_cache) );
+			vkDestroy(_cache);
+		}
 
-			if (NULL != cachedData)
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		{
+			const uint32_t hash = getPipelineHash(_state, _stencil, _numStreams, _layouts, _program, _numInstanceData, m_fbh);
+
+			VkPipeline pipeline = m_pipelineStateCache.find(hash);
+
+			if (VK_NULL_HANDLE != pipeline)
 			{
-				BX_FREE(g_allocator, cachedData);
+				return pipeline;
 			}
 
+			VkPipelineCache cache = beginPipelineCache(hash);
+			pipeline = createPipeline(cache, _state, _stencil, _numStreams, _layouts, _program, _numInstanceData, m_fbh);
+			m_pipelineStateCache.add(hash, pipeline);
+			endPipelineCache(hash, cache);
+
 			return pipeline;
 		}
 
 		VkDescriptorSet getDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, const ScratchBufferVK& scratchBuffer, const float _palette[][4])
 		{
-			VkDescriptorSet descriptorSet;
-
-			VkDescriptorSetAllocateInfo dsai;
-			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			dsai.pNext              = NULL;
-			dsai.descriptorPool     = m_descriptorPool;
-			dsai.descriptorSetCount = 1;
-			dsai.pSetLayouts        = &program.m_descriptorSetLayout;
-
-			VK_CHECK(vkAllocateDescriptorSets(m_device, &dsai, &descriptorSet) );
-
 			VkDescriptorImageInfo  imageInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 			VkDescriptorBufferInfo bufferInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 
@@ -3741,7 +3979,6 @@ VK_IMPORT_DEVICE
 
 							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
 							wds[wdsCount].dstBinding       = bindInfo.binding;
 							wds[wdsCount].dstArrayElement  = 0;
 							wds[wdsCount].descriptorCount  = 1;
@@ -3791,7 +4028,6 @@ VK_IMPORT_DEVICE
 						{
 							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
 							wds[wdsCount].dstBinding       = bindInfo.binding;
 							wds[wdsCount].dstArrayElement  = 0;
 							wds[wdsCount].descriptorCount  = 1;
@@ -3847,7 +4083,6 @@ VK_IMPORT_DEVICE
 
 							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
 							wds[wdsCount].dstBinding       = bindInfo.binding;
 							wds[wdsCount].dstArrayElement  = 0;
 							wds[wdsCount].descriptorCount  = 1;
@@ -3859,7 +4094,6 @@ VK_IMPORT_DEVICE
 
 							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
 							wds[wdsCount].dstBinding       = bindInfo.samplerBinding;
 							wds[wdsCount].dstArrayElement  = 0;
 							wds[wdsCount].descriptorCount  = 1;
@@ -3887,7 +4121,6 @@ VK_IMPORT_DEVICE
 
 				wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				wds[wdsCount].pNext            = NULL;
-				wds[wdsCount].dstSet           = descriptorSet;
 				wds[wdsCount].dstBinding       = program.m_vsh->m_uniformBinding;
 				wds[wdsCount].dstArrayElement  = 0;
 				wds[wdsCount].descriptorCount  = 1;
@@ -3907,7 +4140,6 @@ VK_IMPORT_DEVICE
 
 				wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				wds[wdsCount].pNext            = NULL;
-				wds[wdsCount].dstSet           = descriptorSet;
 				wds[wdsCount].dstBinding       = program.m_fsh->m_uniformBinding;
 				wds[wdsCount].dstArrayElement  = 0;
 				wds[wdsCount].descriptorCount  = 1;
@@ -3919,14 +4151,80 @@ VK_IMPORT_DEVICE
 				++bufferCount;
 			}
 
-			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
+			// Descriptor sets are looked up by what is written into them, so the
+			// same layout and view/sampler/buffer combination is reused across
+			// draws and frames. Hash only selects the entry, cache compares
+			// the whole key.
+			uint64_t key[1 + kMaxDescriptorSets*4];
+			uint32_t keyNum = 0;
+			key[keyNum++] = uint64_t(program.m_descriptorSetLayout.vk);
+
+			for (uint32_t ii = 0; ii < wdsCount; ++ii)
+			{
+				const VkWriteDescriptorSet& write = wds[ii];
+				key[keyNum++] = (uint64_t(write.dstBinding)<<32) | uint32_t(write.descriptorType);
+
+				if (NULL != write.pImageInfo)
+				{
+					key[keyNum++] = uint64_t(write.pImageInfo->sampler);
+					key[keyNum++] = uint64_t(write.pImageInfo->imageView);
+					key[keyNum++] = uint64_t(write.pImageInfo->imageLayout);
+				}
+				else if (NULL != write.pBufferInfo)
+				{
+					key[keyNum++] = uint64_t(write.pBufferInfo->buffer);
+					key[keyNum++] = uint64_t(write.pBufferInfo->offset);
+					key[keyNum++] = uint64_t(write.pBufferInfo->range);
+				}
+			}
 
-			VkDescriptorSet temp = descriptorSet;
-			release(temp);
+			DescriptorSetCacheVK& cache = m_descriptorSetCache[m_cmd.m_currentFrameInFlight];
+			VkDescriptorSet descriptorSet = cache.find(key, keyNum);
+
+			if (VK_NULL_HANDLE != descriptorSet)
+			{
+				++m_descriptorSetHits;
+				return descriptorSet;
+			}
+
+			++m_descriptorSetMisses;
+			descriptorSet = cache.alloc(key, keyNum, program.m_descriptorSetLayout);
+
+			for (uint32_t ii = 0; ii < wdsCount; ++ii)
+			{
+				wds[ii].dstSet = descriptorSet;
+			}
+
+			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
 
 			return descriptorSet;
 		}
 
+		// GPU is done with scratch buffer of current frame in flight, it's
+		// recreated when it's too small for all render items of the frame.
+		void reserveScratchBuffer(ScratchBufferVK& _scratchBuffer, uint32_t _numRenderItems)
+		{
+			const uint32_t count = _numRenderItems + BGFX_CONFIG_MAX_VIEWS;
+
+			if (!_scratchBuffer.fits(kScratchEntrySize, count) )
+			{
+				BX_TRACE("Grow scratch buffer to %d entries.", count);
+
+				_scratchBuffer.destroy();
+				_scratchBuffer.create(kScratchEntrySize, bx::max<uint32_t>(count, _scratchBuffer.m_count*2) );
+
+				invalidateDescriptorSets();
+			}
+		}
+
+		void invalidateDescriptorSets()
+		{
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			{
+				m_descriptorSetCache[ii].invalidate();
+			}
+		}
+
 		bool isSwapChainReadable(const SwapChainVK& _swapChain)
 		{
 			return true
@@ -4329,6 +4627,69 @@ VK_IMPORT_DEVICE
 			return createHostBuffer(_size, flags, _buffer, _memory, _data);
 		}
 
+		// Small uploads are allocated from staging scratch buffer of current frame,
+		// whole buffer is reused once fence of the frame is signaled. Uploads that
+		// are too large or don't fit fall back to dedicated staging buffer.
+		VkResult allocStagingBuffer(uint32_t _size, uint32_t _align, StagingBufferVK& _staging, const void* _data = NULL)
+		{
+			ScratchBufferVK& scratchBuffer = m_scratchStagingBuffer[m_cmd.m_currentFrameInFlight];
+
+			// Large uploads would evict all small updates for rest of frame.
+			if (_size <= scratchBuffer.m_size/4)
+			{
+				const uint32_t offset = scratchBuffer.alloc(_size, _align);
+
+				if (UINT32_MAX != offset)
+				{
+					_staging.m_buffer    = scratchBuffer.m_buffer;
+					_staging.m_deviceMem = VK_NULL_HANDLE;
+					_staging.m_data      = scratchBuffer.m_data + offset;
+					_staging.m_offset    = offset;
+					_staging.m_size      = _size;
+
+					if (NULL != _data)
+					{
+						bx::memCopy(_staging.m_data, _data, _size);
+					}
+
+					return VK_SUCCESS;
+				}
+			}
+
+			_staging.m_offset = 0;
+			_staging.m_size   = _size;
+
+			VkResult result = createStagingBuffer(_size, &_staging.m_buffer, &_staging.m_deviceMem);
+
+			if (VK_SUCCESS != result)
+			{
+				return result;
+			}
+
+			result = vkMapMemory(m_device, _staging.m_deviceMem, 0, _size, 0, (void**)&_staging.m_data);
+
+			if (VK_SUCCESS == result
+			&&  NULL != _data)
+			{
+				bx::memCopy(_staging.m_data, _data, _size);
+			}
+
+			return result;
+		}
+
+		void release(StagingBufferVK& _staging)
+		{
+			if (VK_NULL_HANDLE != _staging.m_deviceMem)
+			{
+				vkUnmapMemory(m_device, _staging.m_deviceMem);
+				release(_staging.m_buffer);
+				release(_staging.m_deviceMem);
+			}
+
+			_staging.m_buffer = VK_NULL_HANDLE;
+			_staging.m_data   = NULL;
+		}
+
 		VkResult createReadbackBuffer(uint32_t _size, ::VkBuffer* _buffer, ::VkDeviceMemory* _memory)
 		{
 			const VkMemoryPropertyFlags flags = 0
@@ -4361,19 +4722,26 @@ VK_IMPORT_DEVICE
 		int64_t m_presentElapsed;
 
 		ScratchBufferVK m_scratchBuffer[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		ScratchBufferVK m_scratchStagingBuffer[BGFX_CONFIG_MAX_FRAME_LATENCY];
 
 		uint32_t        m_numFramesInFlight;
 		CommandQueueVK  m_cmd;
 		VkCommandBuffer m_commandBuffer;
 
+		DeviceMemoryAllocatorVK m_memoryAllocator;
+
 		VkDevice m_device;
 		uint32_t m_globalQueueFamily;
 		VkQueue  m_globalQueue;
-		VkDescriptorPool m_descriptorPool;
 		VkPipelineCache  m_pipelineCache;
 
+		DescriptorSetCacheVK m_descriptorSetCache[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		uint32_t m_descriptorSetHits;
+		uint32_t m_descriptorSetMisses;
+
 		TimerQueryVK m_gpuTimer;
 		OcclusionQueryVK m_occlusionQuery;
+		ReadBackQueueVK m_readBackQueue;
 
 		void* m_renderDocDll;
 		void* m_vulkan1Dll;
@@ -4391,11 +4759,13 @@ VK_IMPORT_DEVICE
 		UniformRegistry m_uniformReg;
 
 		StateCacheT<VkPipeline> m_pipelineStateCache;
+		ViewBatchPipeline m_viewBatchPipeline[BGFX_CONFIG_MAX_WORKER_THREADS+1][64];
+		uint32_t m_numViewBatchPipelines[BGFX_CONFIG_MAX_WORKER_THREADS+1];
 		StateCacheT<VkDescriptorSetLayout> m_descriptorSetLayoutCache;
 		StateCacheT<VkRenderPass> m_renderPassCache;
 		StateCacheT<VkSampler> m_samplerCache;
 		StateCacheT<uint32_t> m_samplerBorderColorCache;
-		StateCacheLru<VkImageView, 1024> m_imageViewCache;
+		StateCacheLru<VkImageView, kImageViewCacheSize> m_imageViewCache;
 
 		Resolution m_resolution;
 		float m_maxAnisotropy;
@@ -4457,57 +4827,370 @@ VK_DESTROY
 			vkFreeMemory(s_renderVK->m_device, _obj.vk, s_renderVK->m_allocatorCb);
 			_obj = VK_NULL_HANDLE;
 		}
-	}
+	}
+
+	void vkDestroy(VkSurfaceKHR& _obj)
+	{
+		if (VK_NULL_HANDLE != _obj)
+		{
+			vkDestroySurfaceKHR(s_renderVK->m_instance, _obj.vk, s_renderVK->m_allocatorCb);
+			_obj = VK_NULL_HANDLE;
+		}
+	}
+
+	void release(VkDeviceMemory& _obj)
+	{
+		s_renderVK->release(_obj);
+	}
+
+	void release(VkSurfaceKHR& _obj)
+	{
+		s_renderVK->release(_obj);
+	}
+
+	DeviceMemoryAllocatorVK::DeviceMemoryAllocatorVK()
+		: m_blockSize(0)
+	{
+		bx::memSet(m_pool,          0, sizeof(m_pool) );
+		bx::memSet(m_dedicatedSize, 0, sizeof(m_dedicatedSize) );
+		bx::memSet(m_numDedicated,  0, sizeof(m_numDedicated) );
+	}
+
+	DeviceMemoryAllocatorVK::~DeviceMemoryAllocatorVK()
+	{
+	}
+
+	void DeviceMemoryAllocatorVK::init(uint32_t _blockSize)
+	{
+		m_blockSize = _blockSize;
+	}
+
+	void DeviceMemoryAllocatorVK::shutdown()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_pool); ++ii)
+		{
+			Pool* pool = m_pool[ii];
+
+			if (NULL != pool)
+			{
+				BX_WARN(0 == pool->m_numAllocations
+					, "Device memory pool %d still has %d allocations."
+					, ii
+					, pool->m_numAllocations
+					);
+
+				for (uint32_t jj = 0, num = uint32_t(pool->m_block.size() ); jj < num; ++jj)
+				{
+					vkDestroy(pool->m_block[jj]);
+				}
+
+				BX_DELETE(g_allocator, pool);
+				m_pool[ii] = NULL;
+			}
+		}
+
+		for (uint32_t ii = 0; ii < VK_MAX_MEMORY_TYPES; ++ii)
+		{
+			BX_WARN(0 == m_numDedicated[ii]
+				, "Memory type %d still has %d dedicated allocations."
+				, ii
+				, m_numDedicated[ii]
+				);
+		}
+	}
+
+	VkResult DeviceMemoryAllocatorVK::alloc(DeviceMemoryAllocationVK& _alloc, const VkMemoryRequirements& _requirements, VkMemoryPropertyFlags _flags, bool _image)
+	{
+		// Large resources (mostly render target images) get dedicated allocation
+		// instead of taking space in blocks.
+		const bool dedicated = _requirements.size > m_blockSize/2;
+
+		VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		int32_t searchIndex = -1;
+		do
+		{
+			searchIndex++;
+			searchIndex = s_renderVK->selectMemoryType(_requirements.memoryTypeBits, _flags, searchIndex);
+
+			if (searchIndex >= 0)
+			{
+				result = dedicated
+					? allocDedicated(_alloc, _requirements, searchIndex)
+					: allocPool(_alloc, _requirements, searchIndex, _image)
+					;
+			}
+		}
+		while (result != VK_SUCCESS
+		   &&  searchIndex >= 0);
+
+		return result;
+	}
+
+	void DeviceMemoryAllocatorVK::free(DeviceMemoryAllocationVK& _alloc)
+	{
+		if (VK_NULL_HANDLE == _alloc.m_memory)
+		{
+			return;
+		}
+
+		if (NonLocalAllocator::kInvalidBlock == _alloc.m_block)
+		{
+			m_dedicatedSize[_alloc.m_pool] -= _alloc.m_size;
+			m_numDedicated[_alloc.m_pool]--;
+
+			vkDestroy(_alloc.m_memory);
+		}
+		else
+		{
+			Pool* pool = m_pool[_alloc.m_pool];
+			pool->m_allocator.free(_alloc.m_block);
+			pool->m_used -= _alloc.m_size;
+			pool->m_numAllocations--;
+
+			if (0 == pool->m_numAllocations
+			&&  1 < pool->m_block.size() )
+			{
+				// Pool is empty, keep only first block around.
+				for (uint32_t ii = 1, num = uint32_t(pool->m_block.size() ); ii < num; ++ii)
+				{
+					vkDestroy(pool->m_block[ii]);
+				}
+
+				pool->m_block.resize(1);
+				pool->m_data.resize(1);
+				pool->m_allocator.reset();
+				pool->m_allocator.add(0, m_blockSize);
+			}
+		}
+
+		_alloc = DeviceMemoryAllocationVK();
+	}
+
+	void DeviceMemoryAllocatorVK::getHeapStats(uint32_t _heap, HeapStats& _stats) const
+	{
+		bx::memSet(&_stats, 0, sizeof(_stats) );
+
+		const VkPhysicalDeviceMemoryProperties& memoryProperties = s_renderVK->m_memoryProperties;
+
+		for (uint32_t ii = 0; ii < memoryProperties.memoryTypeCount; ++ii)
+		{
+			if (_heap != memoryProperties.memoryTypes[ii].heapIndex)
+			{
+				continue;
+			}
+
+			for (uint32_t jj = 0; jj < 2; ++jj)
+			{
+				const Pool* pool = m_pool[ii*2 + jj];
+
+				if (NULL != pool)
+				{
+					NonLocalAllocator::Stats stats;
+					pool->m_allocator.getStats(stats);
+
+					_stats.reserved       += stats.totalSize;
+					_stats.used           += pool->m_used;
+					_stats.freeSize       += stats.freeSize;
+					_stats.largestFree     = bx::max<uint64_t>(_stats.largestFree, stats.largestFree);
+					_stats.numBlocks      += uint32_t(pool->m_block.size() );
+					_stats.numAllocations += pool->m_numAllocations;
+				}
+			}
+
+			_stats.reserved       += m_dedicatedSize[ii];
+			_stats.used           += m_dedicatedSize[ii];
+			_stats.numDedicated   += m_numDedicated[ii];
+			_stats.numAllocations += m_numDedicated[ii];
+		}
+	}
+
+	VkResult DeviceMemoryAllocatorVK::allocDedicated(DeviceMemoryAllocationVK& _alloc, const VkMemoryRequirements& _requirements, uint32_t _memoryType)
+	{
+		VkMemoryAllocateInfo ma;
+		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		ma.pNext = NULL;
+		ma.allocationSize  = _requirements.size;
+		ma.memoryTypeIndex = _memoryType;
+
+		VkResult result = vkAllocateMemory(s_renderVK->m_device, &ma, s_renderVK->m_allocatorCb, &_alloc.m_memory);
+
+		if (VK_SUCCESS == result)
+		{
+			_alloc.m_offset = 0;
+			_alloc.m_size   = _requirements.size;
+			_alloc.m_block  = NonLocalAllocator::kInvalidBlock;
+			_alloc.m_data   = NULL;
+			_alloc.m_pool   = uint16_t(_memoryType);
+
+			m_dedicatedSize[_memoryType] += _requirements.size;
+			m_numDedicated[_memoryType]++;
+		}
+
+		return result;
+	}
+
+	VkResult DeviceMemoryAllocatorVK::allocPool(DeviceMemoryAllocationVK& _alloc, const VkMemoryRequirements& _requirements, uint32_t _memoryType, bool _image)
+	{
+		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+		const VkMemoryPropertyFlags propertyFlags = s_renderVK->m_memoryProperties.memoryTypes[_memoryType].propertyFlags;
+
+		uint32_t align = uint32_t(_requirements.alignment);
+
+		if (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT == (propertyFlags & (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT|VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) ) )
+		{
+			// Flushed ranges of non-coherent memory must not overlap neighbour allocations.
+			align = bx::max(align, uint32_t(deviceLimits.nonCoherentAtomSize) );
+		}
+
+		align = bx::max(align, 1u);
+
+		// Vulkan alignments are power of two, pool allocator aligns offset
+		// inside of block and keeps skipped space free.
+		const uint32_t size = bx::strideAlign(uint32_t(_requirements.size), align);
+
+		// Buffers and images use separate pools, linear and optimal resources
+		// are never neighbours in the same block and bufferImageGranularity
+		// doesn't apply.
+		const uint32_t poolIdx = _memoryType*2 + (_image ? 1 : 0);
+
+		Pool* pool = m_pool[poolIdx];
+
+		if (NULL == pool)
+		{
+			pool = BX_NEW(g_allocator, Pool);
+			pool->m_used           = 0;
+			pool->m_numAllocations = 0;
+			m_pool[poolIdx] = pool;
+		}
+
+		uint64_t block = pool->m_allocator.alloc(size, align);
+
+		if (NonLocalAllocator::kInvalidBlock == block)
+		{
+			::VkDeviceMemory memory;
+			uint8_t* data;
+			VkResult result = allocBlock(_memoryType, &memory, &data);
+
+			if (VK_SUCCESS != result)
+			{
+				return result;
+			}
+
+			// Block index is stored in upper 32 bits, offset inside of block in lower.
+			const uint32_t idx = uint32_t(pool->m_block.size() );
+			pool->m_block.push_back(memory);
+			pool->m_data.push_back(data);
+			pool->m_allocator.add(uint64_t(idx)<<32, m_blockSize);
+
+			block = pool->m_allocator.alloc(size, align);
+			BX_ASSERT(NonLocalAllocator::kInvalidBlock != block, "Allocation of %d bytes doesn't fit into new block.", size);
+		}
+
+		const uint32_t idx    = uint32_t(block>>32);
+		const uint32_t offset = uint32_t(block);
+
+		_alloc.m_memory = pool->m_block[idx];
+		_alloc.m_offset = offset;
+		_alloc.m_size   = size;
+		_alloc.m_block  = block;
+		_alloc.m_data   = NULL != pool->m_data[idx] ? pool->m_data[idx] + offset : NULL;
+		_alloc.m_pool   = uint16_t(poolIdx);
+
+		pool->m_used += size;
+		pool->m_numAllocations++;
+
+		return VK_SUCCESS;
+	}
+
+	VkResult DeviceMemoryAllocatorVK::allocBlock(uint32_t _memoryType, ::VkDeviceMemory* _memory, uint8_t** _data)
+	{
+		const VkDevice device = s_renderVK->m_device;
+
+		VkMemoryAllocateInfo ma;
+		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		ma.pNext = NULL;
+		ma.allocationSize  = m_blockSize;
+		ma.memoryTypeIndex = _memoryType;
+
+		VkResult result = vkAllocateMemory(device, &ma, s_renderVK->m_allocatorCb, _memory);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Allocate device memory block error: vkAllocateMemory failed %d: %s.", result, getName(result) );
+			return result;
+		}
 
-	void vkDestroy(VkSurfaceKHR& _obj)
-	{
-		if (VK_NULL_HANDLE != _obj)
+		*_data = NULL;
+
+		// Host visible blocks stay mapped for their whole lifetime, memory can be
+		// mapped only once.
+		const VkMemoryPropertyFlags propertyFlags = s_renderVK->m_memoryProperties.memoryTypes[_memoryType].propertyFlags;
+		if (0 != (propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) )
 		{
-			vkDestroySurfaceKHR(s_renderVK->m_instance, _obj.vk, s_renderVK->m_allocatorCb);
-			_obj = VK_NULL_HANDLE;
+			result = vkMapMemory(device, *_memory, 0, VK_WHOLE_SIZE, 0, (void**)_data);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Allocate device memory block error: vkMapMemory failed %d: %s.", result, getName(result) );
+				vkFreeMemory(device, *_memory, s_renderVK->m_allocatorCb);
+				*_memory = VK_NULL_HANDLE;
+				return result;
+			}
 		}
+
+		return result;
 	}
 
-	void vkDestroy(VkDescriptorSet& _obj)
+	static uint32_t getScratchEntrySize(uint32_t _size)
 	{
-		if (VK_NULL_HANDLE != _obj)
-		{
-			vkFreeDescriptorSets(s_renderVK->m_device, s_renderVK->m_descriptorPool, 1, &_obj);
-			_obj = VK_NULL_HANDLE;
-		}
+		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
+		return bx::strideAlign(_size, align);
 	}
 
-	void release(VkDeviceMemory& _obj)
+	void ScratchBufferVK::create(uint32_t _size, uint32_t _count)
 	{
-		s_renderVK->release(_obj);
+		// Size is in 32-bit, number of entries is clamped so that it doesn't wrap.
+		const uint32_t entrySize = getScratchEntrySize(_size);
+		m_count = bx::min<uint32_t>(_count, UINT32_MAX/entrySize);
+
+		create(
+			  entrySize * m_count
+			, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
+			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+			);
 	}
 
-	void release(VkSurfaceKHR& _obj)
+	bool ScratchBufferVK::fits(uint32_t _size, uint32_t _count) const
 	{
-		s_renderVK->release(_obj);
+		return uint64_t(getScratchEntrySize(_size) ) * _count <= m_size
+			|| m_count == UINT32_MAX/getScratchEntrySize(_size)
+			;
 	}
 
-	void release(VkDescriptorSet& _obj)
+	void ScratchBufferVK::createStaging(uint32_t _size)
 	{
-		s_renderVK->release(_obj);
+		m_count = 0;
+
+		// Coherent memory, CPU writes are visible to transfer without flush.
+		create(
+			  _size
+			, VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			);
 	}
 
-	void ScratchBufferVK::create(uint32_t _size, uint32_t _count)
+	void ScratchBufferVK::create(uint32_t _size, VkBufferUsageFlags _usage, VkMemoryPropertyFlags _flags)
 	{
 		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
 		const VkDevice device = s_renderVK->m_device;
-		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
-
-		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
-		const uint32_t entrySize = bx::strideAlign(_size, align);
-		const uint32_t totalSize = entrySize * _count;
 
 		VkBufferCreateInfo bci;
 		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 		bci.pNext = NULL;
 		bci.flags = 0;
-		bci.size  = totalSize;
-		bci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		bci.size  = _size;
+		bci.usage = _usage;
 		bci.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
 		bci.queueFamilyIndexCount = 0;
 		bci.pQueueFamilyIndices   = NULL;
@@ -4526,28 +5209,40 @@ VK_DESTROY
 			, &mr
 			);
 
-		VkMemoryPropertyFlags flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-		VkResult result = s_renderVK->allocateMemory(&mr, flags, &m_deviceMem);
+		VkMemoryPropertyFlags flags = _flags;
+		VkResult result = s_renderVK->m_memoryAllocator.alloc(m_deviceMem, mr, flags, false);
 
-		if (VK_SUCCESS != result)
+		if (VK_SUCCESS != result
+		&&  (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) )
 		{
 			flags &= ~VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-			VK_CHECK(s_renderVK->allocateMemory(&mr, flags, &m_deviceMem) );
+			VK_CHECK(s_renderVK->m_memoryAllocator.alloc(m_deviceMem, mr, flags, false) );
 		}
 
 		m_size = (uint32_t)mr.size;
 		m_pos  = 0;
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem.m_memory, m_deviceMem.m_offset) );
 
-		VK_CHECK(vkMapMemory(device, m_deviceMem, 0, m_size, 0, (void**)&m_data) );
+		// Memory allocated from host visible pool is persistently mapped.
+		if (NULL != m_deviceMem.m_data)
+		{
+			m_data = m_deviceMem.m_data;
+		}
+		else
+		{
+			VK_CHECK(vkMapMemory(device, m_deviceMem.m_memory, 0, m_size, 0, (void**)&m_data) );
+		}
 	}
 
 	void ScratchBufferVK::destroy()
 	{
 		reset();
 
-		vkUnmapMemory(s_renderVK->m_device, m_deviceMem);
+		if (m_data != m_deviceMem.m_data)
+		{
+			vkUnmapMemory(s_renderVK->m_device, m_deviceMem.m_memory);
+		}
 
 		s_renderVK->release(m_buffer);
 		s_renderVK->release(m_deviceMem);
@@ -4578,23 +5273,196 @@ VK_DESTROY
 		return offset;
 	}
 
+	uint32_t ScratchBufferVK::alloc(uint32_t _size, uint32_t _align)
+	{
+		const uint32_t offset = bx::strideAlign(m_pos, _align);
+
+		if (offset + _size > m_size)
+		{
+			return UINT32_MAX;
+		}
+
+		m_pos = offset + _size;
+
+		return offset;
+	}
+
 	void ScratchBufferVK::flush()
 	{
 		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
 		VkDevice device = s_renderVK->m_device;
 
 		const uint32_t align = uint32_t(deviceLimits.nonCoherentAtomSize);
-		const uint32_t size  = bx::min(bx::strideAlign(m_pos, align), m_size);
+		const uint32_t size  = bx::min(bx::strideAlign(m_pos, align), uint32_t(m_deviceMem.m_size) );
 
 		VkMappedMemoryRange range;
 		range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
 		range.pNext  = NULL;
-		range.memory = m_deviceMem;
-		range.offset = 0;
+		range.memory = m_deviceMem.m_memory;
+		range.offset = m_deviceMem.m_offset;
 		range.size   = size;
 		VK_CHECK(vkFlushMappedMemoryRanges(device, 1, &range) );
 	}
 
+	VkResult DescriptorSetCacheVK::create(uint32_t _maxSets)
+	{
+		m_maxSets = _maxSets;
+		m_numSets = 0;
+		m_current = 0;
+		m_invalid = false;
+
+		VkDescriptorPool pool;
+		const VkResult result = createPool(pool);
+
+		if (VK_SUCCESS == result)
+		{
+			m_pool.push_back(pool);
+		}
+
+		return result;
+	}
+
+	VkResult DescriptorSetCacheVK::createPool(VkDescriptorPool& _pool) const
+	{
+		VkDescriptorPoolSize dps[] =
+		{
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          m_maxSets * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER,                m_maxSets * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, m_maxSets * 2                                },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         m_maxSets * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          m_maxSets * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+		};
+
+		// Sets are never freed one by one, only whole pool is reset.
+		VkDescriptorPoolCreateInfo dpci;
+		dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		dpci.pNext = NULL;
+		dpci.flags = 0;
+		dpci.maxSets       = m_maxSets;
+		dpci.poolSizeCount = BX_COUNTOF(dps);
+		dpci.pPoolSizes    = dps;
+
+		_pool = VK_NULL_HANDLE;
+		return vkCreateDescriptorPool(s_renderVK->m_device, &dpci, s_renderVK->m_allocatorCb, &_pool);
+	}
+
+	void DescriptorSetCacheVK::destroy()
+	{
+		m_hashMap.clear();
+		m_keys.clear();
+
+		for (uint32_t ii = 0, num = uint32_t(m_pool.size() ); ii < num; ++ii)
+		{
+			vkDestroy(m_pool[ii]);
+		}
+
+		m_pool.clear();
+
+		m_maxSets = 0;
+		m_numSets = 0;
+		m_current = 0;
+		m_invalid = false;
+	}
+
+	void DescriptorSetCacheVK::reset()
+	{
+		if (m_pool.empty() )
+		{
+			return;
+		}
+
+		// Keep using pool while less than half of it is used, so that cached
+		// sets can be found in later frames. Pools chained when first one ran
+		// out are reset too.
+		if (m_invalid
+		||  m_numSets > m_maxSets/2)
+		{
+			m_hashMap.clear();
+			m_keys.clear();
+
+			for (uint32_t ii = 0; ii <= m_current; ++ii)
+			{
+				VK_CHECK(vkResetDescriptorPool(s_renderVK->m_device, m_pool[ii], 0) );
+			}
+
+			m_numSets = 0;
+			m_current = 0;
+			m_invalid = false;
+		}
+	}
+
+	void DescriptorSetCacheVK::invalidate()
+	{
+		m_hashMap.clear();
+		m_keys.clear();
+		m_invalid = true;
+	}
+
+	VkDescriptorSet DescriptorSetCacheVK::find(const uint64_t* _key, uint32_t _num) const
+	{
+		const uint32_t hash = bx::hash<bx::HashMurmur2A>(_key, _num*sizeof(uint64_t) );
+
+		HashMap::const_iterator it = m_hashMap.find(hash);
+		if (it != m_hashMap.end()
+		&&  it->second.m_num == _num
+		&&  0 == bx::memCmp(&m_keys[it->second.m_offset], _key, _num*sizeof(uint64_t) ) )
+		{
+			return it->second.m_set;
+		}
+
+		return VK_NULL_HANDLE;
+	}
+
+	VkDescriptorSet DescriptorSetCacheVK::alloc(const uint64_t* _key, uint32_t _num, VkDescriptorSetLayout _layout)
+	{
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext = NULL;
+		dsai.descriptorPool     = m_pool[m_current];
+		dsai.descriptorSetCount = 1;
+		dsai.pSetLayouts        = &_layout;
+
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkResult result = vkAllocateDescriptorSets(s_renderVK->m_device, &dsai, &descriptorSet);
+
+		if (VK_ERROR_OUT_OF_POOL_MEMORY == result
+		||  VK_ERROR_FRAGMENTED_POOL    == result)
+		{
+			// Pool can't be reset while GPU might still use its sets, chain
+			// another one until next reset.
+			++m_current;
+
+			if (m_current == m_pool.size() )
+			{
+				VkDescriptorPool pool;
+				VK_CHECK(createPool(pool) );
+				m_pool.push_back(pool);
+			}
+
+			BX_TRACE("Descriptor pool is full, continuing in pool %d.", m_current);
+
+			dsai.descriptorPool = m_pool[m_current];
+			result = vkAllocateDescriptorSets(s_renderVK->m_device, &dsai, &descriptorSet);
+		}
+
+		VK_CHECK(result);
+
+		++m_numSets;
+
+		// Hash collision replaces previous entry, previous set stays valid
+		// until pool is reset.
+		const uint32_t hash = bx::hash<bx::HashMurmur2A>(_key, _num*sizeof(uint64_t) );
+
+		Entry entry;
+		entry.m_set    = descriptorSet;
+		entry.m_offset = uint32_t(m_keys.size() );
+		entry.m_num    = _num;
+		m_keys.insert(m_keys.end(), _key, _key + _num);
+		m_hashMap[hash] = entry;
+
+		return descriptorSet;
+	}
+
 	void BufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
 	{
 		BX_UNUSED(_stride);
@@ -4628,9 +5496,9 @@ VK_DESTROY
 		VkMemoryRequirements mr;
 		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_deviceMem) );
+		VK_CHECK(s_renderVK->m_memoryAllocator.alloc(m_deviceMem, mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false) );
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem.m_memory, m_deviceMem.m_offset) );
 
 		if (!m_dynamic)
 		{
@@ -4642,15 +5510,14 @@ VK_DESTROY
 	{
 		BX_UNUSED(_discard);
 
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingMem;
-		VK_CHECK(s_renderVK->createStagingBuffer(_size, &stagingBuffer, &stagingMem, _data) );
+		StagingBufferVK staging;
+		VK_CHECK(s_renderVK->allocStagingBuffer(_size, 4, staging, _data) );
 
 		VkBufferCopy region;
-		region.srcOffset = 0;
+		region.srcOffset = staging.m_offset;
 		region.dstOffset = _offset;
 		region.size      = _size;
-		vkCmdCopyBuffer(_commandBuffer, stagingBuffer, m_buffer, 1, &region);
+		vkCmdCopyBuffer(_commandBuffer, staging.m_buffer, m_buffer, 1, &region);
 
 		setMemoryBarrier(
 			  _commandBuffer
@@ -4658,14 +5525,18 @@ VK_DESTROY
 			, VK_PIPELINE_STAGE_TRANSFER_BIT
 			);
 
-		s_renderVK->release(stagingBuffer);
-		s_renderVK->release(stagingMem);
+		s_renderVK->release(staging);
 	}
 
 	void BufferVK::destroy()
 	{
 		if (VK_NULL_HANDLE != m_buffer)
 		{
+			if (0 != (m_flags & (BGFX_BUFFER_COMPUTE_READ_WRITE|BGFX_BUFFER_DRAW_INDIRECT) ) )
+			{
+				s_renderVK->invalidateDescriptorSets();
+			}
+
 			s_renderVK->release(m_buffer);
 			s_renderVK->release(m_deviceMem);
 
@@ -5591,6 +6462,119 @@ VK_DESTROY
 			);
 	}
 
+	void ReadBackQueueVK::init()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_readBack); ++ii)
+		{
+			ReadBack& readBack = m_readBack[ii];
+			readBack.m_buffer   = VK_NULL_HANDLE;
+			readBack.m_memory   = VK_NULL_HANDLE;
+			readBack.m_capacity = 0;
+		}
+	}
+
+	void ReadBackQueueVK::shutdown()
+	{
+		// Device is idle before shutdown, remaining read backs are delivered
+		// right away.
+		while (0 != m_control.available() )
+		{
+			const ReadBack& readBack = m_readBack[m_control.m_read];
+			readBack.m_readback.readback(readBack.m_memory, 0, readBack.m_data, readBack.m_mip);
+			m_control.consume(1);
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_readBack); ++ii)
+		{
+			ReadBack& readBack = m_readBack[ii];
+			vkDestroy(readBack.m_buffer);
+			vkDestroy(readBack.m_memory);
+			readBack.m_capacity = 0;
+		}
+	}
+
+	void ReadBackQueueVK::read(const TextureVK& _texture, void* _data, uint8_t _mip)
+	{
+		while (0 == m_control.reserve(1) )
+		{
+			update(true);
+		}
+
+		ReadBack& readBack = m_readBack[m_control.m_current];
+
+		const uint32_t height = bx::uint32_max(1, _texture.m_height >> _mip);
+		const uint32_t size   = height * _texture.m_readback.pitch(_mip);
+
+		// When slot is reused previous copy is complete, buffer can be destroyed
+		// right away.
+		if (readBack.m_capacity < size)
+		{
+			vkDestroy(readBack.m_buffer);
+			vkDestroy(readBack.m_memory);
+			VK_CHECK(s_renderVK->createReadbackBuffer(size, &readBack.m_buffer, &readBack.m_memory) );
+			readBack.m_capacity = size;
+		}
+
+		_texture.m_readback.copyImageToBuffer(
+			  s_renderVK->m_commandBuffer
+			, readBack.m_buffer
+			, _texture.m_currentImageLayout
+			, _texture.m_aspectMask
+			, _mip
+			);
+
+		const CommandQueueVK& cmd = s_renderVK->m_cmd;
+
+		// Same as TimerQueryVK, after m_numFramesInFlight submits fence of this
+		// frame was already waited on.
+		readBack.m_frameInFlight = cmd.m_currentFrameInFlight;
+		readBack.m_completed     = cmd.m_submitted + cmd.m_numFramesInFlight;
+		readBack.m_readback      = _texture.m_readback;
+		readBack.m_data          = _data;
+		readBack.m_mip           = _mip;
+
+		m_control.commit(1);
+	}
+
+	void ReadBackQueueVK::update(bool _waitOldest)
+	{
+		CommandQueueVK& cmd = s_renderVK->m_cmd;
+
+		while (0 != m_control.available() )
+		{
+			const ReadBack& readBack = m_readBack[m_control.m_read];
+
+			if (readBack.m_completed > cmd.m_submitted)
+			{
+				if (!_waitOldest)
+				{
+					break;
+				}
+
+				// Ring is full, wait only on fence of frame with oldest read back,
+				// without draining whole queue.
+				if (readBack.m_completed - cmd.m_numFramesInFlight == cmd.m_submitted)
+				{
+					s_renderVK->kick();
+				}
+
+				if (readBack.m_completed > cmd.m_submitted)
+				{
+					CommandQueueVK::CommandList& commandList = cmd.m_commandList[readBack.m_frameInFlight];
+					VK_CHECK(vkWaitForFences(s_renderVK->m_device, 1, &commandList.m_fence, VK_TRUE, UINT64_MAX) );
+				}
+			}
+
+			readBack.m_readback.readback(readBack.m_memory, 0, readBack.m_data, readBack.m_mip);
+			m_control.consume(1);
+
+			if (_waitOldest)
+			{
+				break;
+			}
+		}
+	}
+
 	void ReadbackVK::readback(VkDeviceMemory _memory, VkDeviceSize _offset, void* _data, uint8_t _mip) const
 	{
 		if (m_image == VK_NULL_HANDLE)
@@ -5716,14 +6700,14 @@ VK_DESTROY
 		VkMemoryRequirements imageMemReq;
 		vkGetImageMemoryRequirements(device, m_textureImage, &imageMemReq);
 
-		result = s_renderVK->allocateMemory(&imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_textureDeviceMem);
+		result = s_renderVK->m_memoryAllocator.alloc(m_textureDeviceMem, imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
 		if (VK_SUCCESS != result)
 		{
 			BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
 			return result;
 		}
 
-		result = vkBindImageMemory(device, m_textureImage, m_textureDeviceMem, 0);
+		result = vkBindImageMemory(device, m_textureImage, m_textureDeviceMem.m_memory, m_textureDeviceMem.m_offset);
 		if (VK_SUCCESS != result)
 		{
 			BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
@@ -5759,14 +6743,14 @@ VK_DESTROY
 			VkMemoryRequirements imageMemReq_resolve;
 			vkGetImageMemoryRequirements(device, m_singleMsaaImage, &imageMemReq_resolve);
 
-			result = s_renderVK->allocateMemory(&imageMemReq_resolve, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_singleMsaaDeviceMem);
+			result = s_renderVK->m_memoryAllocator.alloc(m_singleMsaaDeviceMem, imageMemReq_resolve, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
 			if (VK_SUCCESS != result)
 			{
 				BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
 				return result;
 			}
 
-			result = vkBindImageMemory(device, m_singleMsaaImage, m_singleMsaaDeviceMem, 0);
+			result = vkBindImageMemory(device, m_singleMsaaImage, m_singleMsaaDeviceMem.m_memory, m_singleMsaaDeviceMem.m_offset);
 			if (VK_SUCCESS != result)
 			{
 				BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
@@ -5816,7 +6800,6 @@ VK_DESTROY
 			m_components = s_textureFormat[m_textureFormat].m_mapping;
 
 			const bool convert = m_textureFormat != m_requestedFormat;
-			const uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
 
 			m_aspectMask = getAspectMask(m_format);
 			m_sampler = s_msaa[bx::uint32_satsub( (m_flags & BGFX_TEXTURE_RT_MSAA_MASK) >> BGFX_TEXTURE_RT_MSAA_SHIFT, 1)];
@@ -5893,6 +6876,24 @@ VK_DESTROY
 			bx::memSet(imageInfos, 0, sizeof(ImageInfo) * numSrd);
 			uint32_t alignment = 1; // tightly aligned buffer
 
+			// Software decode of all sides and mips is spread across job pool.
+			ImageDecodeMip* decoded = NULL;
+			uint8_t* decodedData = NULL;
+			if (convert
+			&&  NULL != imageContainer.m_data)
+			{
+				decoded = (ImageDecodeMip*)BX_ALLOC(g_allocator, sizeof(ImageDecodeMip) * numSrd);
+				decodedData = imageDecodeParallel(
+					  decoded
+					, imageContainer
+					, _mem
+					, numSides
+					, startLod
+					, ti.numMips
+					, bimg::TextureFormat::BGRA8
+					);
+			}
+
 			for (uint8_t side = 0; side < numSides; ++side)
 			{
 				for (uint8_t lod = 0; lod < ti.numMips; ++lod)
@@ -5903,28 +6904,17 @@ VK_DESTROY
 					{
 						if (convert)
 						{
-							const uint32_t pitch = bx::strideAlign(bx::max<uint32_t>(mip.m_width, 4) * bpp / 8, alignment);
-							const uint32_t slice = bx::strideAlign(bx::max<uint32_t>(mip.m_height, 4) * pitch, alignment);
-							const uint32_t size  = slice * mip.m_depth;
-
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageDecodeToBgra8(
-								  g_allocator
-								, temp
-								, mip.m_data
-								, mip.m_width
-								, mip.m_height
-								, pitch
-								, mip.m_format
-								);
-
-							imageInfos[kk].data     = temp;
-							imageInfos[kk].width    = mip.m_width;
-							imageInfos[kk].height   = mip.m_height;
-							imageInfos[kk].depth    = mip.m_depth;
-							imageInfos[kk].pitch    = pitch;
-							imageInfos[kk].slice    = slice;
-							imageInfos[kk].size     = size;
+							// kk counts only mips present in image, decoded is
+							// indexed by side and mip.
+							const ImageDecodeMip& dm = decoded[side*ti.numMips + lod];
+
+							imageInfos[kk].data     = dm.data;
+							imageInfos[kk].width    = dm.width;
+							imageInfos[kk].height   = dm.height;
+							imageInfos[kk].depth    = dm.depth;
+							imageInfos[kk].pitch    = dm.pitch;
+							imageInfos[kk].slice    = dm.pitch * dm.height;
+							imageInfos[kk].size     = dm.size;
 							imageInfos[kk].mipLevel = lod;
 							imageInfos[kk].layer    = side;
 						}
@@ -6006,35 +6996,22 @@ VK_DESTROY
 
 			if (totalMemSize > 0)
 			{
-				const VkDevice device = s_renderVK->m_device;
-
-				VkBuffer stagingBuffer;
-				VkDeviceMemory stagingDeviceMem;
-				VK_CHECK(s_renderVK->createStagingBuffer(totalMemSize, &stagingBuffer, &stagingDeviceMem) );
-
-				uint8_t* mappedMemory;
-				VK_CHECK(vkMapMemory(
-					  device
-					, stagingDeviceMem
-					, 0
-					, totalMemSize
-					, 0
-					, (void**)&mappedMemory
-					) );
+				StagingBufferVK staging;
+				VK_CHECK(s_renderVK->allocStagingBuffer(totalMemSize, getStagingAlign(), staging) );
 
 				// copy image to staging buffer
+				uint8_t* mappedMemory = staging.m_data;
 				for (uint32_t ii = 0; ii < numSrd; ++ii)
 				{
 					bx::memCopy(mappedMemory, imageInfos[ii].data, imageInfos[ii].size);
 					mappedMemory += imageInfos[ii].size;
-				}
 
-				vkUnmapMemory(device, stagingDeviceMem);
+					bufferCopyInfo[ii].bufferOffset += staging.m_offset;
+				}
 
-				copyBufferToTexture(_commandBuffer, stagingBuffer, numSrd, bufferCopyInfo);
+				copyBufferToTexture(_commandBuffer, staging.m_buffer, numSrd, bufferCopyInfo);
 
-				s_renderVK->release(stagingBuffer);
-				s_renderVK->release(stagingDeviceMem);
+				s_renderVK->release(staging);
 			}
 			else
 			{
@@ -6043,9 +7020,17 @@ VK_DESTROY
 
 			BX_FREE(g_allocator, bufferCopyInfo);
 
-			for (uint32_t ii = 0; ii < numSrd; ++ii)
+			if (NULL != decoded)
+			{
+				BX_FREE(g_allocator, decodedData);
+				BX_FREE(g_allocator, decoded);
+			}
+			else
 			{
-				BX_FREE(g_allocator, imageInfos[ii].data);
+				for (uint32_t ii = 0; ii < numSrd; ++ii)
+				{
+					BX_FREE(g_allocator, imageInfos[ii].data);
+				}
 			}
 
 			BX_FREE(g_allocator, imageInfos);
@@ -6076,6 +7061,15 @@ VK_DESTROY
 		m_currentSingleMsaaImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	}
 
+	uint32_t TextureVK::getStagingAlign() const
+	{
+		// bufferOffset of buffer to image copy must be multiple of 4 and of texel block size.
+		const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(m_textureFormat) );
+		const uint32_t blockSize = blockInfo.blockSize;
+
+		return 0 == (blockSize & 3) ? blockSize : blockSize*4;
+	}
+
 	void TextureVK::update(VkCommandBuffer _commandBuffer, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem)
 	{
 		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
@@ -6101,12 +7095,11 @@ VK_DESTROY
 			data = temp;
 		}
 
-		VkBuffer stagingBuffer = VK_NULL_HANDLE;
-		VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
-		VK_CHECK(s_renderVK->createStagingBuffer(size, &stagingBuffer, &stagingDeviceMem, data) );
+		StagingBufferVK staging;
+		VK_CHECK(s_renderVK->allocStagingBuffer(size, getStagingAlign(), staging, data) );
 
 		VkBufferImageCopy region;
-		region.bufferOffset      = 0;
+		region.bufferOffset      = staging.m_offset;
 		region.bufferRowLength   = (_pitch == UINT16_MAX ? 0 : _pitch * 8 / bpp);
 		region.bufferImageHeight = 0;
 		region.imageSubresource.aspectMask     = m_aspectMask;
@@ -6116,10 +7109,9 @@ VK_DESTROY
 		region.imageOffset = { _rect.m_x, _rect.m_y, _z };
 		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
 
-		copyBufferToTexture(_commandBuffer, stagingBuffer, 1, &region);
+		copyBufferToTexture(_commandBuffer, staging.m_buffer, 1, &region);
 
-		s_renderVK->release(stagingBuffer);
-		s_renderVK->release(stagingDeviceMem);
+		s_renderVK->release(staging);
 
 		if (NULL != temp)
 		{
@@ -7730,6 +8722,10 @@ VK_DESTROY
 				return result;
 			}
 
+			// GPU is done with this frame, staging uploads recorded into it can be overwritten.
+			s_renderVK->m_scratchStagingBuffer[m_currentFrameInFlight].reset();
+			s_renderVK->m_descriptorSetCache[m_currentFrameInFlight].reset();
+
 			VkCommandBufferBeginInfo cbi;
 			cbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 			cbi.pNext = NULL;
@@ -7845,6 +8841,11 @@ VK_DESTROY
 		m_release[m_currentFrameInFlight].push_back(resource);
 	}
 
+	void CommandQueueVK::release(const DeviceMemoryAllocationVK& _alloc)
+	{
+		m_releaseAlloc[m_currentFrameInFlight].push_back(_alloc);
+	}
+
 	void CommandQueueVK::consume()
 	{
 		m_consumeIndex = (m_consumeIndex + 1) % m_numFramesInFlight;
@@ -7859,7 +8860,6 @@ VK_DESTROY
 			case VK_OBJECT_TYPE_FRAMEBUFFER:           destroy<VkFramebuffer        >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_PIPELINE_LAYOUT:       destroy<VkPipelineLayout     >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_PIPELINE:              destroy<VkPipeline           >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_DESCRIPTOR_SET:        destroy<VkDescriptorSet      >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: destroy<VkDescriptorSetLayout>(resource.m_handle); break;
 			case VK_OBJECT_TYPE_RENDER_PASS:           destroy<VkRenderPass         >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_SAMPLER:               destroy<VkSampler            >(resource.m_handle); break;
@@ -7874,6 +8874,13 @@ VK_DESTROY
 		}
 
 		m_release[m_consumeIndex].clear();
+
+		for (DeviceMemoryAllocationVK& alloc : m_releaseAlloc[m_consumeIndex])
+		{
+			s_renderVK->m_memoryAllocator.free(alloc);
+		}
+
+		m_releaseAlloc[m_consumeIndex].clear();
 	}
 
 	void RendererContextVK::submitBlit(BlitState& _bs, uint16_t _view)
@@ -8023,15 +9030,21 @@ VK_DESTROY
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(m_commandBuffer, 0, _render->m_iboffset, ib->data);
+
+			_render->updateTransientIndexBuffers([&](const TransientIndexBuffer& _page, uint32_t _size)
+			{
+				m_indexBuffers[_page.handle.idx].update(m_commandBuffer, 0, _size, _page.data);
+			});
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->m_vboffset, vb->data);
+
+			_render->updateTransientVertexBuffers([&](const TransientVertexBuffer& _page, uint32_t _size)
+			{
+				m_vertexBuffers[_page.handle.idx].update(m_commandBuffer, 0, _size, _page.data);
+			});
 		}
 
 		_render->sort();
@@ -8053,6 +9066,8 @@ VK_DESTROY
 		VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
 		uint32_t currentBindHash = 0;
 		uint32_t descriptorSetCount = 0;
+		m_descriptorSetHits   = 0;
+		m_descriptorSetMisses = 0;
 		VkIndexType currentIndexFormat = VK_INDEX_TYPE_MAX_ENUM;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
@@ -8082,6 +9097,7 @@ VK_DESTROY
 		const uint64_t f3 = BGFX_STATE_BLEND_INV_FACTOR<<4;
 
 		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_cmd.m_currentFrameInFlight];
+		reserveScratchBuffer(scratchBuffer, _render->m_numRenderItems);
 		scratchBuffer.reset();
 
 		setMemoryBarrier(
@@ -8111,6 +9127,8 @@ VK_DESTROY
 		{
 			viewState.m_rect = _render->m_view[0].m_rect;
 
+			createViewBatchPipelines(_render);
+
 			int32_t numItems = _render->m_numRenderItems;
 			for (int32_t item = 0; item < numItems;)
 			{
@@ -8834,6 +9852,24 @@ VK_DESTROY
 				}
 			}
 		}
+		else
+		{
+			// Without budget extension report what renderer itself allocated.
+			gpuMemoryAvailable = 0;
+			gpuMemoryUsed      = 0;
+
+			for (uint32_t ii = 0; ii < m_memoryProperties.memoryHeapCount; ++ii)
+			{
+				if (!!(m_memoryProperties.memoryHeaps[ii].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) )
+				{
+					DeviceMemoryAllocatorVK::HeapStats heapStats;
+					m_memoryAllocator.getHeapStats(ii, heapStats);
+
+					gpuMemoryAvailable += m_memoryProperties.memoryHeaps[ii].size;
+					gpuMemoryUsed      += heapStats.reserved;
+				}
+			}
+		}
 
 		Stats& perfStats = _render->m_perfStats;
 		perfStats.cpuTimeBegin  = timeBegin;
@@ -8850,6 +9886,8 @@ VK_DESTROY
 		bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
 		perfStats.gpuMemoryMax  = gpuMemoryAvailable;
 		perfStats.gpuMemoryUsed = gpuMemoryUsed;
+		perfStats.descriptorSetHits   = m_descriptorSetHits;
+		perfStats.descriptorSetMisses = m_descriptorSetMisses;
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
@@ -8906,6 +9944,38 @@ VK_DESTROY
 					}
 				}
 
+				for (uint32_t ii = 0; ii < m_memoryProperties.memoryHeapCount; ++ii)
+				{
+					DeviceMemoryAllocatorVK::HeapStats heapStats;
+					m_memoryAllocator.getHeapStats(ii, heapStats);
+
+					if (0 == heapStats.numAllocations)
+					{
+						continue;
+					}
+
+					char reserved[16];
+					bx::prettify(reserved, BX_COUNTOF(reserved), heapStats.reserved);
+
+					char used[16];
+					bx::prettify(used, BX_COUNTOF(used), heapStats.used);
+
+					// Fragmentation, how much of free space in blocks is not in largest free range.
+					const uint32_t fragmentation = 0 < heapStats.freeSize
+						? uint32_t(100 - heapStats.largestFree*100/heapStats.freeSize)
+						: 0
+						;
+
+					tvm.printf(0, pos++, 0x8f, " Heap %d - Reserved: %12s, Used: %12s, Blocks: %3d, Dedicated: %4d, Frag: %3d%%"
+						, ii
+						, reserved
+						, used
+						, heapStats.numBlocks
+						, heapStats.numDedicated
+						, fragmentation
+						);
+				}
+
 				pos = 10;
 				tvm.printf(10, pos++, 0x8b, "       Frame: % 7.3f, % 7.3f \x1f, % 7.3f \x1e [ms] / % 6.2f FPS "
 					, double(frameTime)*toMs
@@ -8966,6 +10036,10 @@ VK_DESTROY
 					, m_descriptorSetLayoutCache.getCount()
 					, descriptorSetCount
 					);
+				tvm.printf(10, pos++, 0x8b, " DS hit: %6d, miss: %6d "
+					, m_descriptorSetHits
+					, m_descriptorSetMisses
+					);
 				pos++;
 
 				double captureMs = double(captureElapsed)*toMs;
@@ -9022,6 +10096,8 @@ VK_DESTROY
 		}
 
 		kick();
+
+		m_readBackQueue.update();
 	}
 
 } /* namespace vk */ } // namespace bgfx
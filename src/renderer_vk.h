@@ -353,6 +353,77 @@ VK_DESTROY_FUNC(DescriptorSet);
 		HashMap m_hashMap;
 	};
 
+	struct DeviceMemoryAllocationVK
+	{
+		DeviceMemoryAllocationVK()
+			: m_memory(VK_NULL_HANDLE)
+			, m_offset(0)
+			, m_size(0)
+			, m_block(NonLocalAllocator::kInvalidBlock)
+			, m_data(NULL)
+			, m_pool(UINT16_MAX)
+		{
+		}
+
+		VkDeviceMemory m_memory;
+		VkDeviceSize   m_offset;
+		VkDeviceSize   m_size;
+		uint64_t       m_block; // Block returned by pool allocator, kInvalidBlock for dedicated allocation.
+		uint8_t*       m_data;  // Persistently mapped pointer at m_offset, NULL if memory is not host visible.
+		uint16_t       m_pool;  // Pool index, or memory type for dedicated allocation.
+	};
+
+	// Pools per memory type sub-allocate from large VkDeviceMemory blocks, instead
+	// of vkAllocateMemory per resource (maxMemoryAllocationCount can be as low as
+	// 4096). Buffers and optimal images use separate pools, so that
+	// bufferImageGranularity doesn't apply.
+	class DeviceMemoryAllocatorVK
+	{
+	public:
+		struct HeapStats
+		{
+			uint64_t reserved;      // Size of all blocks and dedicated allocations.
+			uint64_t used;          // Size of all live allocations.
+			uint64_t freeSize;      // Size of free space in blocks.
+			uint64_t largestFree;   // Largest free range in any block.
+			uint32_t numBlocks;
+			uint32_t numDedicated;
+			uint32_t numAllocations;
+		};
+
+		DeviceMemoryAllocatorVK();
+		~DeviceMemoryAllocatorVK();
+
+		void init(uint32_t _blockSize);
+		void shutdown();
+
+		VkResult alloc(DeviceMemoryAllocationVK& _alloc, const VkMemoryRequirements& _requirements, VkMemoryPropertyFlags _flags, bool _image);
+		void free(DeviceMemoryAllocationVK& _alloc);
+
+		void getHeapStats(uint32_t _heap, HeapStats& _stats) const;
+
+	private:
+		VkResult allocDedicated(DeviceMemoryAllocationVK& _alloc, const VkMemoryRequirements& _requirements, uint32_t _memoryType);
+		VkResult allocPool(DeviceMemoryAllocationVK& _alloc, const VkMemoryRequirements& _requirements, uint32_t _memoryType, bool _image);
+		VkResult allocBlock(uint32_t _memoryType, ::VkDeviceMemory* _memory, uint8_t** _data);
+
+		struct Pool
+		{
+			NonLocalAllocator m_allocator;
+			stl::vector<VkDeviceMemory> m_block;
+			stl::vector<uint8_t*> m_data;
+			uint64_t m_used;
+			uint32_t m_numAllocations;
+		};
+
+		Pool* m_pool[VK_MAX_MEMORY_TYPES*2];
+
+		uint64_t m_dedicatedSize[VK_MAX_MEMORY_TYPES];
+		uint32_t m_numDedicated[VK_MAX_MEMORY_TYPES];
+
+		uint32_t m_blockSize;
+	};
+
 	class ScratchBufferVK
 	{
 	public:
@@ -365,23 +436,101 @@ VK_DESTROY_FUNC(DescriptorSet);
 		}
 
 		void create(uint32_t _size, uint32_t _count);
+		void createStaging(uint32_t _size);
 		void destroy();
 		void reset();
 		uint32_t write(const void* _data, uint32_t _size);
+		uint32_t alloc(uint32_t _size, uint32_t _align);
 		void flush();
 
+		// Returns true if _count entries of _size bytes fit into buffer.
+		bool fits(uint32_t _size, uint32_t _count) const;
+
 		VkBuffer m_buffer;
-		VkDeviceMemory m_deviceMem;
+		DeviceMemoryAllocationVK m_deviceMem;
 		uint8_t* m_data;
 		uint32_t m_size;
 		uint32_t m_pos;
+		uint32_t m_count;
+
+	private:
+		void create(uint32_t _size, VkBufferUsageFlags _usage, VkMemoryPropertyFlags _flags);
+	};
+
+	// Descriptor pools of one frame in flight. Descriptor sets are reused by
+	// what is written into them. Sets are not freed with vkFreeDescriptorSets,
+	// pools are reset as whole once GPU is done with the frame.
+	class DescriptorSetCacheVK
+	{
+	public:
+		DescriptorSetCacheVK()
+			: m_maxSets(0)
+			, m_numSets(0)
+			, m_current(0)
+			, m_invalid(false)
+		{
+		}
+
+		VkResult create(uint32_t _maxSets);
+		void destroy();
+
+		// Called once GPU is done with sets from this cache. Pools are reset
+		// when more than half is used, or when cache was invalidated.
+		void reset();
+
+		// Destroyed image view, sampler or buffer handle can be reused, cached
+		// sets are not found anymore, pools are reset on next reset.
+		void invalidate();
+
+		// Returns set written with the same key, _key is _num words of layout
+		// and descriptor writes.
+		VkDescriptorSet find(const uint64_t* _key, uint32_t _num) const;
+
+		// Allocates set from current pool, another pool is chained when it's
+		// out of memory.
+		VkDescriptorSet alloc(const uint64_t* _key, uint32_t _num, VkDescriptorSetLayout _layout);
+
+		uint32_t getCount() const
+		{
+			return uint32_t(m_hashMap.size() );
+		}
+
+	private:
+		VkResult createPool(VkDescriptorPool& _pool) const;
+
+		struct Entry
+		{
+			VkDescriptorSet m_set;
+			uint32_t m_offset;
+			uint32_t m_num;
+		};
+
+		typedef stl::unordered_map<uint32_t, Entry> HashMap;
+		HashMap m_hashMap;
+		stl::vector<uint64_t> m_keys;
+
+		stl::vector<VkDescriptorPool> m_pool;
+		uint32_t m_maxSets;
+		uint32_t m_numSets;
+		uint32_t m_current;
+		bool m_invalid;
+	};
+
+	// Upload source, either range of per frame staging scratch buffer, or
+	// dedicated buffer when upload doesn't fit into it.
+	struct StagingBufferVK
+	{
+		VkBuffer       m_buffer;
+		VkDeviceMemory m_deviceMem; // VK_NULL_HANDLE when allocated from staging scratch buffer.
+		uint8_t*       m_data;
+		uint32_t       m_offset;
+		uint32_t       m_size;
 	};
 
 	struct BufferVK
 	{
 		BufferVK()
 			: m_buffer(VK_NULL_HANDLE)
-			, m_deviceMem(VK_NULL_HANDLE)
 			, m_size(0)
 			, m_flags(BGFX_BUFFER_NONE)
 			, m_dynamic(false)
@@ -393,7 +542,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 		void destroy();
 
 		VkBuffer m_buffer;
-		VkDeviceMemory m_deviceMem;
+		DeviceMemoryAllocationVK m_deviceMem;
 		uint32_t m_size;
 		uint16_t m_flags;
 		bool m_dynamic;
@@ -603,10 +752,8 @@ VK_DESTROY_FUNC(DescriptorSet);
 			, m_sampler({ 1, VK_SAMPLE_COUNT_1_BIT })
 			, m_format(VK_FORMAT_UNDEFINED)
 			, m_textureImage(VK_NULL_HANDLE)
-			, m_textureDeviceMem(VK_NULL_HANDLE)
 			, m_currentImageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
 			, m_singleMsaaImage(VK_NULL_HANDLE)
-			, m_singleMsaaDeviceMem(VK_NULL_HANDLE)
 			, m_currentSingleMsaaImageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
 		{
 		}
@@ -643,13 +790,13 @@ VK_DESTROY_FUNC(DescriptorSet);
 		VkComponentMapping m_components;
 		VkImageAspectFlags m_aspectMask;
 
-		VkImage        m_textureImage;
-		VkDeviceMemory m_textureDeviceMem;
-		VkImageLayout  m_currentImageLayout;
+		VkImage                  m_textureImage;
+		DeviceMemoryAllocationVK m_textureDeviceMem;
+		VkImageLayout            m_currentImageLayout;
 
-		VkImage        m_singleMsaaImage;
-		VkDeviceMemory m_singleMsaaDeviceMem;
-		VkImageLayout  m_currentSingleMsaaImageLayout;
+		VkImage                  m_singleMsaaImage;
+		DeviceMemoryAllocationVK m_singleMsaaDeviceMem;
+		VkImageLayout            m_currentSingleMsaaImageLayout;
 
 		VkImageLayout m_sampledLayout;
 
@@ -657,6 +804,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 
 	private:
 		VkResult createImages(VkCommandBuffer _commandBuffer);
+		uint32_t getStagingAlign() const;
 		static VkImageAspectFlags getAspectMask(VkFormat _format);
 	};
 
@@ -789,6 +937,34 @@ VK_DESTROY_FUNC(DescriptorSet);
 		VkFramebuffer m_currentFramebuffer;
 	};
 
+	struct ReadBackQueueVK
+	{
+		ReadBackQueueVK()
+			: m_control(BX_COUNTOF(m_readBack) )
+		{
+		}
+
+		void init();
+		void shutdown();
+		void read(const TextureVK& _texture, void* _data, uint8_t _mip);
+		void update(bool _waitOldest = false);
+
+		struct ReadBack
+		{
+			VkBuffer m_buffer;
+			VkDeviceMemory m_memory;
+			uint32_t m_capacity;
+			uint32_t m_frameInFlight;
+			uint64_t m_completed;
+			ReadbackVK m_readback;
+			void* m_data;
+			uint8_t m_mip;
+		};
+
+		ReadBack m_readBack[BGFX_CONFIG_MAX_TEXTURE_READ_BACKS];
+		bx::RingBufferControl m_control;
+	};
+
 	struct CommandQueueVK
 	{
 		VkResult init(uint32_t _queueFamily, VkQueue _queue, uint32_t _numFramesInFlight);
@@ -802,6 +978,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 		void finish(bool _finishAll = false);
 
 		void release(uint64_t _handle, VkObjectType _type);
+		void release(const DeviceMemoryAllocationVK& _alloc);
 		void consume();
 
 		uint32_t m_queueFamily;
@@ -843,6 +1020,9 @@ VK_DESTROY_FUNC(DescriptorSet);
 		typedef stl::vector<Resource> ResourceArray;
 		ResourceArray m_release[BGFX_CONFIG_MAX_FRAME_LATENCY];
 
+		typedef stl::vector<DeviceMemoryAllocationVK> AllocationArray;
+		AllocationArray m_releaseAlloc[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
 	private:
 		template<typename Ty>
 		void destroy(uint64_t _handle)
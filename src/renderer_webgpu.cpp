@@ -571,17 +571,27 @@ namespace bgfx { namespace webgpu
 			m_cmd.init(m_queue);
 			//BGFX_FATAL(NULL != m_cmd.m_commandQueue, Fatal::UnableToInitialize, "Unable to create Metal device.");
 
+			// Scratch and uniform buffers are not grown during frame. Limit is
+			// already lowered by init, unless this renderer is fallback for
+			// another one.
+			BX_WARN(g_caps.limits.maxDrawCalls <= BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+				, "Init::Limits::maxDrawCalls %d is lowered to %d (BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS)."
+				, g_caps.limits.maxDrawCalls
+				, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS
+				);
+			g_caps.limits.maxDrawCalls = bx::min<uint32_t>(g_caps.limits.maxDrawCalls, BGFX_CONFIG_MAX_SCRATCH_DRAW_CALLS);
+
 			for (uint8_t ii = 0; ii < BGFX_CONFIG_MAX_FRAME_LATENCY; ++ii)
 			{
 				BX_TRACE("Create scratch buffer %d", ii);
-				m_scratchBuffers[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS * 128);
+				m_scratchBuffers[ii].create(g_caps.limits.maxDrawCalls * 128);
 				m_bindStateCache[ii].create(); // (1024);
 			}
 
 			for (uint8_t ii = 0; ii < WEBGPU_NUM_UNIFORM_BUFFERS; ++ii)
 			{
 				bool mapped = true; // ii == WEBGPU_NUM_UNIFORM_BUFFERS - 1;
-				m_uniformBuffers[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS * 128, mapped);
+				m_uniformBuffers[ii].create(g_caps.limits.maxDrawCalls * 128, mapped);
 			}
 
 			g_caps.supported |= (0
@@ -1219,6 +1229,11 @@ namespace bgfx { namespace webgpu
 			return false;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void flip() override
 		{
 			for (uint32_t ii = 0, num = m_numWindows; ii < num; ++ii)
@@ -3529,7 +3544,7 @@ namespace bgfx { namespace webgpu
 		m_size = _size;
 
 		wgpu::BufferDescriptor desc;
-		desc.size = BGFX_CONFIG_MAX_DRAW_CALLS * 128;
+		desc.size = _size;
 		desc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform;
 
 		m_buffer = s_renderWgpu->m_device.CreateBuffer(&desc);
@@ -4116,15 +4131,21 @@ namespace bgfx { namespace webgpu
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, bx::strideAlign(_render->m_iboffset,4), ib->data, true);
+
+			_render->updateTransientIndexBuffers([&](const TransientIndexBuffer& _page, uint32_t _size)
+			{
+				m_indexBuffers[_page.handle.idx].update(0, bx::strideAlign(_size,4), _page.data, true);
+			});
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, bx::strideAlign(_render->m_vboffset,4), vb->data, true);
+
+			_render->updateTransientVertexBuffers([&](const TransientVertexBuffer& _page, uint32_t _size)
+			{
+				m_vertexBuffers[_page.handle.idx].update(0, bx::strideAlign(_size,4), _page.data, true);
+			});
 		}
 
 		_render->sort();
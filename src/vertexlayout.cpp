@@ -5,7 +5,9 @@
 
 #include <bx/debug.h>
 #include <bx/hash.h>
+#include <bx/mutex.h>
 #include <bx/readerwriter.h>
+#include <bx/simd_t.h>
 #include <bx/sort.h>
 #include <bx/string.h>
 #include <bx/uint32_t.h>
@@ -622,32 +624,252 @@ namespace bgfx
 		}
 	}
 
-	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
+	struct ConvertOp;
+
+	typedef void (*ConvertFn)(uint8_t* _dest, uint32_t _destStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num, const ConvertOp& _op);
+
+	struct ConvertOp
 	{
-		if (_destLayout.m_hash == _srcLayout.m_hash)
+		enum Enum
 		{
-			bx::memCopy(_destData, _srcData, _srcLayout.getSize(_num) );
-			return;
+			Set,
+			Copy,
+			Convert,
+			Kernel,
+		};
+
+		Attrib::Enum attr;
+		Enum op;
+		uint32_t src;
+		uint32_t dest;
+		uint32_t size;
+
+		// Kernel only.
+		ConvertFn fn;
+		float scale;
+		float bias;
+		uint8_t srcNum;
+		uint8_t destNum;
+	};
+
+	// Number of vertices converted by each kernel call, keeps source and
+	// destination of block in cache while all attributes are converted.
+	static const uint32_t kConvertBlockSize = 64;
+
+	// Loads float attribute, missing components are zero same as vertexUnpack.
+	BX_FORCE_INLINE bx::simd128_t loadFloat4(const uint8_t* _src, uint32_t _num)
+	{
+		const float* src = (const float*)_src;
+
+		BX_ALIGN_DECL_16(float) tmp[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		switch (_num)
+		{
+		default: tmp[3] = src[3]; BX_FALLTHROUGH;
+		case 3:  tmp[2] = src[2]; BX_FALLTHROUGH;
+		case 2:  tmp[1] = src[1]; BX_FALLTHROUGH;
+		case 1:  tmp[0] = src[0];
 		}
 
-		struct ConvertOp
+		return bx::simd_ld<bx::simd128_t>(tmp);
+	}
+
+	// Converts 4 floats to half, rounds to nearest even. Result is in low 16
+	// bits of each component.
+	BX_FORCE_INLINE bx::simd128_t simdHalfFromFloat(bx::simd128_t _a)
+	{
+		using namespace bx;
+
+		const simd128_t signMask    = simd_isplat<simd128_t>(UINT32_C(0x80000000) );
+		const simd128_t f32Inf      = simd_isplat<simd128_t>(UINT32_C(255) << 23);
+		const simd128_t f16Max      = simd_isplat<simd128_t>(UINT32_C(127 + 16) << 23);
+		const simd128_t f16MinNorm  = simd_isplat<simd128_t>(UINT32_C(113) << 23);
+		const simd128_t denormMagic = simd_isplat<simd128_t>(UINT32_C( (127 - 15) + (23 - 10) + 1) << 23);
+		const simd128_t rebias      = simd_isplat<simd128_t>(UINT32_C(0xc8000fff) ); // ((15 - 127) << 23) + 0xfff
+		const simd128_t one         = simd_isplat<simd128_t>(1);
+		const simd128_t h16Inf      = simd_isplat<simd128_t>(0x7c00);
+		const simd128_t h16Nan      = simd_isplat<simd128_t>(0x7e00);
+
+		const simd128_t sign    = simd_and(_a, signMask);
+		const simd128_t abs     = simd_xor(_a, sign);
+
+		const simd128_t denorm  = simd_isub(simd_add(abs, denormMagic), denormMagic);
+		const simd128_t mantOdd = simd_and(simd_srl(abs, 13), one);
+		const simd128_t normal  = simd_srl(simd_iadd(simd_iadd(abs, rebias), mantOdd), 13);
+		const simd128_t infNan  = simd_selb(simd_icmpgt(abs, f32Inf), h16Nan, h16Inf);
+
+		const simd128_t finite  = simd_selb(simd_icmplt(abs, f16MinNorm), denorm, normal);
+		const simd128_t result  = simd_selb(simd_icmplt(abs, f16Max), finite, infNan);
+
+		return simd_or(result, simd_srl(sign, 16) );
+	}
+
+	template<AttribType::Enum TypeT>
+	BX_FORCE_INLINE bx::simd128_t convertFloat4(bx::simd128_t _input, bx::simd128_t _scale, bx::simd128_t _bias)
+	{
+		if (AttribType::Half == TypeT)
 		{
-			enum Enum
-			{
-				Set,
-				Copy,
-				Convert,
-			};
-
-			Attrib::Enum attr;
-			Enum op;
-			uint32_t src;
-			uint32_t dest;
-			uint32_t size;
-		};
+			return simdHalfFromFloat(_input);
+		}
+
+		return bx::simd_ftoi(bx::simd_madd(_input, _scale, _bias) );
+	}
+
+	// Stores converted components of one vertex. Components are packed into
+	// register first, and written with single store where size allows it.
+	template<AttribType::Enum TypeT>
+	BX_FORCE_INLINE void storePacked(uint8_t* _dest, bx::simd128_t _value, uint32_t _num);
+
+	template<>
+	BX_FORCE_INLINE void storePacked<AttribType::Uint8>(uint8_t* _dest, bx::simd128_t _value, uint32_t _num)
+	{
+		BX_ALIGN_DECL_16(uint32_t) value[4];
+		bx::simd_st(value, _value);
+
+		const uint32_t packed = 0
+			| (value[0] & 0xff)
+			| (value[1] & 0xff) <<  8
+			| (value[2] & 0xff) << 16
+			| (value[3]       ) << 24
+			;
+
+		switch (_num)
+		{
+		default: *(uint32_t*)_dest = packed;                                          break;
+		case 3:  *(uint16_t*)_dest = uint16_t(packed); _dest[2] = uint8_t(packed>>16); break;
+		case 2:  *(uint16_t*)_dest = uint16_t(packed);                                break;
+		case 1:  _dest[0] = uint8_t(packed);                                          break;
+		}
+	}
+
+	template<>
+	BX_FORCE_INLINE void storePacked<AttribType::Uint10>(uint8_t* _dest, bx::simd128_t _value, uint32_t _num)
+	{
+		BX_ALIGN_DECL_16(uint32_t) value[4];
+		bx::simd_st(value, _value);
+
+		// Same order as vertexPack, first component ends in highest bits.
+		uint32_t packed;
+		switch (_num)
+		{
+		default: packed = value[0] << 20 | value[1] << 10 | value[2]; break;
+		case 2:  packed = value[0] << 10 | value[1];                  break;
+		case 1:  packed = value[0];                                   break;
+		}
 
-		ConvertOp convertOp[Attrib::Count];
-		uint32_t numOps = 0;
+		*(uint32_t*)_dest = packed;
+	}
+
+	BX_FORCE_INLINE void storePacked16(uint8_t* _dest, bx::simd128_t _value, uint32_t _num)
+	{
+		BX_ALIGN_DECL_16(uint32_t) value[4];
+		bx::simd_st(value, _value);
+
+		const uint32_t xy = (value[0] & 0xffff) | value[1] << 16;
+		const uint32_t zw = (value[2] & 0xffff) | value[3] << 16;
+
+		switch (_num)
+		{
+		default: *(uint64_t*)_dest = uint64_t(zw) << 32 | xy;        break;
+		case 3:  *(uint32_t*)_dest = xy; *(uint16_t*)&_dest[4] = uint16_t(zw); break;
+		case 2:  *(uint32_t*)_dest = xy;                             break;
+		case 1:  *(uint16_t*)_dest = uint16_t(xy);                   break;
+		}
+	}
+
+	template<>
+	BX_FORCE_INLINE void storePacked<AttribType::Int16>(uint8_t* _dest, bx::simd128_t _value, uint32_t _num)
+	{
+		storePacked16(_dest, _value, _num);
+	}
+
+	template<>
+	BX_FORCE_INLINE void storePacked<AttribType::Half>(uint8_t* _dest, bx::simd128_t _value, uint32_t _num)
+	{
+		storePacked16(_dest, _value, _num);
+	}
+
+	// Converts float attribute to TypeT, with same result as vertexUnpack
+	// followed by vertexPack with normalized input. Four vertices are loaded
+	// and converted per iteration.
+	template<AttribType::Enum TypeT>
+	static void convertFloat(uint8_t* _dest, uint32_t _destStride, const uint8_t* _src, uint32_t _srcStride, uint32_t _num, const ConvertOp& _op)
+	{
+		const bx::simd128_t scale = bx::simd_splat<bx::simd128_t>(_op.scale);
+		const bx::simd128_t bias  = bx::simd_splat<bx::simd128_t>(_op.bias);
+
+		const uint32_t srcNum  = _op.srcNum;
+		const uint32_t destNum = _op.destNum;
+
+		uint32_t ii = 0;
+
+		for (; ii + 4 <= _num; ii += 4, _src += 4*_srcStride, _dest += 4*_destStride)
+		{
+			const bx::simd128_t in0 = loadFloat4(_src,                srcNum);
+			const bx::simd128_t in1 = loadFloat4(_src +   _srcStride, srcNum);
+			const bx::simd128_t in2 = loadFloat4(_src + 2*_srcStride, srcNum);
+			const bx::simd128_t in3 = loadFloat4(_src + 3*_srcStride, srcNum);
+
+			const bx::simd128_t out0 = convertFloat4<TypeT>(in0, scale, bias);
+			const bx::simd128_t out1 = convertFloat4<TypeT>(in1, scale, bias);
+			const bx::simd128_t out2 = convertFloat4<TypeT>(in2, scale, bias);
+			const bx::simd128_t out3 = convertFloat4<TypeT>(in3, scale, bias);
+
+			storePacked<TypeT>(_dest,                 out0, destNum);
+			storePacked<TypeT>(_dest +   _destStride, out1, destNum);
+			storePacked<TypeT>(_dest + 2*_destStride, out2, destNum);
+			storePacked<TypeT>(_dest + 3*_destStride, out3, destNum);
+		}
+
+		for (; ii < _num; ++ii, _src += _srcStride, _dest += _destStride)
+		{
+			const bx::simd128_t input = loadFloat4(_src, srcNum);
+			storePacked<TypeT>(_dest, convertFloat4<TypeT>(input, scale, bias), destNum);
+		}
+	}
+
+	static const ConvertFn s_convertFloat[AttribType::Count] =
+	{
+		convertFloat<AttribType::Uint8>,  // Uint8
+		convertFloat<AttribType::Uint10>, // Uint10
+		convertFloat<AttribType::Int16>,  // Int16
+		convertFloat<AttribType::Half>,   // Half
+		NULL,                             // Float
+	};
+
+	// Scale and bias used by vertexPack for normalized input.
+	static const float s_convertFloatScaleBias[AttribType::Count][2][2] =
+	{
+		{ {   255.0f,      0.0f }, {   127.0f, 128.0f } }, // Uint8
+		{ {  1023.0f,      0.0f }, {   511.0f, 512.0f } }, // Uint10
+		{ { 65535.0f, -32768.0f }, { 32767.0f,   0.0f } }, // Int16
+		{ {     1.0f,      0.0f }, {     1.0f,   0.0f } }, // Half
+		{ {     1.0f,      0.0f }, {     1.0f,   0.0f } }, // Float
+	};
+
+	struct ConvertProgram
+	{
+		VertexLayout destLayout;
+		VertexLayout srcLayout;
+		ConvertOp op[Attrib::Count];
+		uint32_t numOps;
+		uint32_t numKernelOps;
+	};
+
+	static bool isEqual(const VertexLayout& _a, const VertexLayout& _b)
+	{
+		return _a.m_hash   == _b.m_hash
+			&& _a.m_stride == _b.m_stride
+			&& 0 == bx::memCmp(_a.m_offset,     _b.m_offset,     sizeof(_a.m_offset) )
+			&& 0 == bx::memCmp(_a.m_attributes, _b.m_attributes, sizeof(_a.m_attributes) )
+			;
+	}
+
+	static void buildConvertProgram(ConvertProgram& _program, const VertexLayout& _destLayout, const VertexLayout& _srcLayout)
+	{
+		_program.destLayout   = _destLayout;
+		_program.srcLayout    = _srcLayout;
+		_program.numOps       = 0;
+		_program.numKernelOps = 0;
 
 		for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 		{
@@ -655,7 +877,7 @@ namespace bgfx
 
 			if (_destLayout.has(attr) )
 			{
-				ConvertOp& cop = convertOp[numOps];
+				ConvertOp& cop = _program.op[_program.numOps];
 				cop.attr = attr;
 				cop.dest = _destLayout.getOffset(attr);
 
@@ -670,16 +892,85 @@ namespace bgfx
 				{
 					cop.src = _srcLayout.getOffset(attr);
 					cop.op = _destLayout.m_attributes[attr] == _srcLayout.m_attributes[attr] ? ConvertOp::Copy : ConvertOp::Convert;
+
+					uint8_t srcNum;
+					AttribType::Enum srcType;
+					bool srcNormalized;
+					bool srcAsInt;
+					_srcLayout.decode(attr, srcNum, srcType, srcNormalized, srcAsInt);
+
+					if (ConvertOp::Convert == cop.op
+					&&  AttribType::Float == srcType
+					&&  NULL != s_convertFloat[type])
+					{
+						cop.op      = ConvertOp::Kernel;
+						cop.fn      = s_convertFloat[type];
+						cop.scale   = s_convertFloatScaleBias[type][asInt][0];
+						cop.bias    = s_convertFloatScaleBias[type][asInt][1];
+						cop.srcNum  = srcNum;
+						cop.destNum = num;
+						++_program.numKernelOps;
+					}
 				}
 				else
 				{
 					cop.op = ConvertOp::Set;
 				}
 
-				++numOps;
+				++_program.numOps;
+			}
+		}
+	}
+
+	// Recently used conversion programs. Meshes are usually converted with the
+	// same few layout pairs, program is built once per pair.
+	static const uint32_t kConvertProgramCacheSize = 8;
+
+	static bx::Mutex      s_convertProgramMutex;
+	static ConvertProgram s_convertProgram[kConvertProgramCacheSize];
+	static uint32_t       s_convertProgramNum  = 0;
+	static uint32_t       s_convertProgramNext = 0;
+
+	static void getConvertProgram(ConvertProgram& _program, const VertexLayout& _destLayout, const VertexLayout& _srcLayout)
+	{
+		bx::MutexScope scope(s_convertProgramMutex);
+
+		for (uint32_t ii = 0; ii < s_convertProgramNum; ++ii)
+		{
+			const ConvertProgram& program = s_convertProgram[ii];
+
+			if (isEqual(program.destLayout, _destLayout)
+			&&  isEqual(program.srcLayout,  _srcLayout) )
+			{
+				_program = program;
+				return;
 			}
 		}
 
+		ConvertProgram& program = s_convertProgram[s_convertProgramNext];
+		buildConvertProgram(program, _destLayout, _srcLayout);
+
+		s_convertProgramNext = (s_convertProgramNext + 1) % kConvertProgramCacheSize;
+		s_convertProgramNum  = bx::min(s_convertProgramNum + 1, kConvertProgramCacheSize);
+
+		_program = program;
+	}
+
+	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
+	{
+		if (_destLayout.m_hash == _srcLayout.m_hash)
+		{
+			bx::memCopy(_destData, _srcData, _srcLayout.getSize(_num) );
+			return;
+		}
+
+		ConvertProgram program;
+		getConvertProgram(program, _destLayout, _srcLayout);
+
+		const ConvertOp* convertOp = program.op;
+		const uint32_t numOps       = program.numOps;
+		const uint32_t numKernelOps = program.numKernelOps;
+
 		if (0 < numOps)
 		{
 			const uint8_t* src = (const uint8_t*)_srcData;
@@ -690,31 +981,56 @@ namespace bgfx
 
 			float unpacked[4];
 
-			for (uint32_t ii = 0; ii < _num; ++ii)
+			for (uint32_t block = 0; block < _num; block += kConvertBlockSize)
 			{
-				for (uint32_t jj = 0; jj < numOps; ++jj)
+				const uint32_t numVertices = bx::min<uint32_t>(_num - block, kConvertBlockSize);
+
+				for (uint32_t jj = 0; jj < numOps && 0 < numKernelOps; ++jj)
 				{
 					const ConvertOp& cop = convertOp[jj];
 
-					switch (cop.op)
+					if (ConvertOp::Kernel == cop.op)
 					{
-					case ConvertOp::Set:
-						bx::memSet(dest + cop.dest, 0, cop.size);
-						break;
-
-					case ConvertOp::Copy:
-						bx::memCopy(dest + cop.dest, src + cop.src, cop.size);
-						break;
-
-					case ConvertOp::Convert:
-						vertexUnpack(unpacked, cop.attr, _srcLayout, src);
-						vertexPack(unpacked, true, cop.attr, _destLayout, dest);
-						break;
+						cop.fn(dest + cop.dest, destStride, src + cop.src, srcStride, numVertices, cop);
 					}
 				}
 
-				src += srcStride;
-				dest += destStride;
+				if (numKernelOps == numOps)
+				{
+					src  += numVertices*srcStride;
+					dest += numVertices*destStride;
+					continue;
+				}
+
+				for (uint32_t ii = 0; ii < numVertices; ++ii)
+				{
+					for (uint32_t jj = 0; jj < numOps; ++jj)
+					{
+						const ConvertOp& cop = convertOp[jj];
+
+						switch (cop.op)
+						{
+						case ConvertOp::Set:
+							bx::memSet(dest + cop.dest, 0, cop.size);
+							break;
+
+						case ConvertOp::Copy:
+							bx::memCopy(dest + cop.dest, src + cop.src, cop.size);
+							break;
+
+						case ConvertOp::Convert:
+							vertexUnpack(unpacked, cop.attr, _srcLayout, src);
+							vertexPack(unpacked, true, cop.attr, _destLayout, dest);
+							break;
+
+						case ConvertOp::Kernel:
+							break;
+						}
+					}
+
+					src += srcStride;
+					dest += destStride;
+				}
 			}
 		}
 	}
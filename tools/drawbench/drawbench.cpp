@@ -0,0 +1,1057 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/allocator.h>
+#include <bx/commandline.h>
+#include <bx/math.h>
+#include <bx/rng.h>
+#include <bx/semaphore.h>
+#include <bx/string.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+#include <bx/uint32_t.h>
+
+#include <bgfx/bgfx.h>
+#include <bgfx/embedded_shader.h>
+#include <bgfx/platform.h>
+
+// Clear quad shaders from library (position only vertex shader, fragment shader
+// writing uniform color), used with renderers other than noop.
+#include "../../src/vs_clear.bin.h"
+#include "../../src/fs_clear0.bin.h"
+
+#define BGFX_DRAWBENCH_VERSION_MAJOR 1
+#define BGFX_DRAWBENCH_VERSION_MINOR 0
+
+// Shader binaries are never compiled by noop renderer, only header is parsed
+// by library. Version 11 header without uniforms, code, or attributes.
+#define DRAWBENCH_SHADER_BIN(_type, _hashIn, _hashOut) \
+	{ \
+		_type, 'S', 'H', 11, \
+		uint8_t(_hashIn), uint8_t(_hashIn>>8), uint8_t(_hashIn>>16), uint8_t(_hashIn>>24), \
+		uint8_t(_hashOut), uint8_t(_hashOut>>8), uint8_t(_hashOut>>16), uint8_t(_hashOut>>24), \
+		0, 0, \
+		0, 0, 0, 0, \
+		0, \
+		0, 0, \
+	}
+
+static const uint8_t s_vsBin[] = DRAWBENCH_SHADER_BIN('V', 0x00000000, 0x9e3779b9);
+static const uint8_t s_fsBin[] = DRAWBENCH_SHADER_BIN('F', 0x9e3779b9, 0x00000000);
+
+#undef DRAWBENCH_SHADER_BIN
+
+static const bgfx::EmbeddedShader s_embeddedShaders[] =
+{
+	BGFX_EMBEDDED_SHADER(vs_clear),
+	BGFX_EMBEDDED_SHADER(fs_clear0),
+
+	BGFX_EMBEDDED_SHADER_END()
+};
+
+struct RendererName
+{
+	const char* m_name;
+	bgfx::RendererType::Enum m_type;
+};
+
+static const RendererName s_rendererName[] =
+{
+	{ "noop",  bgfx::RendererType::Noop       },
+	{ "d3d9",  bgfx::RendererType::Direct3D9  },
+	{ "d3d11", bgfx::RendererType::Direct3D11 },
+	{ "d3d12", bgfx::RendererType::Direct3D12 },
+	{ "gl",    bgfx::RendererType::OpenGL     },
+	{ "gles",  bgfx::RendererType::OpenGLES   },
+	{ "mtl",   bgfx::RendererType::Metal      },
+	{ "vk",    bgfx::RendererType::Vulkan     },
+};
+
+static const float s_cubeVertices[] =
+{
+	-1.0f,  1.0f,  1.0f,
+	 1.0f,  1.0f,  1.0f,
+	-1.0f, -1.0f,  1.0f,
+	 1.0f, -1.0f,  1.0f,
+	-1.0f,  1.0f, -1.0f,
+	 1.0f,  1.0f, -1.0f,
+	-1.0f, -1.0f, -1.0f,
+	 1.0f, -1.0f, -1.0f,
+};
+
+static const uint16_t s_cubeIndices[] =
+{
+	0, 1, 2, 1, 3, 2,
+	4, 6, 5, 5, 6, 7,
+	0, 2, 4, 4, 2, 6,
+	1, 5, 3, 5, 7, 3,
+	0, 4, 1, 4, 5, 1,
+	2, 3, 6, 6, 3, 7,
+};
+
+static constexpr uint32_t kNumViews    = 4;
+static constexpr uint32_t kNumPrograms = 4;
+static constexpr uint32_t kMaxEncoders = 32;
+
+// Render items are sorted per view in parallel, sort case spreads draws over
+// more views than other cases.
+static constexpr uint32_t kNumSortViews = 16;
+
+// Live dynamic vertex buffers, and number of them destroyed and created again
+// per frame by dynamic case.
+static constexpr uint32_t kNumDynamic   = 2048;
+static constexpr uint32_t kDynamicChurn = 256;
+
+// Vertices converted into transient vertex buffer per draw, by convert case.
+static constexpr uint32_t kConvertVertices = 64;
+
+struct Bench;
+
+// Submits draws [_first, _first + _num) of frame from single encoder.
+typedef void (*SubmitFn)(Bench* _bench, bgfx::Encoder* _encoder, uint32_t _encoderIdx, uint32_t _first, uint32_t _num);
+
+// Called on API thread before encoders submit, for work that can't be done
+// from encoders. Returns number of operations done.
+typedef uint32_t (*FrameFn)(Bench* _bench);
+
+struct BenchCase
+{
+	const char* m_name;
+	const char* m_desc;
+	SubmitFn    m_submit;
+	FrameFn     m_frame;
+};
+
+struct Worker
+{
+	bx::Thread    m_thread;
+	bx::Semaphore m_kick;
+	Bench*        m_bench;
+	uint32_t      m_idx;
+};
+
+struct Bench
+{
+	const BenchCase* m_case;
+
+	bgfx::ProgramHandle      m_program[kNumPrograms];
+	bgfx::UniformHandle      m_color;
+	bgfx::VertexLayout       m_layout;
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle  m_ibh;
+
+	// Float source, and packed destination layout of convert case.
+	bgfx::VertexLayout m_convertSrcLayout;
+	bgfx::VertexLayout m_convertLayout;
+	float*             m_convertSrc;
+
+	// Dynamic vertex buffers used by dynamic and update case.
+	bgfx::VertexLayout              m_dynamicLayout;
+	bgfx::DynamicVertexBufferHandle m_dynamic[kNumDynamic];
+	uint32_t                        m_numDynamic;
+	bx::RngMwc                      m_rng;
+
+	// Data written into each of first m_numUpdates dynamic vertex buffers per
+	// frame by update case.
+	uint8_t* m_updateData;
+	uint32_t m_updateSize;
+	uint32_t m_numUpdates;
+
+	// API thread operations done by frame function, and time spent in them.
+	uint32_t m_numOps;
+	int64_t  m_opTime;
+
+	uint32_t m_numDraws;
+	uint32_t m_numEncoders;
+	uint32_t m_frame;
+
+	// Number of failed allocations per encoder.
+	uint32_t m_failed[kMaxEncoders];
+
+	Worker        m_worker[kMaxEncoders];
+	bx::Semaphore m_done;
+	bool          m_quit;
+};
+
+static void submitDraw(Bench* _bench, bgfx::Encoder* _encoder, uint32_t _encoderIdx, uint32_t _first, uint32_t _num)
+{
+	BX_UNUSED(_encoderIdx);
+
+	bx::RngMwc rng(_first + 1);
+
+	for (uint32_t ii = _first, end = _first + _num; ii < end; ++ii)
+	{
+		const float xx = float(ii%100)*3.0f;
+		const float yy = float(ii/100%100)*3.0f;
+
+		float mtx[16];
+		bx::mtxRotateXY(mtx, float(_bench->m_frame)*0.01f, float(ii)*0.1f);
+		mtx[12] = xx;
+		mtx[13] = yy;
+		mtx[14] = 0.0f;
+
+		const float color[4] = { xx, yy, 0.0f, 1.0f };
+
+		_encoder->setTransform(mtx);
+		_encoder->setUniform(_bench->m_color, color);
+		_encoder->setVertexBuffer(0, _bench->m_vbh);
+		_encoder->setIndexBuffer(_bench->m_ibh);
+		_encoder->setState(BGFX_STATE_DEFAULT);
+		_encoder->submit(
+			  bgfx::ViewId(ii%kNumViews)
+			, _bench->m_program[ii/kNumViews%kNumPrograms]
+			, rng.gen()
+			);
+	}
+}
+
+// Every draw allocates its own transient vertex and index buffer from encoder,
+// measures contention on frame transient buffers between encoders.
+static void submitTransient(Bench* _bench, bgfx::Encoder* _encoder, uint32_t _encoderIdx, uint32_t _first, uint32_t _num)
+{
+	const uint32_t numVertices = BX_COUNTOF(s_cubeVertices)/3;
+	const uint32_t numIndices  = BX_COUNTOF(s_cubeIndices);
+
+	for (uint32_t ii = _first, end = _first + _num; ii < end; ++ii)
+	{
+		bgfx::TransientVertexBuffer tvb;
+		bgfx::TransientIndexBuffer  tib;
+		_encoder->allocTransientVertexBuffer(&tvb, numVertices, _bench->m_layout);
+		_encoder->allocTransientIndexBuffer(&tib, numIndices);
+
+		if (tvb.size < sizeof(s_cubeVertices)
+		||  tib.size < sizeof(s_cubeIndices) )
+		{
+			++_bench->m_failed[_encoderIdx];
+			continue;
+		}
+
+		bx::memCopy(tvb.data, s_cubeVertices, sizeof(s_cubeVertices) );
+		bx::memCopy(tib.data, s_cubeIndices,  sizeof(s_cubeIndices) );
+
+		_encoder->setVertexBuffer(0, &tvb);
+		_encoder->setIndexBuffer(&tib);
+		_encoder->setState(BGFX_STATE_DEFAULT);
+		_encoder->submit(bgfx::ViewId(ii%kNumViews), _bench->m_program[ii/kNumViews%kNumPrograms]);
+	}
+}
+
+// Every draw converts float vertices into packed transient vertex buffer with
+// vertexConvert, measures conversion of small batches from multiple threads.
+static void submitConvert(Bench* _bench, bgfx::Encoder* _encoder, uint32_t _encoderIdx, uint32_t _first, uint32_t _num)
+{
+	for (uint32_t ii = _first, end = _first + _num; ii < end; ++ii)
+	{
+		bgfx::TransientVertexBuffer tvb;
+		_encoder->allocTransientVertexBuffer(&tvb, kConvertVertices, _bench->m_convertLayout);
+
+		if (tvb.size < _bench->m_convertLayout.getSize(kConvertVertices) )
+		{
+			++_bench->m_failed[_encoderIdx];
+			continue;
+		}
+
+		bgfx::vertexConvert(
+			  _bench->m_convertLayout
+			, tvb.data
+			, _bench->m_convertSrcLayout
+			, _bench->m_convertSrc
+			, kConvertVertices
+			);
+
+		_encoder->setVertexBuffer(0, &tvb);
+		_encoder->setState(BGFX_STATE_DEFAULT);
+		_encoder->submit(bgfx::ViewId(ii%kNumViews), _bench->m_program[ii/kNumViews%kNumPrograms]);
+	}
+}
+
+// Draws have only state and random view, program and depth, so that frame
+// time is mostly spent sorting render items. Compare with library built with
+// BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS=0 for single threaded sort.
+static void submitSort(Bench* _bench, bgfx::Encoder* _encoder, uint32_t _encoderIdx, uint32_t _first, uint32_t _num)
+{
+	BX_UNUSED(_encoderIdx);
+
+	bx::RngMwc rng(_first + _bench->m_frame + 1);
+
+	for (uint32_t ii = _first, end = _first + _num; ii < end; ++ii)
+	{
+		_encoder->setVertexBuffer(0, _bench->m_vbh);
+		_encoder->setIndexBuffer(_bench->m_ibh);
+		_encoder->setState(BGFX_STATE_DEFAULT);
+		_encoder->submit(
+			  bgfx::ViewId(rng.gen()%kNumSortViews)
+			, _bench->m_program[rng.gen()%kNumPrograms]
+			, rng.gen()
+			);
+	}
+}
+
+// Destroys random dynamic vertex buffers and creates them again with random
+// size, measures allocator of buffers shared by dynamic vertex buffers.
+static uint32_t frameDynamic(Bench* _bench)
+{
+	uint32_t numOps = 0;
+
+	for (uint32_t ii = 0; ii < kDynamicChurn; ++ii)
+	{
+		bgfx::DynamicVertexBufferHandle& handle = _bench->m_dynamic[_bench->m_rng.gen()%_bench->m_numDynamic];
+
+		if (bgfx::isValid(handle) )
+		{
+			bgfx::destroy(handle);
+			++numOps;
+		}
+
+		handle = bgfx::createDynamicVertexBuffer(1 + _bench->m_rng.gen()%256, _bench->m_dynamicLayout);
+		++numOps;
+
+		if (!bgfx::isValid(handle) )
+		{
+			++_bench->m_failed[0];
+		}
+	}
+
+	return numOps;
+}
+
+static void submitDynamic(Bench* _bench, bgfx::Encoder* _encoder, uint32_t _encoderIdx, uint32_t _first, uint32_t _num)
+{
+	BX_UNUSED(_encoderIdx);
+
+	for (uint32_t ii = _first, end = _first + _num; ii < end; ++ii)
+	{
+		const bgfx::DynamicVertexBufferHandle handle = _bench->m_dynamic[ii%_bench->m_numDynamic];
+
+		if (bgfx::isValid(handle) )
+		{
+			_encoder->setVertexBuffer(0, handle);
+			_encoder->setState(BGFX_STATE_DEFAULT);
+			_encoder->submit(bgfx::ViewId(ii%kNumViews), _bench->m_program[ii/kNumViews%kNumPrograms]);
+		}
+	}
+}
+
+// Updates whole dynamic vertex buffers from copied memory. On noop renderer
+// only library side of update is measured, renderer side (f.e. Vulkan staging
+// uploads) needs real device (--renderer).
+static uint32_t frameUpdate(Bench* _bench)
+{
+	uint32_t numOps = 0;
+
+	for (uint32_t ii = 0; ii < _bench->m_numUpdates; ++ii)
+	{
+		if (bgfx::isValid(_bench->m_dynamic[ii]) )
+		{
+			bgfx::update(_bench->m_dynamic[ii], 0, bgfx::copy(_bench->m_updateData, _bench->m_updateSize) );
+			++numOps;
+		}
+		else
+		{
+			++_bench->m_failed[0];
+		}
+	}
+
+	return numOps;
+}
+
+static const BenchCase s_case[] =
+{
+	{ "draw",      "Static vertex and index buffer, transform, uniform and state per draw.", submitDraw,      NULL         },
+	{ "transient", "Transient vertex and index buffer allocated from encoder per draw.",      submitTransient, NULL         },
+	{ "convert",   "Float vertices converted to packed layout with vertexConvert per draw.", submitConvert,   NULL         },
+	{ "sort",      "Random view, program and depth per draw, measures render item sort.",    submitSort,      NULL         },
+	{ "dynamic",   "Random dynamic vertex buffers destroyed and created again every frame.", submitDynamic,   frameDynamic },
+	{ "update",    "Dynamic vertex buffers updated every frame, drawn from encoders.",       submitDynamic,   frameUpdate  },
+};
+
+static void initConvertLayout(bgfx::VertexLayout& _srcLayout, bgfx::VertexLayout& _layout)
+{
+	_srcLayout
+		.begin()
+		.add(bgfx::Attrib::Position,  3, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::Normal,    3, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::Color0,    4, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+		.end();
+
+	_layout
+		.begin()
+		.add(bgfx::Attrib::Position,  3, bgfx::AttribType::Half)
+		.add(bgfx::Attrib::Normal,    3, bgfx::AttribType::Uint10, true, true)
+		.add(bgfx::Attrib::Color0,    4, bgfx::AttribType::Uint8,  true)
+		.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Int16,  true, true)
+		.end();
+}
+
+static bool isHalfNan(uint16_t _half)
+{
+	return 0x7c00 == (_half & 0x7c00)
+		&& 0      != (_half & 0x03ff)
+		;
+}
+
+// Compares vertexConvert from float attributes against vertexUnpack followed
+// by vertexPack, for every packed type and number of components. Float to half
+// conversion is compared against bx::halfFromFloat for every float bit
+// pattern, NaN payload is not compared.
+static bool checkConvert()
+{
+	constexpr uint32_t kNumVertices = 67;
+
+	static const bgfx::AttribType::Enum s_type[] =
+	{
+		bgfx::AttribType::Uint8,
+		bgfx::AttribType::Uint10,
+		bgfx::AttribType::Int16,
+		bgfx::AttribType::Half,
+	};
+
+	bx::RngMwc rng;
+	uint32_t numFailed = 0;
+
+	for (uint32_t tt = 0; tt < BX_COUNTOF(s_type); ++tt)
+	{
+		for (uint8_t num = 1; num <= 4; ++num)
+		{
+			for (uint32_t asInt = 0; asInt < 2; ++asInt)
+			{
+				bgfx::VertexLayout srcLayout;
+				srcLayout
+					.begin()
+					.add(bgfx::Attrib::Position,  3,   bgfx::AttribType::Float)
+					.add(bgfx::Attrib::TexCoord0, num, bgfx::AttribType::Float)
+					.end();
+
+				bgfx::VertexLayout layout;
+				layout
+					.begin()
+					.add(bgfx::Attrib::Position,  3,   bgfx::AttribType::Float)
+					.add(bgfx::Attrib::TexCoord0, num, s_type[tt], true, 0 != asInt)
+					.end();
+
+				float src[kNumVertices][7];
+				for (uint32_t ii = 0; ii < kNumVertices; ++ii)
+				{
+					for (uint32_t jj = 0; jj < BX_COUNTOF(src[0]); ++jj)
+					{
+						const float value = bx::frnd(&rng);
+						src[ii][jj] = 0 != asInt ? value*2.0f - 1.0f : value;
+					}
+				}
+
+				uint8_t converted[kNumVertices*32];
+				uint8_t expected[kNumVertices*32];
+				bx::memSet(converted, 0, sizeof(converted) );
+				bx::memSet(expected,  0, sizeof(expected) );
+
+				bgfx::vertexConvert(layout, converted, srcLayout, src, kNumVertices);
+
+				for (uint32_t ii = 0; ii < kNumVertices; ++ii)
+				{
+					float unpacked[4];
+					bgfx::vertexUnpack(unpacked, bgfx::Attrib::Position, srcLayout, src, ii);
+					bgfx::vertexPack(unpacked, true, bgfx::Attrib::Position, layout, expected, ii);
+					bgfx::vertexUnpack(unpacked, bgfx::Attrib::TexCoord0, srcLayout, src, ii);
+					bgfx::vertexPack(unpacked, true, bgfx::Attrib::TexCoord0, layout, expected, ii);
+				}
+
+				if (0 != bx::memCmp(converted, expected, layout.getSize(kNumVertices) ) )
+				{
+					bx::printf("vertexConvert: Type %d, num %d, asInt %d doesn't match vertexPack.\n"
+						, s_type[tt]
+						, num
+						, asInt
+						);
+					++numFailed;
+				}
+			}
+		}
+	}
+
+	bgfx::VertexLayout floatLayout;
+	floatLayout
+		.begin()
+		.add(bgfx::Attrib::TexCoord0, 4, bgfx::AttribType::Float)
+		.end();
+
+	bgfx::VertexLayout halfLayout;
+	halfLayout
+		.begin()
+		.add(bgfx::Attrib::TexCoord0, 4, bgfx::AttribType::Half)
+		.end();
+
+	constexpr uint32_t kBatch = 1<<16;
+
+	bx::DefaultAllocator allocator;
+	uint32_t* bits = (uint32_t*)BX_ALLOC(&allocator, kBatch*sizeof(uint32_t) );
+	uint16_t* half = (uint16_t*)BX_ALLOC(&allocator, kBatch*sizeof(uint16_t) );
+
+	uint64_t numMismatch = 0;
+
+	for (uint64_t first = 0; first <= UINT32_MAX; first += kBatch)
+	{
+		for (uint32_t ii = 0; ii < kBatch; ++ii)
+		{
+			bits[ii] = uint32_t(first + ii);
+		}
+
+		bgfx::vertexConvert(halfLayout, half, floatLayout, bits, kBatch/4);
+
+		for (uint32_t ii = 0; ii < kBatch; ++ii)
+		{
+			float value;
+			bx::memCopy(&value, &bits[ii], sizeof(float) );
+
+			const uint16_t expected = bx::halfFromFloat(value);
+
+			if (expected != half[ii]
+			&&  !(isHalfNan(expected) && isHalfNan(half[ii]) ) )
+			{
+				if (0 == numMismatch)
+				{
+					bx::printf("vertexConvert: Half of 0x%08x is 0x%04x, bx::halfFromFloat 0x%04x.\n"
+						, bits[ii]
+						, half[ii]
+						, expected
+						);
+				}
+
+				++numMismatch;
+			}
+		}
+	}
+
+	BX_FREE(&allocator, half);
+	BX_FREE(&allocator, bits);
+
+	if (0 != numMismatch)
+	{
+		bx::printf("vertexConvert: %" PRIu64 " float to half conversions don't match bx::halfFromFloat.\n", numMismatch);
+		++numFailed;
+	}
+
+	bx::printf("vertexConvert check %s.\n", 0 == numFailed ? "passed" : "failed");
+
+	return 0 == numFailed;
+}
+
+static int32_t workerThread(bx::Thread* /*_self*/, void* _userData)
+{
+	Worker* worker = (Worker*)_userData;
+	Bench*  bench  = worker->m_bench;
+
+	for (;;)
+	{
+		worker->m_kick.wait();
+
+		if (bench->m_quit)
+		{
+			break;
+		}
+
+		const uint32_t first = worker->m_idx * bench->m_numDraws / bench->m_numEncoders;
+		const uint32_t end   = (worker->m_idx+1) * bench->m_numDraws / bench->m_numEncoders;
+
+		bgfx::Encoder* encoder = bgfx::begin(true);
+		if (NULL != encoder)
+		{
+			bench->m_case->m_submit(bench, encoder, worker->m_idx, first, end - first);
+			bgfx::end(encoder);
+		}
+
+		bench->m_done.post();
+	}
+
+	return bx::kExitSuccess;
+}
+
+// Submits one frame. Encoder 0 is submitted on this thread, others on worker
+// threads, each with its own encoder.
+static int64_t submitFrame(Bench* _bench)
+{
+	const int64_t start = bx::getHPCounter();
+
+	if (NULL != _bench->m_case->m_frame)
+	{
+		_bench->m_numOps += _bench->m_case->m_frame(_bench);
+		_bench->m_opTime += bx::getHPCounter() - start;
+	}
+
+	for (uint32_t ii = 1; ii < _bench->m_numEncoders; ++ii)
+	{
+		_bench->m_worker[ii].m_kick.post();
+	}
+
+	bgfx::Encoder* encoder = bgfx::begin();
+	_bench->m_case->m_submit(_bench, encoder, 0, 0, _bench->m_numDraws / _bench->m_numEncoders);
+	bgfx::end(encoder);
+
+	for (uint32_t ii = 1; ii < _bench->m_numEncoders; ++ii)
+	{
+		_bench->m_done.wait();
+	}
+
+	return bx::getHPCounter() - start;
+}
+
+// Returns shader binary for renderer, noop renderer gets header only shader.
+static bool getShaderBin(const char* _name, bgfx::RendererType::Enum _type, const uint8_t*& _outData, uint32_t& _outSize)
+{
+	if (bgfx::RendererType::Noop == _type)
+	{
+		const bool vertex = 'v' == _name[0];
+		_outData = vertex ? s_vsBin : s_fsBin;
+		_outSize = vertex ? sizeof(s_vsBin) : sizeof(s_fsBin);
+		return true;
+	}
+
+	for (const bgfx::EmbeddedShader* es = s_embeddedShaders; NULL != es->name; ++es)
+	{
+		if (0 == bx::strCmp(_name, es->name) )
+		{
+			for (const bgfx::EmbeddedShader::Data* esd = es->data; bgfx::RendererType::Count != esd->type; ++esd)
+			{
+				if (_type == esd->type
+				&&  1 < esd->size)
+				{
+					_outData = esd->data;
+					_outSize = esd->size;
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		bx::printf("Error:\n%s\n\n", _error);
+	}
+
+	bx::printf(
+		  "drawbench, bgfx headless draw call benchmark, version %d.%d.%d.\n"
+		  "Copyright 2011-2021 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_DRAWBENCH_VERSION_MAJOR
+		, BGFX_DRAWBENCH_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	bx::printf(
+		  "Usage: drawbench [options]\n"
+
+		  "\n"
+		  "Runs without window, on noop renderer unless --renderer is set. Each benchmark\n"
+		  "is run with 1, 2, 4, ... encoders up to --encoders, draws of frame are split\n"
+		  "evenly between them.\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -c, --case <name>        Benchmark case (default draw).\n"
+		  "  -r, --renderer <name>    Renderer type (default noop), headless device must\n"
+		  "                           be supported by renderer (f.e. vk on lavapipe).\n"
+		  "                           Types: noop, d3d9, d3d11, d3d12, gl, gles, mtl, vk.\n"
+		  "  -n, --frames <num>       Number of measured frames (default 100).\n"
+		  "  -d, --draws <num>        Number of draw calls per frame (default 10000).\n"
+		  "  -e, --encoders <num>     Maximum number of encoders (default 8).\n"
+		  "  -u, --update-size <num>  Size of each update in bytes in update case (default 256).\n"
+		  "      --updates <num>      Number of updates per frame in update case (default 64).\n"
+		  "      --check              Check vertexConvert against vertexPack and exit.\n"
+
+		  "\n"
+		  "Sort case is meant to be run with --draws 16384, 32768 and 65535. Library\n"
+		  "built with BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS=0 sorts on single thread.\n"
+		  "Update case measures per update cost with small and large --update-size, on\n"
+		  "noop renderer only library side is measured, use --renderer vk to include\n"
+		  "renderer uploads.\n"
+		  "\n"
+		  "Cases:\n"
+		);
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(s_case); ++ii)
+	{
+		bx::printf("  %-22s   %s\n", s_case[ii].m_name, s_case[ii].m_desc);
+	}
+
+	bx::printf(
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		bx::printf(
+			"drawbench, bgfx headless draw call benchmark, version %d.%d.%d.\n"
+			, BGFX_DRAWBENCH_VERSION_MAJOR
+			, BGFX_DRAWBENCH_VERSION_MINOR
+			, BGFX_API_VERSION
+		);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	const BenchCase* benchCase = &s_case[0];
+	const char* caseName = cmdLine.findOption('c', "case");
+	if (NULL != caseName)
+	{
+		benchCase = NULL;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_case); ++ii)
+		{
+			if (0 == bx::strCmpI(caseName, s_case[ii].m_name) )
+			{
+				benchCase = &s_case[ii];
+				break;
+			}
+		}
+
+		if (NULL == benchCase)
+		{
+			help("Invalid benchmark case.");
+			return bx::kExitFailure;
+		}
+	}
+
+	bgfx::RendererType::Enum type = bgfx::RendererType::Noop;
+	const char* typeName = cmdLine.findOption('r', "renderer");
+	if (NULL != typeName)
+	{
+		type = bgfx::RendererType::Count;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_rendererName); ++ii)
+		{
+			if (0 == bx::strCmpI(typeName, s_rendererName[ii].m_name) )
+			{
+				type = s_rendererName[ii].m_type;
+				break;
+			}
+		}
+
+		if (bgfx::RendererType::Count == type)
+		{
+			help("Invalid renderer type.");
+			return bx::kExitFailure;
+		}
+	}
+
+	uint32_t numFrames = 100;
+	const char* frames = cmdLine.findOption('n', "frames");
+	if (NULL != frames)
+	{
+		bx::fromString(&numFrames, frames);
+		numFrames = bx::max<uint32_t>(numFrames, 1);
+	}
+
+	uint32_t numDraws = 10000;
+	const char* draws = cmdLine.findOption('d', "draws");
+	if (NULL != draws)
+	{
+		bx::fromString(&numDraws, draws);
+		numDraws = bx::max<uint32_t>(numDraws, 1);
+	}
+
+	uint32_t maxEncoders = 8;
+	const char* encoders = cmdLine.findOption('e', "encoders");
+	if (NULL != encoders)
+	{
+		bx::fromString(&maxEncoders, encoders);
+		maxEncoders = bx::clamp<uint32_t>(maxEncoders, 1, kMaxEncoders);
+	}
+
+	uint32_t updateSize = 256;
+	const char* update = cmdLine.findOption('u', "update-size");
+	if (NULL != update)
+	{
+		bx::fromString(&updateSize, update);
+		updateSize = bx::max<uint32_t>(updateSize, 1);
+	}
+
+	uint32_t numUpdates = 64;
+	const char* updates = cmdLine.findOption("updates");
+	if (NULL != updates)
+	{
+		bx::fromString(&numUpdates, updates);
+		numUpdates = bx::clamp<uint32_t>(numUpdates, 1, kNumDynamic);
+	}
+
+	if (cmdLine.hasArg("check") )
+	{
+		return checkConvert() ? bx::kExitSuccess : bx::kExitFailure;
+	}
+
+	// Render on this thread, so that time spent in library is measured.
+	bgfx::renderFrame();
+
+	bgfx::Init init;
+	init.type = type;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+	init.limits.maxEncoders  = uint16_t(maxEncoders);
+	init.limits.maxDrawCalls = bx::max<uint32_t>(init.limits.maxDrawCalls, numDraws);
+
+	Bench bench;
+	initConvertLayout(bench.m_convertSrcLayout, bench.m_convertLayout);
+
+	if (submitConvert == benchCase->m_submit)
+	{
+		init.limits.transientVbSize = bx::max<uint32_t>(
+			  init.limits.transientVbSize
+			, bench.m_convertLayout.getSize(kConvertVertices)*numDraws
+			);
+	}
+
+	if (!bgfx::init(init) )
+	{
+		bx::printf("Failed to initialize renderer.\n");
+		return bx::kExitFailure;
+	}
+
+	// Library falls back to other renderer when requested one fails.
+	const bgfx::RendererType::Enum rendererType = bgfx::getRendererType();
+
+	const uint8_t* vsData = NULL;
+	const uint8_t* fsData = NULL;
+	uint32_t vsSize = 0;
+	uint32_t fsSize = 0;
+
+	if (!getShaderBin("vs_clear",  rendererType, vsData, vsSize)
+	||  !getShaderBin("fs_clear0", rendererType, fsData, fsSize) )
+	{
+		bx::printf("No shaders for renderer %s.\n", bgfx::getRendererName(rendererType) );
+		bgfx::shutdown();
+		return bx::kExitFailure;
+	}
+
+	bench.m_case        = benchCase;
+	bench.m_numDraws    = numDraws;
+	bench.m_numEncoders = 1;
+	bench.m_frame       = 0;
+	bench.m_quit        = false;
+	bench.m_numOps      = 0;
+	bench.m_opTime      = 0;
+	bx::memSet(bench.m_failed, 0, sizeof(bench.m_failed) );
+
+	bench.m_layout
+		.begin()
+		.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+		.end();
+
+	bench.m_vbh = bgfx::createVertexBuffer(bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) ), bench.m_layout);
+	bench.m_ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) ) );
+	bench.m_color = bgfx::createUniform("u_color", bgfx::UniformType::Vec4);
+
+	bx::DefaultAllocator allocator;
+
+	bench.m_dynamicLayout
+		.begin()
+		.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+		.end();
+
+	bench.m_numDynamic = 0;
+
+	for (uint32_t ii = 0; ii < kNumDynamic; ++ii)
+	{
+		bench.m_dynamic[ii].idx = bgfx::kInvalidHandle;
+	}
+
+	bench.m_updateSize = 0;
+	bench.m_numUpdates = 0;
+	bench.m_updateData = NULL;
+
+	if (frameUpdate == benchCase->m_frame)
+	{
+		const uint16_t stride = bench.m_dynamicLayout.getStride();
+		const uint32_t numVertices = (updateSize + stride - 1)/stride;
+
+		bench.m_updateSize = numVertices*stride;
+		bench.m_numUpdates = numUpdates;
+		bench.m_numDynamic = numUpdates;
+		bench.m_updateData = (uint8_t*)BX_ALLOC(&allocator, bench.m_updateSize);
+		bx::memSet(bench.m_updateData, 0xff, bench.m_updateSize);
+
+		for (uint32_t ii = 0; ii < numUpdates; ++ii)
+		{
+			bench.m_dynamic[ii] = bgfx::createDynamicVertexBuffer(numVertices, bench.m_dynamicLayout);
+		}
+	}
+
+	if (frameDynamic == benchCase->m_frame)
+	{
+		bench.m_numDynamic = kNumDynamic;
+
+		for (uint32_t ii = 0; ii < kNumDynamic; ++ii)
+		{
+			bench.m_dynamic[ii] = bgfx::createDynamicVertexBuffer(1 + bench.m_rng.gen()%256, bench.m_dynamicLayout);
+		}
+	}
+
+	const uint32_t convertSrcSize = bench.m_convertSrcLayout.getSize(kConvertVertices);
+	bench.m_convertSrc = (float*)BX_ALLOC(&allocator, convertSrcSize);
+
+	{
+		bx::RngMwc rng;
+		for (uint32_t ii = 0, num = convertSrcSize/sizeof(float); ii < num; ++ii)
+		{
+			bench.m_convertSrc[ii] = bx::frnd(&rng);
+		}
+	}
+
+	const bgfx::ShaderHandle fsh = bgfx::createShader(bgfx::makeRef(fsData, fsSize) );
+
+	for (uint32_t ii = 0; ii < kNumPrograms; ++ii)
+	{
+		// Program cache dedups same shader pair, every program has its own
+		// vertex shader, so that sort keys differ. Vertex shader input hash
+		// is not checked against anything.
+		const bgfx::Memory* vsMem = bgfx::copy(vsData, vsSize);
+		vsMem->data[4] = uint8_t(ii);
+
+		const bgfx::ShaderHandle vsh = bgfx::createShader(vsMem);
+		bench.m_program[ii] = bgfx::createProgram(vsh, fsh, true);
+	}
+
+	bgfx::destroy(fsh);
+
+	for (uint32_t ii = 0, num = bx::max(kNumViews, kNumSortViews); ii < num; ++ii)
+	{
+		bgfx::setViewRect(bgfx::ViewId(ii), 0, 0, 1280, 720);
+		bgfx::setViewMode(bgfx::ViewId(ii), bgfx::ViewMode::DepthAscending);
+	}
+
+	for (uint32_t ii = 1; ii < maxEncoders; ++ii)
+	{
+		Worker& worker = bench.m_worker[ii];
+		worker.m_bench = &bench;
+		worker.m_idx   = ii;
+		worker.m_thread.init(workerThread, &worker, 0, "drawbench - encoder");
+	}
+
+	bx::printf("Renderer: %s, case: %s, draws: %d, frames: %d\n"
+		, bgfx::getRendererName(bgfx::getRendererType() )
+		, benchCase->m_name
+		, numDraws
+		, numFrames
+		);
+	bx::printf("Encoders  Submit [ms/frame]  Frame [ms/frame]  Draw [ns/draw]    Draws/s  Dropped  Failed\n");
+
+	const double toMs = 1000.0/double(bx::getHPFrequency() );
+	const double toNs = 1000000000.0/double(bx::getHPFrequency() );
+
+	for (uint32_t numEncoders = 1; numEncoders <= maxEncoders;)
+	{
+		bench.m_numEncoders = numEncoders;
+
+		// Warm up, so that encoder and renderer buffers are grown.
+		for (uint32_t ii = 0; ii < 4; ++ii, ++bench.m_frame)
+		{
+			submitFrame(&bench);
+			bgfx::frame();
+		}
+
+		bx::memSet(bench.m_failed, 0, sizeof(bench.m_failed) );
+		bench.m_numOps = 0;
+		bench.m_opTime = 0;
+
+		int64_t  submitTime = 0;
+		int64_t  frameTime  = 0;
+		uint64_t drawn      = 0;
+
+		for (uint32_t ii = 0; ii < numFrames; ++ii, ++bench.m_frame)
+		{
+			submitTime += submitFrame(&bench);
+
+			const int64_t start = bx::getHPCounter();
+			bgfx::frame();
+			frameTime += bx::getHPCounter() - start;
+
+			drawn += bgfx::getStats()->numDraw;
+		}
+
+		const double time = double(submitTime + frameTime)*toNs;
+
+		uint32_t failed = 0;
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			failed += bench.m_failed[ii];
+			bench.m_failed[ii] = 0;
+		}
+
+		bx::printf("%8d  %17.3f  %16.3f  %14.1f  %9.0f  %7d  %6d\n"
+			, numEncoders
+			, double(submitTime)*toMs/double(numFrames)
+			, double(frameTime)*toMs/double(numFrames)
+			, 0 < drawn ? time/double(drawn) : 0.0
+			, 0 < drawn ? double(drawn)*1000000000.0/time : 0.0
+			, uint32_t(uint64_t(numDraws)*numFrames - drawn)
+			, failed
+			);
+
+		if (0 != bench.m_numOps)
+		{
+			const bgfx::Stats* stats = bgfx::getStats();
+
+			bx::printf("          API thread ops: %d/frame, %.1f ns/op. Dynamic VB free: %d KB, largest free: %d KB.\n"
+				, bench.m_numOps/numFrames
+				, double(bench.m_opTime)*toNs/double(bench.m_numOps)
+				, uint32_t(stats->dynamicVbFree>>10)
+				, stats->dynamicVbLargestFree>>10
+				);
+		}
+
+		numEncoders = numEncoders == maxEncoders
+			? maxEncoders+1
+			: bx::min(numEncoders*2, maxEncoders)
+			;
+	}
+
+	bench.m_quit = true;
+
+	for (uint32_t ii = 1; ii < maxEncoders; ++ii)
+	{
+		bench.m_worker[ii].m_kick.post();
+		bench.m_worker[ii].m_thread.shutdown();
+	}
+
+	for (uint32_t ii = 0; ii < kNumPrograms; ++ii)
+	{
+		bgfx::destroy(bench.m_program[ii]);
+	}
+
+	BX_FREE(&allocator, bench.m_convertSrc);
+	BX_FREE(&allocator, bench.m_updateData);
+
+	for (uint32_t ii = 0; ii < kNumDynamic; ++ii)
+	{
+		if (bgfx::isValid(bench.m_dynamic[ii]) )
+		{
+			bgfx::destroy(bench.m_dynamic[ii]);
+		}
+	}
+
+	bgfx::destroy(bench.m_color);
+	bgfx::destroy(bench.m_ibh);
+	bgfx::destroy(bench.m_vbh);
+
+	bgfx::shutdown();
+
+	return bx::kExitSuccess;
+}
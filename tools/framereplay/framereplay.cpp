@@ -0,0 +1,223 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/allocator.h>
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <bgfx/bgfx.h>
+#include <bgfx/platform.h>
+
+#define BGFX_FRAMEREPLAY_VERSION_MAJOR 1
+#define BGFX_FRAMEREPLAY_VERSION_MINOR 0
+
+struct RendererName
+{
+	const char* m_name;
+	bgfx::RendererType::Enum m_type;
+};
+
+static const RendererName s_rendererName[] =
+{
+	{ "noop",  bgfx::RendererType::Noop       },
+	{ "d3d9",  bgfx::RendererType::Direct3D9  },
+	{ "d3d11", bgfx::RendererType::Direct3D11 },
+	{ "d3d12", bgfx::RendererType::Direct3D12 },
+	{ "gl",    bgfx::RendererType::OpenGL     },
+	{ "gles",  bgfx::RendererType::OpenGLES   },
+	{ "mtl",   bgfx::RendererType::Metal      },
+	{ "vk",    bgfx::RendererType::Vulkan     },
+};
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		bx::printf("Error:\n%s\n\n", _error);
+	}
+
+	bx::printf(
+		  "framereplay, bgfx frame capture replay tool, version %d.%d.%d.\n"
+		  "Copyright 2011-2021 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_FRAMEREPLAY_VERSION_MAJOR
+		, BGFX_FRAMEREPLAY_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	bx::printf(
+		  "Usage: framereplay -f <in>\n"
+
+		  "\n"
+		  "Capture file is written by library compiled with BGFX_CONFIG_FRAME_CAPTURE=1,\n"
+		  "for each frame submitted with bgfx::frame(true).\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -f <file path>           Input capture file path.\n"
+		  "  -n, --loops <num>        Number of times all captured frames are replayed (default 1).\n"
+		  "      --type <renderer>    Renderer type, without window only noop is supported.\n"
+		  "           noop (default), d3d9, d3d11, d3d12, gl, gles, mtl, vk.\n"
+
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		bx::printf(
+			"framereplay, bgfx frame capture replay tool, version %d.%d.%d.\n"
+			, BGFX_FRAMEREPLAY_VERSION_MAJOR
+			, BGFX_FRAMEREPLAY_VERSION_MINOR
+			, BGFX_API_VERSION
+		);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	const char* filePath = cmdLine.findOption('f');
+	if (NULL == filePath)
+	{
+		help("Input file name must be specified.");
+		return bx::kExitFailure;
+	}
+
+	uint32_t numLoops = 1;
+	const char* loops = cmdLine.findOption('n', "loops");
+	if (NULL != loops)
+	{
+		bx::fromString(&numLoops, loops);
+		numLoops = bx::max<uint32_t>(numLoops, 1);
+	}
+
+	bgfx::RendererType::Enum type = bgfx::RendererType::Noop;
+	const char* typeName = cmdLine.findOption("type");
+	if (NULL != typeName)
+	{
+		type = bgfx::RendererType::Count;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_rendererName); ++ii)
+		{
+			if (0 == bx::strCmpI(typeName, s_rendererName[ii].m_name) )
+			{
+				type = s_rendererName[ii].m_type;
+				break;
+			}
+		}
+
+		if (bgfx::RendererType::Count == type)
+		{
+			help("Invalid renderer type.");
+			return bx::kExitFailure;
+		}
+	}
+
+	bx::DefaultAllocator allocator;
+	bx::FileReader reader;
+
+	if (!bx::open(&reader, filePath) )
+	{
+		bx::printf("Unable to open input file '%s'.\n", filePath);
+		return bx::kExitFailure;
+	}
+
+	const uint32_t size = uint32_t(bx::getSize(&reader) );
+	void* data = BX_ALLOC(&allocator, size);
+	bx::read(&reader, data, size);
+	bx::close(&reader);
+
+	// Render on this thread, so that time spent in library is measured.
+	bgfx::renderFrame();
+
+	bgfx::Init init;
+	init.type = type;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+
+	if (!bgfx::init(init) )
+	{
+		bx::printf("Failed to initialize renderer.\n");
+		BX_FREE(&allocator, data);
+		return bx::kExitFailure;
+	}
+
+	int32_t result = bx::kExitSuccess;
+
+	uint32_t numFrames  = 0;
+	uint64_t numDraws   = 0;
+	int64_t  replayTime = 0;
+	int64_t  frameTime  = 0;
+
+	for (uint32_t loop = 0; loop < numLoops && bx::kExitSuccess == result; ++loop)
+	{
+		for (uint32_t offset = 0; offset < size;)
+		{
+			const int64_t start = bx::getHPCounter();
+			offset = bgfx::replayFrame(data, size, offset);
+			const int64_t replayed = bx::getHPCounter();
+
+			if (UINT32_MAX == offset)
+			{
+				bx::printf("Invalid capture file, or it's written by different version of library.\n");
+				result = bx::kExitFailure;
+				break;
+			}
+
+			bgfx::frame();
+
+			replayTime += replayed - start;
+			frameTime  += bx::getHPCounter() - replayed;
+			numDraws   += bgfx::getStats()->numDraw;
+			++numFrames;
+		}
+	}
+
+	if (0 < numFrames)
+	{
+		const bgfx::Stats* stats = bgfx::getStats();
+		const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+		bx::printf("Renderer: %s\n", bgfx::getRendererName(bgfx::getRendererType() ) );
+		bx::printf("Frames: %d\n", numFrames);
+		bx::printf("Replay: %.3f [ms/frame]\n", double(replayTime)*toMs/double(numFrames) );
+		bx::printf("Frame:  %.3f [ms/frame]\n", double(frameTime)*toMs/double(numFrames) );
+
+		if (0 < numDraws)
+		{
+			const double toNs = 1000000000.0/double(bx::getHPFrequency() );
+			const double time = double(replayTime + frameTime)*toNs;
+			bx::printf("Draw:   %.1f [ns/draw], %.0f [draws/s]\n"
+				, time/double(numDraws)
+				, double(numDraws)*1000000000.0/time
+				);
+		}
+
+		bx::printf("Last frame, draw calls: %d, compute: %d, blit: %d\n"
+			, stats->numDraw
+			, stats->numCompute
+			, stats->numBlit
+			);
+	}
+
+	bgfx::shutdown();
+
+	BX_FREE(&allocator, data);
+
+	return result;
+}